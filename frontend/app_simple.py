@@ -162,7 +162,7 @@ def create_table():
 def insert_row(table):
     try:
         # data yerine params kullanıyoruz (GET)
-        requests.get(f"{CPP_BACKEND_URL}/insert", params=request.form)
+        requests.get(f"{CPP_BACKEND_URL}/insert", params={**request.form, 'table': table})
     except:
         pass
     return redirect(f'/?table={table}')
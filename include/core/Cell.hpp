@@ -4,33 +4,60 @@
 #include <string>
 #include <iostream>
 #include <stdexcept> 
+#include "../utils/Arena.hpp"
+#include "StringDictionary.hpp"
 
 // Veri Tipleri Etiketi
 enum class CellType {
     INT,
     DOUBLE,   // Veya DOUBLE
-    STRING
+    STRING,
+    NULL_VALUE  // OUTER JOIN'de eslesmeyen tarafin bos hucreleri
 };
 
 class Cell {
 private:
     CellType type;      
+    uint32_t code;  // kodlu STRING
     
     // Verileri tutacak değişkenler
-    int intValue;
-    double doubleValue;
-    std::string stringValue;
+    union {
+        int intValue;
+        double doubleValue;
+        const StringDictionary* dictionary;  // STRING: kodluysa sozluk, degilse nullptr
+    };
+    std::string stringValue;  // kodlu hucrede bos
 
 public:
+    Cell();  // NULL hucre
     Cell(int value);
     Cell(double value);
     Cell(std::string value);
+    Cell(const StringDictionary* dictionary, uint32_t code);
 
     CellType getType() const;
+    bool isNull() const { return type == CellType::NULL_VALUE; }
 
     int getInt() const;
     double getDouble() const;
-    std::string getString() const;
+    const std::string& getString() const;
+
+    // Sozlukle kodlu STRING hucre. Ayni sozlukle kodlu iki hucre ancak
+    // kodlari esitse esittir.
+    bool isEncoded() const { return type == CellType::STRING && dictionary != nullptr; }
+    const StringDictionary* getDictionary() const { return type == CellType::STRING ? dictionary : nullptr; }
+    uint32_t getCode() const { return code; }
+
+    // STRING degerin std::hash<std::string>'i (kodluysa sozlukten)
+    size_t getStringHash() const;
+
+    // Tablo eklerken: metni koda cevirir ya da kodlu hucreyi duz metne acar
+    void encode(const StringDictionary* dictionary, uint32_t code);
+    void decode();
+
+    // Aktif arena varsa ondan ayrilir (sorgu ara sonuclari)
+    static void* operator new(size_t size) { return Arena::allocateObject(size); }
+    static void operator delete(void* ptr, size_t size) { Arena::releaseObject(ptr, size); }
 };
 
 #endif
\ No newline at end of file
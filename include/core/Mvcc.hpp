@@ -0,0 +1,41 @@
+#ifndef MVCC_HPP
+#define MVCC_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+// Surec genelindeki versiyon saati. Her commit (satir ekleme/silme, tablo
+// silme) saati bir ilerletir; satirlar kendi begin/end versiyonlarini tasir.
+// Aktif snapshot'lar kayitli tutulur: en eskisinden once biten versiyonlar
+// hicbir okuyucuya gorunmez ve toplanabilir.
+class Mvcc {
+public:
+    static uint64_t currentVersion();
+
+    // Yeni commit versiyonu. Tablonun yazma kilidi altinda alinmali: kilidi
+    // tutan okuyucu tablodaki her satirin versiyonunun kendi snapshot'ina
+    // esit ya da kucuk oldugunu bilir.
+    static uint64_t nextVersion();
+
+    // Aktif en eski snapshot; yoksa UINT64_MAX
+    static uint64_t oldestSnapshot();
+    static size_t activeSnapshots();
+};
+
+// Kayitli snapshot: omru boyunca currentVersion() anindaki gorunumdeki
+// satirlar toplanmaz.
+class Snapshot {
+private:
+    uint64_t version;
+
+public:
+    Snapshot();
+    ~Snapshot();
+
+    Snapshot(const Snapshot&) = delete;
+    Snapshot& operator=(const Snapshot&) = delete;
+
+    uint64_t getVersion() const { return version; }
+};
+
+#endif
@@ -1,14 +1,23 @@
 #ifndef ROW_HPP
 #define ROW_HPP
 
+#include <cstdint>
 #include <string>
+#include <vector>
 #include "../data_structures/LinkedList.hpp" 
 #include "Cell.hpp"
+#include "../utils/Arena.hpp"
 
 class Row {
 private:
     int id;
     LinkedList<Cell*> cells; 
+    std::vector<Cell*> cellIndex;  // cells ile ayni sira; getCell O(1)
+
+    // MVCC: satir [beginVersion, endVersion) araligindaki snapshot'lara
+    // gorunur. Varsayilan 0 / sonsuz: her snapshot'ta gorunur.
+    uint64_t beginVersion;
+    uint64_t endVersion;
 
 public:
     Row(int rowId);
@@ -17,12 +26,26 @@ public:
     void addCell(int value);
     void addCell(double value);
     void addCell(std::string value);
+    void addNull();
+    void addCopy(const Cell* cell);  // Hucreyi tipine gore kopyalar (NULL dahil, kodlu metin kodla)
+    void appendCell(Cell* cell);     // Hazir hucreyi ekler, sahipligi alir
 
-    Cell* getCell(size_t index);
+    Cell* getCell(size_t index) const;
+    size_t getCellCount() const { return cellIndex.size(); }
     int getId() const;
 
-    
-    LinkedList<Cell*>& getCells() { return cells; }
+    uint64_t getBeginVersion() const { return beginVersion; }
+    uint64_t getEndVersion() const { return endVersion; }
+    void setBeginVersion(uint64_t version) { beginVersion = version; }
+    void setEndVersion(uint64_t version) { endVersion = version; }
+    bool isVisible(uint64_t snapshot) const { return beginVersion <= snapshot && snapshot < endVersion; }
+
+    // Hucreler sadece add*/appendCell ile eklenir (cellIndex senkron kalsin)
+    const LinkedList<Cell*>& getCells() const { return cells; }
+
+    // Aktif arena varsa ondan ayrilir (sorgu ara sonuclari)
+    static void* operator new(size_t size) { return Arena::allocateObject(size); }
+    static void operator delete(void* ptr, size_t size) { Arena::releaseObject(ptr, size); }
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,78 @@
+#ifndef STRING_DICTIONARY_HPP
+#define STRING_DICTIONARY_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include "../data_structures/HashMap.hpp"
+
+// Bir STRING kolonunun farkli degerleri ve tamsayi kodlari. Kodlu hucre
+// metni tutmaz, (sozluk, kod) tutar; ayni sozlukle kodlu iki hucre kod
+// karsilastirmasiyla esitlenir. Her degerin std::hash<std::string>'i bir kez
+// hesaplanir (join ve GROUP BY hash'i sozlukten okur).
+//
+// Kodlari sadece tablonun yazicisi ekler (tablonun yazma kilidi altinda);
+// value/hash kilitsizdir: bir hucrenin kodu, hucre yayinlanmadan once
+// sozluge yazilmistir ve girdiler hic tasinmaz. find sorgu basina bir kez
+// cagrilir, kucuk bir mutex alir.
+//
+// Cok farkli deger goren kolonda sozluk donar (yuksek kardinalite): yeni
+// deger eklenmez, sozlukte olmayan degerler duz metin kalir. Sozlukteki
+// degerler donduktan sonra da kodlanir.
+//
+// Sozluk, hucreleri onu kullanan tablolar arasinda paylasilir (sorgu
+// sonuclari kodlu hucreleri kopyalar); son tablo birakinca silinir.
+class StringDictionary {
+public:
+    static const uint32_t NOT_FOUND = UINT32_MAX;
+    static const size_t MAX_CODES = 65520;
+
+private:
+    struct Entry {
+        std::string value;
+        size_t hash;
+    };
+
+    // Parca k 16 << k girdi tutar; 12 parca tam MAX_CODES eder
+    static const size_t CHUNK_COUNT = 12;
+
+    std::atomic<Entry*> chunks[CHUNK_COUNT];
+    std::atomic<uint32_t> count;
+    std::atomic<bool> frozen;
+    size_t seen;  // encode cagrisi (yazici)
+
+    mutable std::mutex mutex;
+    HashMap<std::string, uint32_t> codes;
+
+    mutable std::atomic<size_t> references;
+
+    const Entry& entry(uint32_t code) const;
+
+    ~StringDictionary();
+
+public:
+    StringDictionary();
+
+    StringDictionary(const StringDictionary&) = delete;
+    StringDictionary& operator=(const StringDictionary&) = delete;
+
+    // Degerin kodu; yoksa (ya da sozluk donmus ve deger yeni ise) NOT_FOUND
+    uint32_t encode(const std::string& value);
+
+    // Eklemeden arar; yoksa NOT_FOUND
+    uint32_t find(const std::string& value) const;
+
+    const std::string& value(uint32_t code) const { return entry(code).value; }
+    size_t hash(uint32_t code) const { return entry(code).hash; }
+
+    size_t size() const { return count.load(std::memory_order_acquire); }
+    bool isFrozen() const { return frozen.load(std::memory_order_relaxed); }
+
+    // Paylasim sayaci; olusturan tablo ilk referansi tutar
+    void retain() const;
+    void release() const;
+};
+
+#endif
@@ -1,12 +1,19 @@
 #ifndef TABLE_HPP
 #define TABLE_HPP
 
+#include <atomic>
+#include <cstdint>
 #include <string>
 #include <iostream>
+#include <vector>
 #include "../data_structures/LinkedList.hpp"
-#include "../index/HashIndex.hpp"
-#include "../index/BPlusTree.hpp"
+#include "../data_structures/FlatMap.hpp"
+#include "../index/ConcurrentHashIndex.hpp"
+#include "../index/ConcurrentBPlusTree.hpp"
+#include "../utils/RWLock.hpp"
+#include "../utils/Arena.hpp"
 #include "Row.hpp"
+#include "StringDictionary.hpp"
 class Table {
 private:
     std::string name;
@@ -14,11 +21,58 @@ private:
     
     LinkedList<std::string> columns; 
     LinkedList<std::string> types;
+    // Kolon adi -> sirasi (ayni ad tekrar ederse ilki, JOIN sonuclarindaki gibi)
+    FlatMap<std::string, int> columnIndex;
     
     
     LinkedList<Row*> rows;
-    HashIndex<int> primaryIndex;
-    idx::BPlusTree* bTreeIndex;
+    // id -> satir. Nokta okumalari (pointView) kilitsiz arar
+    ConcurrentHashIndex<int> primaryIndex;
+    // Kilitsiz okuyucular da arar; yazicilar yine tablonun yazma kilidini tutar
+    idx::ConcurrentBPlusTree* bTreeIndex;
+
+    // Satir id'sini tutan kolon ("id", INT). Indeksler bu kolonun degerleriyle
+    // ayni anahtarlari tasir; id'si kolondan farkli ya da tekrar eden bir satir
+    // insertRow ile gelirse keyColumnValid false olur ve kolon indeksli
+    // sayilmaz (sorgu sonuclari). Katalog yazmalari (insertVersioned) boyle
+    // satirlari reddeder.
+    int keyColumn;
+    std::atomic<bool> keyColumnValid;
+    // Simdiye kadar eklenen en buyuk satir id'si (silinse de geri gitmez)
+    int lastRowId;
+
+    // Istatistik onbellegi icin: her Table nesnesine tekil bir id ve
+    // insert/remove sayaci (ayni adreste yeni tablo eskisiyle karismasin)
+    uint64_t tableId;
+    uint64_t modificationCount;
+
+    mutable RWLock rwLock;
+
+    // MVCC: silinen ama daha eski snapshot'larin gorebilecegi satirlar.
+    // Tablodan ve indekslerden cikarilmistir, collectGarbage'e kadar yasar.
+    std::vector<Row*> retiredRows;
+
+    // Snapshot gorunumleri satirlarin sahibi degildir
+    bool ownsRows;
+
+    // STRING kolonlarin sozlukleri. Kodlayan (katalog) tabloda her STRING
+    // kolonun kendi sozlugu vardir ve eklenen degerler ona kodlanir. Diger
+    // tablolar (sorgu sonuclari, gorunumler) eklenen kodlu hucrelerin
+    // sozluklerini tutar: hucreler kaynak tablodan uzun yasayabilir.
+    // canonical: kolonda sozlukteki bir deger hep bu sozlukle kodlu, yani
+    // kod esitligi deger esitligidir (duz metin ya da baska sozluk yok).
+    struct ColumnDictionary {
+        int column;
+        const StringDictionary* dictionary;
+        StringDictionary* encoder;  // kodlayan tabloda dictionary, degilse nullptr
+        bool canonical;
+    };
+    std::vector<ColumnDictionary> dictionaries;  // sadece STRING kolonlar
+    std::vector<const StringDictionary*> otherDictionaries;
+    bool encodesStrings;
+
+    void encodeStrings(Row* row);
+    void shareDictionaries(Table* view) const;
 
 public:
     
@@ -26,22 +80,90 @@ public:
 
     ~Table();
 
+    // Bundan sonra eklenen STRING degerler kolon sozluklerine kodlanir.
+    // Katalog tablolari icin; satirlar varsa onlar da kodlanir (yazma kilidi).
+    void enableDictionaryEncoding();
+    bool isDictionaryEncoded() const { return encodesStrings; }
+
     void insertRow(Row* row);
     
     Row* getRowById(int id);
 
     void removeRow(int id);
+
+    // Paylasilan tabloya MVCC ile yazma (yazma kilidi altinda). Eklenen
+    // satir yeni commit versiyonuyla baslar; silinen satir o versiyonda
+    // biter ve hemen silinmez, retiredRows'a gecer.
+    // insertVersioned canInsert'ten gecmeyen satiri eklemez (false,
+    // sahiplik cagirana kalir): indeksler tekil anahtarli kalir.
+    bool insertVersioned(Row* row);
+    bool removeVersioned(int id);
+
+    // Satir indeksleri bozmadan eklenebilir mi: id tabloda yok ve (anahtar
+    // kolon varsa) kolondaki deger id'ye esit. Degilse nedeni yazilir.
+    bool canInsert(const Row* row) const;
+
+    // Yeni satir icin id: en buyuk id + 1, silinen id'ler tekrar verilmez
+    // (yazma kilidi altinda)
+    int nextRowId() const;
+
+    // Bitis versiyonu oldestSnapshot'tan buyuk olmayan silinmis satirlari
+    // serbest birakir (yazma kilidi altinda). Serbest birakilan sayisi doner.
+    size_t collectGarbage(uint64_t oldestSnapshot);
+    size_t getRetiredCount() const { return retiredRows.size(); }
+
+    // Tablonun su anki satirlarinin gorunumu (okuma kilidi altinda; kilit
+    // tutuldugu icin satirlar zaten tek bir versiyonda tutarlidir). Satirlari
+    // kopyalamaz ve sahiplenmez; indeksi yoktur, sorgular gorunumde tarama
+    // yolunu kullanir. Kilit tutulurken kaydedilen Snapshot sonradan silinen
+    // satirlari retiredRows'ta tutar, gorunum kilit birakildiktan sonra da
+    // okunabilir.
+    Table* snapshotView() const;
+
+    // id'si key olan satirin tek satirlik gorunumu (yoksa bos). Tablo kilidi
+    // gerekmez: satir primaryIndex'ten kilitsiz okunur. Cagiran EpochGuard tutar;
+    // silinen satirlar epoch ile serbest birakildigi icin gorunum guard
+    // boyunca okunabilir.
+    Table* pointView(int key) const;
     
     void print() const;
 
-    idx::BPlusTree* getBTree() { return bTreeIndex; }
+    idx::ConcurrentBPlusTree* getBTree() { return bTreeIndex; }
+
+    // primaryIndex/bTreeIndex ile aranabilen kolonun sirasi, yoksa -1
+    int getKeyColumnIndex() const;
+    // Gecici tablolar (gorunumler gibi) anahtar kolonu indeksli saymaz:
+    // erisim yolu secilmez, istatistik onbellegine girmez
+    void disableKeyColumn() { keyColumnValid = false; }
+
+    // Adi verilen kolonun sirasi, yoksa -1
+    int getColumnIndex(const std::string& columnName) const;
+
+    // Kolonun sozlugu, yoksa nullptr. Hucreleri baska sozlukle kodlu ya da
+    // duz metin olabilir; esitlik kodla ancak ayni sozlukte bakilir.
+    const StringDictionary* getDictionary(int column) const;
+    // Kolon canonical ise sozlugu, degilse nullptr
+    const StringDictionary* getCanonicalDictionary(int column) const;
     
     size_t getRowCount() const;
 
+    uint64_t getTableId() const { return tableId; }
+    uint64_t getModificationCount() const { return modificationCount; }
+
+    // Tablo metotlari kendileri kilitlemez (sorgu sonuclari gibi tek thread'e
+    // ait tablolarda satir basina kilit maliyeti olmasin). Paylasilan tabloyu
+    // okuyan okuma kilidini, insertRow/removeRow cagiran yazma kilidini tutar.
+    RWLock& getLock() const { return rwLock; }
+
     std::string getName() const;
     const LinkedList<std::string>& getColumns() const; 
     const LinkedList<std::string>& getTypes() const;
     const LinkedList<Row*>& getRows() const;
+
+    // Aktif arena varsa ondan ayrilir: sorgu ara sonuclari ve snapshot
+    // gorunumleri. Katalog tablolari arena disinda olusturulur.
+    static void* operator new(size_t size) { return Arena::allocateObject(size); }
+    static void operator delete(void* ptr, size_t size) { Arena::releaseObject(ptr, size); }
 };
 
 #endif
\ No newline at end of file
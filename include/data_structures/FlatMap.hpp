@@ -0,0 +1,92 @@
+#ifndef FLATMAP_HPP
+#define FLATMAP_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+// Sirali dizi uzerinde map: arama ikili arama, ekleme/silme kaydirma ile.
+// Bir kez kurulup cok okunan kucuk haritalar (kolon adlari gibi) icin;
+// hash hesaplanmaz, elemanlar bitisik durur. Arayuz HashMap ile ayni,
+// iterasyon anahtar sirasinda.
+template <typename K, typename V>
+class FlatMap {
+public:
+    struct KeyValuePair {
+        K key;
+        V value;
+    };
+
+private:
+    std::vector<KeyValuePair> entries;
+
+    typename std::vector<KeyValuePair>::iterator lowerBound(const K& key) {
+        return std::lower_bound(entries.begin(), entries.end(), key,
+                                [](const KeyValuePair& pair, const K& k) { return pair.key < k; });
+    }
+
+    typename std::vector<KeyValuePair>::const_iterator lowerBound(const K& key) const {
+        return std::lower_bound(entries.begin(), entries.end(), key,
+                                [](const KeyValuePair& pair, const K& k) { return pair.key < k; });
+    }
+
+public:
+    FlatMap() {}
+
+    void clear() {
+        entries.clear();
+    }
+
+    void reserve(size_t n) {
+        entries.reserve(n);
+    }
+
+    void insert(const K& key, const V& value) {
+        (*this)[key] = value;
+    }
+
+    V* find(const K& key) {
+        auto it = lowerBound(key);
+        return it != entries.end() && !(key < it->key) ? &it->value : nullptr;
+    }
+
+    const V* find(const K& key) const {
+        auto it = lowerBound(key);
+        return it != entries.end() && !(key < it->key) ? &it->value : nullptr;
+    }
+
+    bool contains(const K& key) const {
+        return find(key) != nullptr;
+    }
+
+    V& operator[](const K& key) {
+        auto it = lowerBound(key);
+        if (it == entries.end() || key < it->key) it = entries.insert(it, KeyValuePair{key, V()});
+        return it->value;
+    }
+
+    bool erase(const K& key) {
+        auto it = lowerBound(key);
+        if (it == entries.end() || key < it->key) return false;
+        entries.erase(it);
+        return true;
+    }
+
+    size_t size() const {
+        return entries.size();
+    }
+
+    bool empty() const {
+        return entries.empty();
+    }
+
+    typedef typename std::vector<KeyValuePair>::iterator Iterator;
+    typedef typename std::vector<KeyValuePair>::const_iterator ConstIterator;
+
+    Iterator begin() { return entries.begin(); }
+    Iterator end() { return entries.end(); }
+    ConstIterator begin() const { return entries.begin(); }
+    ConstIterator end() const { return entries.end(); }
+};
+
+#endif
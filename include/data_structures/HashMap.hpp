@@ -0,0 +1,219 @@
+#ifndef HASHMAP_HPP
+#define HASHMAP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+// Acik adresli (linear probing) hash map. Map ile ayni insert/find/operator[]
+// arayuzu; arama ortalama O(1). Slotlar tek dizide tutulur, her slot
+// anahtarin hash'ini de saklar (string karsilastirmasi sadece hash tutunca).
+// Silmede mezar tasi birakilmaz; arkadaki zincir geri kaydirilir.
+// Yuk orani 3/4'u gecince kapasite iki katina cikar. Ekleme ve silme
+// iteratorleri ve find'in dondurdugu isaretcileri gecersiz kilabilir.
+template <typename K, typename V, typename Hash = std::hash<K>>
+class HashMap {
+public:
+    struct KeyValuePair {
+        K key;
+        V value;
+    };
+
+private:
+    struct Slot {
+        KeyValuePair pair;
+        size_t hash;
+        bool used;
+
+        Slot() : pair(), hash(0), used(false) {}
+    };
+
+    std::vector<Slot> slots;
+    size_t count;
+    Hash hasher;
+
+    // std::hash<int> birim fonksiyon; dusuk bitler maskeyle alindigi icin karistirilir
+    size_t hashOf(const K& key) const {
+        uint64_t h = static_cast<uint64_t>(hasher(key)) * 0x9E3779B97F4A7C15ULL;
+        return static_cast<size_t>(h ^ (h >> 32));
+    }
+
+    size_t mask() const { return slots.size() - 1; }
+
+    // Anahtarin slotu ya da (yoksa) eklenecegi bos slot; found sonucu soyler
+    size_t probe(const K& key, size_t hash, bool& found) const {
+        size_t i = hash & mask();
+        while (slots[i].used) {
+            if (slots[i].hash == hash && slots[i].pair.key == key) {
+                found = true;
+                return i;
+            }
+            i = (i + 1) & mask();
+        }
+        found = false;
+        return i;
+    }
+
+    void rehash(size_t capacity) {
+        std::vector<Slot> old;
+        old.swap(slots);
+        slots.resize(capacity);
+        for (auto& slot : old) {
+            if (!slot.used) continue;
+            size_t i = slot.hash & mask();
+            while (slots[i].used) i = (i + 1) & mask();
+            slots[i] = std::move(slot);
+        }
+    }
+
+    void reserveFor(size_t n) {
+        size_t capacity = slots.empty() ? 8 : slots.size();
+        while (n * 4 > capacity * 3) capacity *= 2;
+        if (capacity != slots.size()) rehash(capacity);
+    }
+
+    // Yoksa varsayilan degerle ekler; slot indeksini dondurur
+    size_t slotFor(const K& key) {
+        size_t hash = hashOf(key);
+        bool found = false;
+        if (!slots.empty()) {
+            size_t i = probe(key, hash, found);
+            if (found) return i;
+        }
+        reserveFor(count + 1);
+        size_t i = probe(key, hash, found);
+        slots[i].pair.key = key;
+        slots[i].hash = hash;
+        slots[i].used = true;
+        count++;
+        return i;
+    }
+
+public:
+    HashMap() : count(0) {}
+
+    void clear() {
+        slots.clear();
+        count = 0;
+    }
+
+    void reserve(size_t n) {
+        if (n > 0) reserveFor(n);
+    }
+
+    void insert(const K& key, const V& value) {
+        slots[slotFor(key)].pair.value = value;
+    }
+
+    V* find(const K& key) {
+        if (slots.empty()) return nullptr;
+        bool found = false;
+        size_t i = probe(key, hashOf(key), found);
+        return found ? &slots[i].pair.value : nullptr;
+    }
+
+    const V* find(const K& key) const {
+        if (slots.empty()) return nullptr;
+        bool found = false;
+        size_t i = probe(key, hashOf(key), found);
+        return found ? &slots[i].pair.value : nullptr;
+    }
+
+    bool contains(const K& key) const {
+        return find(key) != nullptr;
+    }
+
+    V& operator[](const K& key) {
+        return slots[slotFor(key)].pair.value;
+    }
+
+    bool erase(const K& key) {
+        if (slots.empty()) return false;
+        bool found = false;
+        size_t hole = probe(key, hashOf(key), found);
+        if (!found) return false;
+
+        // Bosluktan sonraki zincirde, ev slotu (hole, j] disinda kalan
+        // elemanlar bosluga tasinir; bos slota gelince zincir biter
+        size_t j = hole;
+        while (true) {
+            j = (j + 1) & mask();
+            if (!slots[j].used) break;
+            size_t home = slots[j].hash & mask();
+            bool reachable = hole <= j ? (hole < home && home <= j) : (hole < home || home <= j);
+            if (reachable) continue;
+            slots[hole] = std::move(slots[j]);
+            hole = j;
+        }
+        slots[hole] = Slot();
+        count--;
+        return true;
+    }
+
+    size_t size() const {
+        return count;
+    }
+
+    bool empty() const {
+        return count == 0;
+    }
+
+    class Iterator {
+    private:
+        Slot* slot;
+        Slot* last;
+
+        void skip() {
+            while (slot != last && !slot->used) ++slot;
+        }
+
+    public:
+        Iterator(Slot* s, Slot* l) : slot(s), last(l) { skip(); }
+
+        KeyValuePair& operator*() { return slot->pair; }
+        KeyValuePair* operator->() { return &slot->pair; }
+
+        Iterator& operator++() {
+            ++slot;
+            skip();
+            return *this;
+        }
+
+        bool operator==(const Iterator& other) const { return slot == other.slot; }
+        bool operator!=(const Iterator& other) const { return slot != other.slot; }
+    };
+
+    class ConstIterator {
+    private:
+        const Slot* slot;
+        const Slot* last;
+
+        void skip() {
+            while (slot != last && !slot->used) ++slot;
+        }
+
+    public:
+        ConstIterator(const Slot* s, const Slot* l) : slot(s), last(l) { skip(); }
+
+        const KeyValuePair& operator*() const { return slot->pair; }
+        const KeyValuePair* operator->() const { return &slot->pair; }
+
+        ConstIterator& operator++() {
+            ++slot;
+            skip();
+            return *this;
+        }
+
+        bool operator==(const ConstIterator& other) const { return slot == other.slot; }
+        bool operator!=(const ConstIterator& other) const { return slot != other.slot; }
+    };
+
+    Iterator begin() { return Iterator(slots.data(), slots.data() + slots.size()); }
+    Iterator end() { return Iterator(slots.data() + slots.size(), slots.data() + slots.size()); }
+    ConstIterator begin() const { return ConstIterator(slots.data(), slots.data() + slots.size()); }
+    ConstIterator end() const { return ConstIterator(slots.data() + slots.size(), slots.data() + slots.size()); }
+};
+
+#endif
@@ -3,8 +3,11 @@
 
 #include <iostream>
 #include <stdexcept>
+#include "../utils/Arena.hpp"
+#include "../utils/PoolAllocator.hpp"
 
-template <typename T>
+// Alloc: dugumlerin allocator'u (aktif arena yoksa); bkz. PoolAllocator
+template <typename T, typename Alloc = PoolAllocator>
 class LinkedList {
 
 
@@ -15,6 +18,13 @@ public:
             Node* prev;
 
             Node(const T& value) : data(value), next(nullptr), prev(nullptr) {}
+
+            // Aktif arena varsa ondan, yoksa Alloc'tan ayrilir (bkz. Arena)
+            static void* operator new(size_t size) {
+                static_assert(alignof(Node) <= Arena::OBJECT_ALIGNMENT, "Node hizalamasi arena basligini asiyor");
+                return Arena::allocateObject<Alloc>(size);
+            }
+            static void operator delete(void* ptr, size_t size) { Arena::releaseObject<Alloc>(ptr, size); }
         };
 
 private:
@@ -0,0 +1,31 @@
+#ifndef AGGREGATE_ENGINE_HPP
+#define AGGREGATE_ENGINE_HPP
+
+#include "core/Table.hpp"
+#include "query_types.hpp"
+#include "expr_compiler.hpp"
+#include <vector>
+
+// GROUP BY + COUNT/SUM/AVG/MIN/MAX. rows, schema tablosunun satirlaridir
+// (kopya degil); filter verilirse eslesmeyen satirlar atlanir, boylece WHERE
+// ayri bir ara tablo uretmeden taramayla birlikte uygulanir.
+//
+// Gruplar tipli anahtarla hash tablosunda toplanir (tek INT kolonda
+// dogrudan int anahtar). ordered true ise satirlar grup anahtarina gore
+// sirali gelir (B+ tree sirasi gibi); hash tablosu kurulmaz, anahtar
+// degistikce yeni grup acilir.
+//
+// Sonuc kolonlari: once group_by kolonlari, sonra her toplamanin
+// output_name'i. NULL'lar COUNT(kolon), SUM, AVG, MIN, MAX'ta sayilmaz;
+// SUM/AVG metin hucreleri de atlar. GROUP BY yoksa bos girdide de tek satir
+// uretilir (COUNT 0, digerleri NULL).
+Table* aggregate_rows(Table* schema, const std::vector<Row*>& rows, const CompiledPredicate* filter,
+                      const LinkedList<std::string>& group_by, const LinkedList<SelectAggregate>& aggregates,
+                      bool ordered);
+
+// Toplamalarin hepsi COUNT(*) mi? (WHERE ve GROUP BY yokken tablo
+// taranmadan getRowCount() ile cevaplanabilir)
+bool aggregate_is_row_count(const LinkedList<SelectAggregate>& aggregates);
+Table* aggregate_row_count(Table* table, const LinkedList<SelectAggregate>& aggregates);
+
+#endif
@@ -0,0 +1,36 @@
+#ifndef EXPR_COMPILER_HPP
+#define EXPR_COMPILER_HPP
+
+#include "core/Row.hpp"
+#include "query_binder.hpp"
+
+struct PredicateNode;
+
+// Baglanmis WHERE ifadesinin derlenmis hali. Her dugum, kolon tipine ve
+// operatore gore ozellesmis bir fonksiyon isaretcisidir (INT kolon < sabit,
+// STRING kolon LIKE 'abc%', sabit IN listesi icin ikili arama ...). Satir
+// basina string donusumu ya da operator switch'i yapilmaz. Sozlukle kodlu
+// STRING kolonda = / != / IN sabitleri derlemede koda cevrilir; hucre ayni
+// sozlukle kodluysa metin yerine kod karsilastirilir.
+//
+// Beklenmeyen hucre tipi (INT kolonda metin vb.) gorulurse o dugum
+// yorumlayiciya (bound_expr_evaluate) duser; sonuc her zaman ayni kalir.
+// Derlenen ifade (BoundExpr) bu nesne yasadigi surece yasamalidir.
+class CompiledPredicate {
+private:
+    PredicateNode* root;
+
+public:
+    explicit CompiledPredicate(const BoundExpr* expr);
+    ~CompiledPredicate();
+
+    CompiledPredicate(const CompiledPredicate&) = delete;
+    CompiledPredicate& operator=(const CompiledPredicate&) = delete;
+
+    bool matches(Row* row) const;
+};
+
+// BoundExpr yorumlayicisi; derlenemeyen dugumlerin yedek yolu
+bool bound_expr_evaluate(const BoundExpr* expr, Row* row);
+
+#endif
@@ -3,17 +3,73 @@
 
 #include "core/Table.hpp"
 #include "query_types.hpp"
+#include <cstddef>
 #include <string>
 
+// Join sonucunun kolonlari. Alias verilen tarafin kolonlari "alias.kolon"
+// diye adlandirilir (zaten nitelenmis kolonlar oldugu gibi kalir); alias
+// bossa adlar degismez. wanted verilirse sonuc sadece bu kolonlari tasir
+// (projection pushdown); niteliksiz ad her iki taraftaki o adli kolonu,
+// "alias.*" o tarafin butun kolonlarini secer.
+struct JoinColumns {
+    const LinkedList<std::string>* wanted;
+    std::string left_alias;
+    std::string right_alias;
+
+    JoinColumns() : wanted(nullptr) {}
+};
+
 Table* join_nested_loop(Table* left_table, Table* right_table,
                         int left_column_index, int right_column_index,
-                        JoinType join_type);
+                        JoinType join_type,
+                        const JoinColumns* output_columns = nullptr);
 
 Table* join_hash(Table* left_table, Table* right_table,
                  int left_column_index, int right_column_index,
-                 JoinType join_type);
+                 JoinType join_type,
+                 const JoinColumns* output_columns = nullptr);
+
+// Iki girdiyi hash'e gore cache boyutlu partition'lara boler, partition'lari
+// thread havuzunda paralel build/probe eder
+Table* join_radix_hash(Table* left_table, Table* right_table,
+                       int left_column_index, int right_column_index,
+                       JoinType join_type,
+                       const JoinColumns* output_columns = nullptr);
+
+// Build tarafi bellek butcesine sigmiyorsa iki girdiyi de anahtar hash'ine gore
+// gecici dosyalara partition'lar ve partition'lari tek tek join eder
+Table* join_grace_hash(Table* left_table, Table* right_table,
+                       int left_column_index, int right_column_index,
+                       JoinType join_type,
+                       const JoinColumns* output_columns = nullptr);
+
+// Grace join'e gecis esigi (byte). Varsayilan 64 MB.
+void join_set_memory_budget(size_t bytes);
+size_t join_get_memory_budget();
+
+// Join kolonu bir tarafin id kolonuysa o tarafin HashIndex'ini probe eder
+Table* join_index_nested_loop(Table* left_table, Table* right_table,
+                              int left_column_index, int right_column_index,
+                              JoinType join_type,
+                              const JoinColumns* output_columns = nullptr);
+
+// Iki taraf da id kolonunda birlesiyorsa B+ tree yaprak zincirlerini birlestirir
+Table* join_sort_merge(Table* left_table, Table* right_table,
+                       int left_column_index, int right_column_index,
+                       JoinType join_type,
+                       const JoinColumns* output_columns = nullptr);
+
+// join_execute bu tablolarda indeksli join (sort-merge ya da indeksli nested
+// loop) secer mi? left_table nullptr ise sol taraf ara join sonucudur ve
+// sadece sag tablonun indeksine bakilir.
+bool join_can_use_index(Table* left_table, Table* right_table, const JoinCondition& condition,
+                        const std::string& left_alias);
 
+// output_columns nullptr ise iki tablonun tum kolonlari, adlari degismeden.
+// condition.left_column sol tabloda aranir; output_columns->left_alias ile
+// nitelenmisse sol tablonun kendi kolonu da olabilir.
 Table* join_execute(Table* left_table, Table* right_table,
-                    const JoinCondition& condition);
+                    const JoinCondition& condition,
+                    const JoinColumns* output_columns = nullptr);
 
 #endif
@@ -0,0 +1,75 @@
+#ifndef PLAN_CACHE_HPP
+#define PLAN_CACHE_HPP
+
+#include "query_types.hpp"
+#include "../../data_structures/HashMap.hpp"
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+// Onbellekteki planlar paylasilir ve salt okunurdur; query_execute const
+// Query* aldigi icin ayni plan ayni anda birden fazla istekte calisabilir.
+typedef std::shared_ptr<const Query> QueryPlan;
+
+// Sorguyu token'larina ayirip tek bosluklu, anahtar kelimeleri buyuk harfli
+// kanonik metne cevirir. "select *  from t" ve "SELECT * FROM t;" ayni anahtari
+// verir. Metin sabitleri ve kolon isimleri oldugu gibi kalir.
+std::string query_normalize(const std::string& query_string);
+
+// Parse edilmis sorgularin LRU onbellegi; anahtar normalize edilmis metin.
+class PlanCache {
+private:
+    struct Entry {
+        std::string key;
+        QueryPlan plan;
+    };
+
+    size_t capacity;
+    std::list<Entry> lru;  // en bastaki en son kullanilan
+    HashMap<std::string, std::list<Entry>::iterator> index;
+    mutable std::mutex mutex;
+    size_t hits;
+    size_t misses;
+
+public:
+    explicit PlanCache(size_t capacity = 256);
+
+    PlanCache(const PlanCache&) = delete;
+    PlanCache& operator=(const PlanCache&) = delete;
+
+    // Onbellekte yoksa parse edip ekler. Parse hatasinda nullptr.
+    QueryPlan get(const std::string& query_string);
+
+    void clear();
+    size_t size() const;
+    size_t getHits() const;
+    size_t getMisses() const;
+
+    static PlanCache& global();
+};
+
+// /prepare ile kaydedilen hazir sorgular (statement id -> plan)
+class PreparedStatements {
+private:
+    std::unordered_map<int, QueryPlan> statements;
+    int nextId;
+    mutable std::mutex mutex;
+
+public:
+    PreparedStatements();
+
+    int add(const QueryPlan& plan);
+    QueryPlan get(int id) const;
+    bool remove(int id);
+
+    static PreparedStatements& global();
+};
+
+// HTTP'den gelen parametre metnini tipli degere cevirir:
+// 'metin' -> STRING, 42 / 3.5 -> NUMBER, NULL -> NULL, digerleri -> STRING
+QueryParam query_param_from_string(const std::string& value);
+
+#endif
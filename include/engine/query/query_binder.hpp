@@ -0,0 +1,70 @@
+#ifndef QUERY_BINDER_HPP
+#define QUERY_BINDER_HPP
+
+#include "core/Table.hpp"
+#include "query_types.hpp"
+#include <string>
+#include <vector>
+
+// Baglanmis (bound) WHERE ifadesi. Kolon isimleri tablodaki sira numarasina
+// ve beyan edilen tipe, ?'ler parametre degerine cevrilmistir; calistirici
+// satir basina hic isim karsilastirmasi yapmaz.
+//
+// PARAMETER dugumu kalmaz (LITERAL olur). Tabloda olmayan kolon ismi
+// baglamayi basarisiz kilar; metin sabitleri tirnak icinde yazilmalidir.
+struct BoundExpr {
+    ExprKind kind;
+
+    int column_index;     // COLUMN
+    CellType value_type;  // COLUMN: beyan edilen tip, LITERAL: sabitin tipi
+    const StringDictionary* dictionary;  // STRING COLUMN: kolonun sozlugu (yoksa nullptr)
+    double number;
+    std::string text;
+
+    ComparisonOperator op;
+    ArithmeticOperator arith_op;
+    bool negated;
+
+    BoundExpr* left;
+    BoundExpr* right;
+    std::vector<BoundExpr*> list;
+
+    explicit BoundExpr(ExprKind k)
+        : kind(k), column_index(-1), value_type(CellType::NULL_VALUE), dictionary(nullptr), number(0),
+          op(ComparisonOperator::EQUAL), arith_op(ArithmeticOperator::ADD), negated(false),
+          left(nullptr), right(nullptr) {}
+
+    ~BoundExpr() {
+        delete left;
+        delete right;
+        for (auto item : list) delete item;
+    }
+
+    BoundExpr(const BoundExpr&) = delete;
+    BoundExpr& operator=(const BoundExpr&) = delete;
+};
+
+// Secilen kolonlarin sira numaralari ve cikti semasi. failed: listede
+// tabloda olmayan ya da belirsiz bir kolon var.
+struct BoundProjection {
+    std::vector<int> indices;
+    LinkedList<std::string> columns;
+    LinkedList<std::string> types;
+    bool failed;
+
+    BoundProjection() : failed(false) {}
+};
+
+// Tablo semasindaki "INT" / "DOUBLE" / "STRING" tipini CellType'a cevirir
+CellType column_type_from_string(const std::string& type);
+
+// Kolonun tablodaki sirasi; yoksa -1. Join sonucunda niteliksiz ad birden
+// fazla tablonun kolonuna uyuyorsa COLUMN_AMBIGUOUS (hata mesaji yazilir).
+static const int COLUMN_AMBIGUOUS = -2;
+int query_bind_column(Table* table, const std::string& column_name);
+
+// Ifadede tabloda olmayan bir kolon varsa nullptr (hata mesaji yazilir)
+BoundExpr* query_bind_expr(const Expr* expr, Table* table, const QueryParams* params);
+BoundProjection query_bind_projection(Table* table, const LinkedList<std::string>& column_names);
+
+#endif
@@ -4,25 +4,76 @@
 #include "core/Table.hpp"
 #include "query_types.hpp"
 #include "../../data_structures/LinkedList.hpp"
-#include "../../data_structures/Map.hpp"
+#include "../../data_structures/HashMap.hpp"
+#include "../../utils/RWLock.hpp"
+#include <cstdint>
+#include <mutex>
 #include <string>
+#include <utility>
+#include <vector>
 
+class ShardedTable;
+
+// Tablo katalogu. Eklenen tablolarin sahibi Database'dir (yikicida ve
+// dropTable'da silinir). Isimle arama acik adresli hash tablosunda O(1).
 class Database {
 private:
-    Map<std::string, Table*> tables;
+    HashMap<std::string, Table*> tables;
+    // Parcali tablolar (shard_engine); adlari tables ile cakismaz
+    HashMap<std::string, ShardedTable*> shardedTables;
+    mutable std::mutex mutex;
+    // Tablolarin omru: tablo kullanan istekler okuma, tablo ekleyip silenler
+    // yazma kilidi alir. Boylece kullanimdaki tablo silinemez.
+    mutable RWLock schemaLock;
+    // Silinen tablolar (silinme versiyonuyla): snapshot gorunumleri
+    // satirlarini okuyor olabilir, collectGarbage'e kadar yasar
+    std::vector<std::pair<uint64_t, Table*>> retiredTables;
+
+    size_t collectRetired();  // mutex tutulurken
 
 public:
     Database();
     ~Database();
+    Database(const Database&) = delete;
+    Database& operator=(const Database&) = delete;
+
+    // Ayni isimde tablo varsa -1 (tablo eklenmez, sahiplik cagirana kalir)
     int addTable(Table* table);
+    // Ayni isimdeki eski tablonun yerine koyar. Eski tablo hemen silinmez:
+    // Mvcc::nextVersion() ile emekliye ayrilir, onu gorebilecek snapshot
+    // kalmayinca collectRetired serbest birakir
+    void replaceTable(Table* table);
+    // Ayni isimde tablo varsa -1 (sahiplik cagirana kalir)
+    int addShardedTable(ShardedTable* table);
+    // Parcali tablo hemen silinir: satirlari snapshot'larda gorunmez
+    bool dropTable(const std::string& table_name);
+    // Hicbir aktif snapshot'in goremeyecegi silinmis tablolari serbest birakir
+    size_t collectGarbage();
     Table* getTable(const std::string& table_name);
+    ShardedTable* getShardedTable(const std::string& table_name);
+    size_t getTableCount() const;
+    // Isimler sirali (parcali tablolar dahil)
     LinkedList<std::string> getTableNames() const;
+
+    RWLock& getSchemaLock() const { return schemaLock; }
 };
 
-Table* query_execute(Database* db, const Query* query);
+// params: hazir sorgudaki ?'lerin degerleri (query->param_count kadar)
+// Kisa sorgular (indeks erisimi, erken duran LIMIT, COUNT(*)) katalog ve
+// tablo okuma kilitleri altinda calisir. Tabloyu bastan sona okuyanlar
+// (tam tarama, JOIN, siralama, toplama) kilit altinda sadece MVCC snapshot
+// gorunumunu alir ve kilitleri birakip gorunum uzerinde calisir; boylece
+// uzun raporlar /insert ve /delete'i bekletmez.
+// Cagiran bir ArenaScope actiysa ara tablolar, satirlar ve sonuc o arena'dan
+// ayrilir (havuz thread'leri dahil); sonuc arena'dan once silinmelidir.
+Table* query_execute(Database* db, const Query* query, const QueryParams* params = nullptr);
 Table* query_apply_where(Table* table, const LinkedList<QueryCondition>& conditions);
+// limit >= 0: ilk offset eslesme atlanir, limit kadar satir bulununca tarama durur
+Table* query_apply_where_expr(Table* table, const Expr* where, const QueryParams* params = nullptr,
+                              int limit = -1, int offset = 0);
 Table* query_apply_select(Table* table, const LinkedList<std::string>& column_names);
-Table* query_apply_order_by(Table* table, const LinkedList<std::string>& column_names, bool ascending);
+// limit >= 0: sadece ilk 'limit' satir (top-K)
+Table* query_apply_order_by(Table* table, const LinkedList<OrderByColumn>& order_by, long long limit = -1);
 Table* query_apply_limit(Table* table, int limit, int offset);
 
 #endif
@@ -0,0 +1,94 @@
+#ifndef QUERY_LEXER_HPP
+#define QUERY_LEXER_HPP
+
+#include <cstddef>
+#include <string>
+
+enum class TokenType {
+    END,
+    IDENTIFIER,
+    KEYWORD,
+    NUMBER,
+    STRING,      // 'metin' (icerik tirnaksiz, '' kacisi cozulmemis)
+    COMMA,
+    DOT,
+    LPAREN,
+    RPAREN,
+    STAR,
+    PLUS,
+    MINUS,
+    SLASH,
+    EQUAL,
+    NOT_EQUAL,
+    LESS,
+    LESS_EQUAL,
+    GREATER,
+    GREATER_EQUAL,
+    SEMICOLON,
+    PARAM,       // ? (hazir sorgu parametresi)
+    INVALID
+};
+
+enum class Keyword {
+    NONE,
+    SELECT,
+    FROM,
+    WHERE,
+    JOIN,
+    INNER,
+    LEFT,
+    RIGHT,
+    FULL,
+    OUTER,
+    ON,
+    AND,
+    OR,
+    NOT,
+    IN,
+    LIKE,
+    IS,
+    NULL_KW,
+    ORDER,
+    BY,
+    ASC,
+    DESC,
+    LIMIT,
+    OFFSET,
+    AS,
+    GROUP
+};
+
+// Token kaynak sorgu metnine isaret eder (start + length); kopyalanmaz.
+// Sorgu metni token'lar kullanildigi surece yasamalidir.
+struct Token {
+    TokenType type;
+    Keyword keyword;
+    const char* start;
+    size_t length;
+    size_t position;  // hata mesajlari icin metindeki konum
+
+    std::string text() const { return std::string(start, length); }
+};
+
+// Sorguyu tek geciste, ihtiyac oldukca token'a ayirir. Bellek ayirmaz.
+class QueryLexer {
+private:
+    const char* input;
+    size_t length;
+    size_t pos;
+    Token lookahead;
+    bool hasLookahead;
+
+    Token scan();
+
+public:
+    explicit QueryLexer(const std::string& query);
+
+    Token next();
+    const Token& peek();
+};
+
+// Anahtar kelime karsilastirmasi buyuk/kucuk harf duyarsiz, kopyasiz
+bool token_equals_ignore_case(const Token& token, const char* word);
+
+#endif
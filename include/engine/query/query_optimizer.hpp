@@ -0,0 +1,78 @@
+#ifndef QUERY_OPTIMIZER_HPP
+#define QUERY_OPTIMIZER_HPP
+
+#include "core/Table.hpp"
+#include "query_types.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Bir kolonun istatistikleri. Sayisal kolonlar icin min/max ve esit
+// derinlikli histogram (her kovada yaklasik ayni sayida satir) tutulur.
+struct ColumnStats {
+    std::string name;
+    CellType type;
+    size_t non_null_count;
+    size_t null_count;
+    size_t distinct_count;
+    bool has_range;  // min/max/histogram gecerli (sayisal ve en az bir deger)
+    double min;
+    double max;
+    std::vector<double> histogram;  // kova sinirlari: bounds[0] = min, son = max
+
+    // [lo, hi] araligina dusen sayisal degerlerin orani (0..1)
+    double estimateRangeFraction(double lo, double hi) const;
+    // Tek bir degere esit satirlarin orani
+    double estimateEqualFraction() const;
+};
+
+struct TableStats {
+    uint64_t table_id;
+    uint64_t modification_count;  // istatistik toplandigindaki sayac
+    size_t row_count;
+    std::vector<ColumnStats> columns;
+};
+
+// Istatistikleri tablo basina onbellekte tutar. Tablo toplandigi andan beri
+// satir sayisinin %10'undan fazla degistiyse yeniden toplar.
+std::shared_ptr<const TableStats> table_stats_get(Table* table);
+std::shared_ptr<const TableStats> table_stats_collect(Table* table);
+// Tablo katalogdan cikarken (drop/replace) onbellekteki girdisini siler
+void table_stats_forget(const Table* table);
+
+enum class AccessPathType {
+    FULL_SCAN,     // tum satirlar
+    INDEX_LOOKUP,  // anahtar kolon = deger (HashIndex)
+    RANGE_SCAN     // anahtar kolon araligi (B+ tree yaprak zinciri)
+};
+
+struct AccessPath {
+    AccessPathType type;
+    int key;        // INDEX_LOOKUP
+    int range_lo;   // RANGE_SCAN, kapali aralik
+    int range_hi;
+    bool empty;     // kosullar celisiyor (id > 5 AND id < 3): hic satir yok
+    double estimated_rows;
+    double cost;
+};
+
+// WHERE'in en ustteki AND kosullarindan (query->conditions) anahtar kolona
+// ait olanlari toplayip tam tarama, hash indeks ya da B+ tree aralik
+// taramasindan en ucuzunu secer.
+AccessPath choose_access_path(Table* table, const LinkedList<QueryCondition>& conditions,
+                              const QueryParams* params);
+
+// Kosullar anahtar kolonu tek bir degere sabitliyorsa (id = 5) true ve o
+// deger. Istatistik ve satir okumaz; tablo kilidi olmadan cagrilabilir.
+bool access_path_point_key(Table* table, const LinkedList<QueryCondition>& conditions, const QueryParams* params,
+                           int& key);
+
+// Secilen yoldan aday satirlari toplar (tablodaki satirlarin kendisi, kopya degil).
+// RANGE_SCAN sonuclari anahtar sirasindadir.
+std::vector<Row*> access_path_rows(Table* table, const AccessPath& path);
+
+std::string access_path_to_string(const AccessPath& path);
+
+#endif
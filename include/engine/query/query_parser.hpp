@@ -8,4 +8,7 @@ Query* query_parse(const std::string& query_string);
 void query_destroy(Query* query);
 void query_print(const Query* query);
 
+// WHERE agacini okunabilir metne cevirir (loglar ve query_print icin)
+std::string expr_to_string(const Expr* expr);
+
 #endif
@@ -2,6 +2,7 @@
 #define QUERY_TYPES_HPP
 
 #include <string>
+#include <vector>
 #include "../../data_structures/LinkedList.hpp"
 
 enum class JoinType {
@@ -27,30 +28,145 @@ enum class LogicalOperator {
     NOT
 };
 
+enum class ArithmeticOperator {
+    ADD,
+    SUBTRACT,
+    MULTIPLY,
+    DIVIDE
+};
+
+// WHERE ifadesinin agaci (AST)
+enum class ExprKind {
+    COLUMN,       // column_name; table_name JOIN'li sorguda tablonun sorgudaki adi
+    LITERAL,      // literal_type'a gore number / text
+    COMPARISON,   // left op right
+    AND,          // left AND right
+    OR,           // left OR right
+    NOT,          // NOT left
+    ARITHMETIC,   // left arith_op right, ya da tekli eksi (left == nullptr)
+    IN_LIST,      // left [NOT] IN (list)
+    IS_NULL,      // left IS [NOT] NULL
+    PARAMETER     // hazir sorgudaki ?, degeri calistirirken param_index ile verilir
+};
+
+enum class LiteralType {
+    NUMBER,
+    STRING,
+    NULL_VALUE
+};
+
+struct Expr {
+    ExprKind kind;
+
+    std::string table_name;
+    std::string column_name;
+
+    LiteralType literal_type;
+    double number;
+    bool is_integer;
+    std::string text;  // STRING sabiti ya da NUMBER'in yazildigi hali
+
+    ComparisonOperator op;
+    ArithmeticOperator arith_op;
+    bool negated;  // NOT IN, IS NOT NULL
+    int param_index;
+
+    Expr* left;
+    Expr* right;
+    LinkedList<Expr*> list;
+
+    explicit Expr(ExprKind k)
+        : kind(k), literal_type(LiteralType::NULL_VALUE), number(0), is_integer(false),
+          op(ComparisonOperator::EQUAL), arith_op(ArithmeticOperator::ADD), negated(false),
+          param_index(-1), left(nullptr), right(nullptr) {}
+
+    ~Expr() {
+        delete left;
+        delete right;
+        for (auto item : list) delete item;
+    }
+
+    Expr(const Expr&) = delete;
+    Expr& operator=(const Expr&) = delete;
+
+    // COLUMN: baglamada aranan ad ("tablo.kolon" ya da "kolon")
+    std::string columnRef() const { return table_name.empty() ? column_name : table_name + "." + column_name; }
+};
+
 struct QueryCondition {
     std::string column_name;
     ComparisonOperator op;
     std::string value;
     LogicalOperator logical_op;
+    int param_index;  // deger bir ? ise indeksi, degilse -1
+};
+
+// Hazir sorgu parametresi. ?'ler soldan saga 0, 1, 2... diye numaralanir.
+struct QueryParam {
+    LiteralType type;
+    double number;
+    std::string text;  // STRING degeri ya da NUMBER'in yazildigi hali
 };
 
+typedef std::vector<QueryParam> QueryParams;
+
+// Kolon adlari: tek tablolu sorguda nitelik (tablo.) parser'da dogrulanip
+// atilir. JOIN'li sorguda nitelenmis kolon "ad.kolon" olarak kalir; ad,
+// tablonun sorgudaki adidir (AS ile verilen takma ad, yoksa tablo adi) ve
+// join sonucunun kolonlari bu adla nitelenir. Niteliksiz ad join sonucunda
+// tek bir kolona uymali, birden fazlasina uyarsa sorgu reddedilir.
 struct JoinCondition {
-    std::string left_table;
-    std::string left_column;
+    std::string left_table;   // ON'daki sol kolonun tablosunun sorgudaki adi (yoksa bos)
+    std::string left_column;  // sol girdide aranir ("ad.kolon" ya da "kolon")
     std::string right_table;
-    std::string right_column;
+    std::string right_alias;   // sag tablonun sorgudaki adi
+    std::string right_column;  // sag tablonun kendi kolon adi (niteliksiz)
     JoinType join_type;
 };
 
+enum class AggregateFunction {
+    COUNT,
+    SUM,
+    AVG,
+    MIN,
+    MAX
+};
+
+// SELECT listesindeki toplama: COUNT(*), SUM(kolon) ... Sonuc kolonu
+// output_name adini tasir ("SUM(v)" ya da AS ile verilen ad); ayni ad
+// select_columns'ta da yer alir, ORDER BY ile de kullanilabilir.
+struct SelectAggregate {
+    AggregateFunction function;
+    std::string column_name;  // COUNT(*) icin bos
+    std::string output_name;
+};
+
+struct OrderByColumn {
+    std::string column_name;
+    bool ascending;
+};
+
 struct Query {
     LinkedList<std::string> select_columns;
     LinkedList<std::string> from_tables;
+    std::string from_alias;  // FROM tablosunun sorgudaki adi
+    // WHERE'in en ustteki AND zincirindeki basit "kolon op sabit" kosullari.
+    // Indeks secimi bunlara bakar; filtrenin tamami where agacindadir.
     LinkedList<QueryCondition> conditions;
+    Expr* where;
     LinkedList<JoinCondition> joins;
-    LinkedList<std::string> order_by;
-    bool order_asc;
+    LinkedList<SelectAggregate> aggregates;
+    LinkedList<std::string> group_by;
+    LinkedList<OrderByColumn> order_by;
     int limit;
     int offset;
+    int param_count;  // sorgudaki ? sayisi
+
+    Query() : where(nullptr), limit(-1), offset(0), param_count(0) {}
+    ~Query() { delete where; }
+
+    Query(const Query&) = delete;
+    Query& operator=(const Query&) = delete;
 };
 
 #endif
@@ -0,0 +1,91 @@
+#ifndef SHARD_ENGINE_HPP
+#define SHARD_ENGINE_HPP
+
+#include "query_engine.hpp"
+#include "query_types.hpp"
+#include "core/Table.hpp"
+#include "core/Row.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// id'ye gore hash ile N parcaya bolunmus tablo. Her parcanin kendi Table'i
+// (satirlar, hash indeks, B+ tree) vardir ve o tabloya sadece parcanin
+// worker thread'i dokunur; worker bir CPU'ya sabitlenir. Yazmalar ve nokta
+// okumalari tek parcaya gider, farkli parcalara yazanlar birbirini beklemez.
+// Her islem parcanin worker'ina devredilir: devir islem basina birkac
+// mikrosaniye ekler (tek cekirdekte insert ~1 us yerine ~6 us), kazanc
+// sadece eszamanli istekler farkli parcalara gittiginde vardir.
+// Diger sorgular butun parcalara dagitilir (scatter): WHERE parcalarda
+// uygulanir, eslesen satirlar toplanip (gather) sorgunun geri kalani
+// birlestirilmis tabloda calistirilir.
+class ShardedTable {
+private:
+    struct Shard {
+        Database db;   // parcanin tablosu, ShardedTable ile ayni adla
+        Table* table;  // db'deki tablo
+        std::thread worker;
+        std::deque<std::function<void()>> tasks;
+        std::mutex mutex;
+        std::condition_variable condition;
+        bool stopping;
+
+        Shard() : table(nullptr), stopping(false) {}
+    };
+
+    std::string name;
+    std::vector<Shard*> shards;
+    std::atomic<int> nextId;
+
+    void workerLoop(Shard* shard);
+    // Worker'lari durdurur, bekler ve parcalari siler
+    void stopShards();
+    // task parcanin worker'inda calisir; future bitince hazir olur
+    std::future<void> submit(size_t shard, std::function<void()> task);
+    size_t shardOf(int id) const;
+
+public:
+    // Parca basina bir thread; CPU basina bundan fazla parca acilmaz
+    static const size_t MAX_SHARDS_PER_CPU = 4;
+    static size_t maxShardCount();
+
+    // shardCount == 0 ise donanim thread sayisi kullanilir; en fazla
+    // maxShardCount(). Thread acilamazsa acilmis parcalar kapatilir ve
+    // std::system_error disari atilir.
+    ShardedTable(const std::string& tableName, const LinkedList<std::string>& colNames,
+                 const LinkedList<std::string>& colTypes, size_t shardCount = 0);
+    ~ShardedTable();
+
+    ShardedTable(const ShardedTable&) = delete;
+    ShardedTable& operator=(const ShardedTable&) = delete;
+
+    // /insert icin yeni satir id'si (silinen id'ler tekrar verilmez)
+    int nextRowId();
+
+    // Satir id'sinin parcasinda eklenir ve sahiplik parcaya gecer. Parca
+    // tablosu satiri kabul etmezse (Table::canInsert) false, sahiplik
+    // cagirana kalir.
+    bool insertRow(Row* row);
+    bool removeRow(int id);
+
+    // JOIN desteklenmez (nullptr). id = k parcasinda, digerleri scatter/gather
+    // ile calisir; sonuc her zaman cagirana ait yeni bir tablodur.
+    Table* execute(const Query* query, const QueryParams* params = nullptr);
+
+    size_t getRowCount();
+    size_t getShardCount() const { return shards.size(); }
+    std::string getName() const { return name; }
+    const LinkedList<std::string>& getColumns() const;
+    const LinkedList<std::string>& getTypes() const;
+    // Satir id'sini tutan kolon, yoksa -1
+    int getKeyColumnIndex() const;
+};
+
+#endif
@@ -0,0 +1,39 @@
+#ifndef SORT_ENGINE_HPP
+#define SORT_ENGINE_HPP
+
+#include "core/Table.hpp"
+#include "query_types.hpp"
+#include "expr_compiler.hpp"
+#include <cstddef>
+
+// ORDER BY: cok kolonlu, tipli siralama. Sayilar sayisal, metinler
+// sozluksel karsilastirilir; NULL en buyuk deger sayilir (ASC'de sonda,
+// DESC'te basta). Esit anahtarlarda girdi sirasi korunur.
+// limit >= 0 ise sadece ilk 'limit' satir uretilir (sinirli top-K heap).
+// Buyuk girdiler thread havuzunda parca parca siralanip birlestirilir.
+// Siralama verisi bellek butcesini asarsa dis siralamaya gecilir: butceye
+// sigan parcalar siralanip gecici run dosyalarina yazilir, run'lar loser
+// tree ile k-yollu birlestirilir.
+Table* sort_table(Table* table, const LinkedList<OrderByColumn>& order_by, long long limit = -1);
+
+// Siralamanin kullandigi karsilastirma (-1, 0, 1): sayilar < metinler < NULL
+int sort_compare_cells(const Cell* a, const Cell* b);
+
+// Dis siralamaya gecis esigi (byte). Varsayilan 64 MB.
+void sort_set_memory_budget(size_t bytes);
+size_t sort_get_memory_budget();
+
+// Siralama tek kolonda ve o kolon tablonun anahtar (id) kolonuysa true;
+// bu durumda B+ tree sirasi kullanilir, siralama yapilmaz.
+bool sort_can_use_index(Table* table, const LinkedList<OrderByColumn>& order_by);
+
+// Anahtar kolonun [lo, hi] araligini B+ tree sirasinda tarar. predicate
+// verilirse satirlar suzulur; ilk offset eslesme kopyalanmadan atlanir
+// (predicate yoksa yapraklar tek tek sayilmadan gecilir), limit >= 0 ise o
+// kadar satir bulununca durur.
+// DESC icin yaprak zinciri geri yurunemedigi icin ustten baslayan ve her
+// adimda iki katina cikan anahtar pencereleri kullanilir.
+Table* sort_index_scan(Table* table, int lo, int hi, bool ascending,
+                       const CompiledPredicate* predicate, long long limit = -1, long long offset = 0);
+
+#endif
@@ -0,0 +1,219 @@
+/**
+ * @file ConcurrentBPlusTree.hpp
+ * @brief Concurrent B+ tree with optimistic lock coupling
+ * @date 2025
+ */
+
+#ifndef CONCURRENT_BPLUSTREE_HPP
+#define CONCURRENT_BPLUSTREE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "../utils/PoolAllocator.hpp"
+
+class Row;
+
+namespace idx {
+
+    /**
+     * @brief Common header of tree nodes
+     *
+     * version packs the latch state: bit 1 is the write lock, bit 0 marks a
+     * node that has been unlinked (obsolete). Every write unlock bumps the
+     * version, so a reader that sees the same unlocked version before and
+     * after reading a node knows it read a consistent state.
+     */
+    struct OlcNode {
+        std::atomic<uint64_t> version;
+        std::atomic<int> count;
+        const bool is_leaf;
+
+        explicit OlcNode(bool leaf) : version(0), count(0), is_leaf(leaf) {}
+
+        /**
+         * @brief Leaves and inner nodes come from the size-class pool
+         *
+         * Nodes are always deleted through their concrete type, so the
+         * size passed to delete matches the allocation. Retired leaves
+         * are returned by whichever thread runs Epoch::collect.
+         */
+        static void* operator new(size_t size) { return PoolAllocator::allocate(size); }
+        static void operator delete(void* ptr, size_t size) { PoolAllocator::deallocate(ptr, size); }
+    };
+
+    /// Maximum number of keys in a leaf
+    static const int OLC_LEAF_CAPACITY = 64;
+    /// Maximum number of separator keys in an inner node
+    static const int OLC_INNER_CAPACITY = 64;
+
+    /**
+     * @brief Leaf node: sorted keys and their rows
+     *
+     * Fields are atomics because optimistic readers may read them while a
+     * writer holds the latch; such reads are discarded by version
+     * validation. Row and child pointers are stored with release order so
+     * a reader that loads one also sees the object it points to.
+     */
+    struct OlcLeaf : OlcNode {
+        std::atomic<int> keys[OLC_LEAF_CAPACITY];
+        std::atomic<Row*> values[OLC_LEAF_CAPACITY];
+
+        OlcLeaf() : OlcNode(true) {}
+    };
+
+    /**
+     * @brief Inner node: child i holds keys in (keys[i-1], keys[i]]
+     */
+    struct OlcInner : OlcNode {
+        std::atomic<int> keys[OLC_INNER_CAPACITY];
+        std::atomic<OlcNode*> children[OLC_INNER_CAPACITY + 1];
+
+        OlcInner() : OlcNode(false) {}
+    };
+
+    /**
+     * @brief B+ tree safe for concurrent readers and writers
+     *
+     * Uses optimistic lock coupling: readers take no latches, they read a
+     * node's version, read the node, and restart from the root if the
+     * version changed. Writers latch only the leaf they modify, plus the
+     * parent when a node splits or an empty leaf is unlinked. Inner nodes
+     * are split eagerly on the way down, so the parent always has room.
+     *
+     * Unlinked leaves are handed to Epoch and freed once no reader can
+     * still hold them; every public operation runs inside an EpochGuard.
+     *
+     * Keys are unique; inserting an existing key replaces its row. Row
+     * lifetime is the caller's concern: the tree only stores pointers.
+     */
+    class ConcurrentBPlusTree {
+    private:
+        std::atomic<OlcNode*> root;
+        std::atomic<size_t> size_;
+
+        /**
+         * @brief Key range of a leaf as seen from its parents: (low, high]
+         */
+        struct LeafBounds {
+            bool hasLow;
+            bool hasHigh;
+            int low;
+            int high;
+        };
+
+        /**
+         * @brief Optimistic descent to the leaf for key
+         *
+         * Returns the leaf and its read version; the caller validates the
+         * leaf after reading it. Sets restart instead on any conflict.
+         */
+        OlcLeaf* findLeaf(int key, uint64_t& version, LeafBounds& bounds, bool& restart) const;
+
+        void freeTree(OlcNode* node);
+        void printTree(OlcNode* node, int level) const;
+
+    public:
+        /**
+         * @brief Ordered cursor over the leaf level
+         *
+         * Copies one validated leaf at a time and moves to the next leaf by
+         * seeking from the current leaf's upper bound, so it never holds a
+         * node pointer between calls. Each leaf is a consistent snapshot;
+         * a scan running concurrently with writers sees every key that was
+         * present for the whole scan.
+         */
+        class Cursor {
+        private:
+            const ConcurrentBPlusTree* tree;
+            int keys[OLC_LEAF_CAPACITY];
+            Row* rows[OLC_LEAF_CAPACITY];
+            int count;
+            int pos;
+            bool hasNext;
+            int nextKey;
+
+            void loadLeaf(int key);
+
+        public:
+            explicit Cursor(const ConcurrentBPlusTree* t)
+                : tree(t), count(0), pos(0), hasNext(false), nextKey(0) {}
+
+            /**
+             * @brief Positions the cursor on the first key >= key
+             */
+            void seek(int key);
+
+            bool valid() const { return pos < count; }
+            int key() const { return keys[pos]; }
+            Row* row() const { return rows[pos]; }
+            void next();
+
+            /**
+             * @brief Number of keys left in the current leaf, current included
+             */
+            int leafRemaining() const { return count - pos; }
+
+            /**
+             * @brief Largest key of the current leaf
+             */
+            int leafLastKey() const { return keys[count - 1]; }
+
+            /**
+             * @brief Skips the rest of the current leaf
+             */
+            void nextLeaf();
+        };
+
+        ConcurrentBPlusTree();
+
+        /**
+         * @brief Destructor - frees all nodes; no other thread may use the tree
+         */
+        ~ConcurrentBPlusTree();
+
+        ConcurrentBPlusTree(const ConcurrentBPlusTree&) = delete;
+        ConcurrentBPlusTree& operator=(const ConcurrentBPlusTree&) = delete;
+
+        /**
+         * @brief Inserts key, or replaces the row of an existing key
+         * @return true if the key was new
+         */
+        bool insert(int key, Row* row);
+
+        /**
+         * @brief Removes key; an emptied leaf is unlinked and retired
+         * @return true if the key existed
+         */
+        bool remove(int key);
+
+        /**
+         * @brief Looks up a key without taking any latch
+         * @return Row for key, or nullptr if not found
+         */
+        Row* lookup(int key) const;
+
+        /**
+         * @brief Finds the largest key <= key
+         * @return false if there is none
+         */
+        bool floorKey(int key, int& out) const;
+
+        /**
+         * @brief Appends rows of keys in [minKey, maxKey] in key order
+         */
+        void rangeBetween(int minKey, int maxKey, std::vector<Row*>& out) const;
+
+        bool isEmpty() const { return size() == 0; }
+        size_t size() const { return size_.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Prints the tree structure; callers must exclude writers
+         */
+        void print() const;
+    };
+
+}
+
+#endif
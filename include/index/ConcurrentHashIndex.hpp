@@ -0,0 +1,255 @@
+#ifndef CONCURRENT_HASH_INDEX_HPP
+#define CONCURRENT_HASH_INDEX_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <vector>
+#include "../utils/Epoch.hpp"
+#include "../utils/PoolAllocator.hpp"
+
+// Forward declaration
+
+class Row;
+
+// HashIndex'in eszamanli hali. Yazicilar sadece kovanin serit (stripe)
+// kilidini alir; okuyucular hic kilit almaz, zinciri atomik pointer'larla
+// yurur. Cikarilan dugumler ve buyumede eskiyen kova dizisi Epoch ile
+// serbest birakilir, search kendi EpochGuard'ini tutar.
+// Ayni anahtar tekrar eklenebilir; search en son ekleneni bulur, remove
+// onu siler (HashIndex ile ayni).
+// Alloc: dugumlerin allocator'u; dugumler Epoch'un topladigi thread'de
+// birakilabilir (bkz. PoolAllocator)
+template<typename K, typename Alloc = PoolAllocator>
+class ConcurrentHashIndex {
+private:
+    struct Node {
+
+        const K key;
+        Row* const row;
+        std::atomic<Node*> next;
+
+        Node(const K& k, Row* r, Node* n) : key(k), row(r), next(n) {}
+
+        static void* operator new(size_t size) { return Alloc::allocate(size); }
+        static void operator delete(void* ptr, size_t size) { Alloc::deallocate(ptr, size); }
+
+    };
+
+    // Buyurken yeni dizi kurulur, eskisi okuyucular icin oldugu gibi kalir
+    struct BucketArray {
+
+        size_t capacity;  // 2'nin kuvveti, STRIPE_COUNT'tan kucuk degil
+        std::atomic<Node*>* heads;
+
+        explicit BucketArray(size_t cap) : capacity(cap), heads(new std::atomic<Node*>[cap]) {
+            for (size_t i = 0; i < cap; ++i) heads[i].store(nullptr, std::memory_order_relaxed);
+        }
+        ~BucketArray() { delete[] heads; }
+
+    };
+
+    // Kova i'yi serit (i % STRIPE_COUNT) korur; kapasite STRIPE_COUNT'un
+    // kati oldugundan bir kova buyumeden sonra da ayni seritte kalir
+    static const size_t STRIPE_COUNT = 16;
+
+    std::atomic<BucketArray*> current;
+    std::atomic<size_t> size;
+    std::mutex stripes[STRIPE_COUNT];
+
+    static size_t getHash(const K& key);
+    static void deleteNode(void* node);
+    static void deleteArray(void* array);  // zincirleriyle birlikte
+    void resize();
+
+public:
+
+    explicit ConcurrentHashIndex(size_t initialCapacity = 16);
+    ~ConcurrentHashIndex();
+
+    ConcurrentHashIndex(const ConcurrentHashIndex&) = delete;
+    ConcurrentHashIndex& operator=(const ConcurrentHashIndex&) = delete;
+
+    void insert(K key, Row* row);
+    void remove(const K& key);
+
+    Row* search(const K& key) const;
+    size_t getSize() const;
+    size_t getCapacity() const;
+
+};
+
+
+
+
+
+template <typename K, typename Alloc>
+size_t ConcurrentHashIndex<K, Alloc>::getHash(const K& key) {
+    // Ardisik id'ler de kovalara ve seritlere dagilsin
+    uint64_t h = static_cast<uint64_t>(std::hash<K>{}(key)) * 0x9E3779B97F4A7C15ULL;
+    return static_cast<size_t>(h ^ (h >> 32));
+}
+
+
+
+template <typename K, typename Alloc>
+void ConcurrentHashIndex<K, Alloc>::deleteNode(void* node) {
+    delete static_cast<Node*>(node);
+}
+
+
+
+template <typename K, typename Alloc>
+void ConcurrentHashIndex<K, Alloc>::deleteArray(void* array) {
+    BucketArray* buckets = static_cast<BucketArray*>(array);
+    for (size_t i = 0; i < buckets->capacity; ++i) {
+        Node* current = buckets->heads[i].load(std::memory_order_relaxed);
+        while (current != nullptr) {
+
+            Node* temp = current;
+            current = current->next.load(std::memory_order_relaxed);
+            delete temp;
+
+        }
+    }
+    delete buckets;
+}
+
+
+
+template <typename K, typename Alloc>
+ConcurrentHashIndex<K, Alloc>::ConcurrentHashIndex(size_t initialCapacity) : size(0) {
+    size_t capacity = STRIPE_COUNT;
+    while (capacity < initialCapacity) capacity *= 2;
+    current.store(new BucketArray(capacity), std::memory_order_relaxed);
+}
+
+
+
+template <typename K, typename Alloc>
+ConcurrentHashIndex<K, Alloc>::~ConcurrentHashIndex() {
+    deleteArray(current.load(std::memory_order_relaxed));
+}
+
+
+
+template <typename K, typename Alloc>
+void ConcurrentHashIndex<K, Alloc>::resize() {
+    std::unique_lock<std::mutex> locks[STRIPE_COUNT];
+    for (size_t i = 0; i < STRIPE_COUNT; ++i) locks[i] = std::unique_lock<std::mutex>(stripes[i]);
+
+    BucketArray* old = current.load(std::memory_order_relaxed);
+    // Baska bir yazici bizden once buyutmus olabilir
+    if (size.load(std::memory_order_relaxed) < old->capacity * 3 / 4) return;
+
+    // Dugumler kopyalanir: eski zincirleri yuruyen okuyucular etkilenmez.
+    // Kova icindeki sira (yeniden eskiye) korunur.
+    BucketArray* grown = new BucketArray(old->capacity * 2);
+    std::vector<Node*> tails(grown->capacity, nullptr);
+    for (size_t i = 0; i < old->capacity; ++i) {
+        for (Node* node = old->heads[i].load(std::memory_order_relaxed); node != nullptr;
+             node = node->next.load(std::memory_order_relaxed)) {
+
+            size_t index = getHash(node->key) & (grown->capacity - 1);
+            Node* copy = new Node(node->key, node->row, nullptr);
+            if (tails[index] == nullptr) grown->heads[index].store(copy, std::memory_order_relaxed);
+            else tails[index]->next.store(copy, std::memory_order_relaxed);
+            tails[index] = copy;
+
+        }
+    }
+
+    current.store(grown, std::memory_order_release);
+    Epoch::retire(old, deleteArray);
+}
+
+
+
+template <typename K, typename Alloc>
+void ConcurrentHashIndex<K, Alloc>::insert(K key, Row* row) {
+
+    if (size.load(std::memory_order_relaxed) >= current.load(std::memory_order_acquire)->capacity * 3 / 4) {
+        resize();
+    }
+
+    size_t hash = getHash(key);
+    std::lock_guard<std::mutex> lock(stripes[hash % STRIPE_COUNT]);
+    BucketArray* buckets = current.load(std::memory_order_acquire);
+    std::atomic<Node*>& head = buckets->heads[hash & (buckets->capacity - 1)];
+    head.store(new Node(key, row, head.load(std::memory_order_relaxed)), std::memory_order_release);
+    size.fetch_add(1, std::memory_order_relaxed);
+
+}
+
+
+
+template <typename K, typename Alloc>
+Row* ConcurrentHashIndex<K, Alloc>::search(const K& key) const {
+
+    EpochGuard guard;
+    size_t hash = getHash(key);
+    BucketArray* buckets = current.load(std::memory_order_acquire);
+    Node* node = buckets->heads[hash & (buckets->capacity - 1)].load(std::memory_order_acquire);
+    while (node != nullptr) {
+
+        if (node->key == key) return node->row;
+        node = node->next.load(std::memory_order_acquire);
+
+    }
+
+    return nullptr;
+}
+
+
+
+template <typename K, typename Alloc>
+void ConcurrentHashIndex<K, Alloc>::remove(const K& key) {
+
+    size_t hash = getHash(key);
+    std::lock_guard<std::mutex> lock(stripes[hash % STRIPE_COUNT]);
+    BucketArray* buckets = current.load(std::memory_order_acquire);
+    std::atomic<Node*>& head = buckets->heads[hash & (buckets->capacity - 1)];
+    Node* node = head.load(std::memory_order_relaxed);
+    Node* prev = nullptr;
+
+
+
+    while (node != nullptr) {
+
+        Node* next = node->next.load(std::memory_order_relaxed);
+        if (node->key == key) {
+
+            // Dugumun kendi next'i degismez: onu okumakta olan okuyucu
+            // zincirin kalanina devam eder
+            if (prev == nullptr) head.store(next, std::memory_order_release);
+
+            else prev->next.store(next, std::memory_order_release);
+
+            size.fetch_sub(1, std::memory_order_relaxed);
+            Epoch::retire(node, deleteNode);
+            return;
+
+        }
+
+        prev = node;
+        node = next;
+
+    }
+
+}
+
+
+
+template <typename K, typename Alloc>
+size_t ConcurrentHashIndex<K, Alloc>::getSize() const { return size.load(std::memory_order_relaxed); }
+
+
+
+template <typename K, typename Alloc>
+size_t ConcurrentHashIndex<K, Alloc>::getCapacity() const { return current.load(std::memory_order_acquire)->capacity; }
+
+
+
+#endif // CONCURRENT_HASH_INDEX_HPP
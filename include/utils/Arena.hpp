@@ -0,0 +1,93 @@
+#ifndef ARENA_HPP
+#define ARENA_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+#include "PoolAllocator.hpp"
+
+// Sorgu basina bump allocator. Bloklar buyuk parcalar halinde alinir,
+// nesneler blogun icinde ardisik yerlestirilir ve hicbiri tek tek
+// serbest birakilmaz: butun bloklar Arena yikilirken birakilir.
+//
+// Her thread kendi blogundan ayirir (blok listesi disinda kilit yok), bu
+// yuzden ThreadPool'un yardimci thread'leri de ayni arena'yi kullanabilir.
+//
+// Cell, Row, Table ve LinkedList::Node'un operator new'i thread'in aktif
+// arena'sini (ArenaScope) kullanir; aktif arena yoksa sinifin kendi
+// allocator'undan (heap ya da PoolAllocator) ayirir.
+// Nesnenin onundeki baslik nereden ayrildigini tutar, delete arena
+// nesnesinde sadece yikiciyi calistirir. Arena'dan ayrilan nesneler arena
+// yikilmadan once silinmeli ya da birakilmalidir; paylasilan yapilara
+// (katalogdaki tablolar) eklenmemelidir.
+class Arena {
+private:
+    static const size_t BLOCK_SIZE = 64 * 1024;
+
+    uint64_t id;  // thread'lerdeki blok imleci bu arena'ya mi ait
+    std::mutex mutex;
+    std::vector<char*> blocks;
+    std::atomic<size_t> reserved;
+
+    char* newBlock(size_t size);
+
+public:
+    // Nesne basligi; arena'dan ayrilan siniflarin hizalamasi bunu asmamali
+    static const size_t OBJECT_ALIGNMENT = 8;
+
+    Arena();
+    ~Arena();
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    // 16 bayta hizali; thread-safe
+    void* allocate(size_t size);
+
+    // Bloklar icin ayrilan toplam bayt
+    size_t bytesReserved() const { return reserved.load(std::memory_order_relaxed); }
+
+    // Thread'in aktif arena'si, yoksa nullptr
+    static Arena* current();
+
+    // Sinif operator new/delete'leri icin; arena yoksa Alloc'tan. size
+    // birakirken de ayirmadaki gibi verilir.
+    template <typename Alloc = HeapAllocator>
+    static void* allocateObject(size_t size);
+    template <typename Alloc = HeapAllocator>
+    static void releaseObject(void* ptr, size_t size);
+};
+
+template <typename Alloc>
+void* Arena::allocateObject(size_t size) {
+    Arena* arena = current();
+    char* block = arena ? static_cast<char*>(arena->allocate(size + OBJECT_ALIGNMENT))
+                        : static_cast<char*>(Alloc::allocate(size + OBJECT_ALIGNMENT));
+    *reinterpret_cast<Arena**>(block) = arena;
+    return block + OBJECT_ALIGNMENT;
+}
+
+template <typename Alloc>
+void Arena::releaseObject(void* ptr, size_t size) {
+    if (!ptr) return;
+    char* block = static_cast<char*>(ptr) - OBJECT_ALIGNMENT;
+    // Arena nesnesinin bellegi arena ile birlikte birakilir
+    if (*reinterpret_cast<Arena**>(block) == nullptr) Alloc::deallocate(block, size + OBJECT_ALIGNMENT);
+}
+
+// Kapsam boyunca thread'in aktif arena'sini degistirir (nullptr: heap)
+class ArenaScope {
+private:
+    Arena* previous;
+
+public:
+    explicit ArenaScope(Arena* arena);
+    ~ArenaScope();
+
+    ArenaScope(const ArenaScope&) = delete;
+    ArenaScope& operator=(const ArenaScope&) = delete;
+};
+
+#endif
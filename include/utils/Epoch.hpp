@@ -0,0 +1,38 @@
+#ifndef EPOCH_HPP
+#define EPOCH_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+// Epoch tabanli geri kazanim. Kilitsiz okuyucu paylasilan yapiya girmeden
+// once EpochGuard alir; yazici yapidan cikardigi nesneyi hemen silmez,
+// retire ile birakir. Nesne, cikarildigi andan once girmis butun
+// okuyucular ciktiktan sonra silinir.
+class Epoch {
+public:
+    typedef void (*Deleter)(void*);
+
+    // Thread'in okuma bolgesine giris/cikis (ic ice girilebilir)
+    static void enter();
+    static void exit();
+
+    // ptr artik yapidan erisilemez; guvenli oldugunda deleter(ptr) cagrilir
+    static void retire(void* ptr, Deleter deleter);
+
+    // Silinebilecek nesneleri hemen siler, silinen sayisi doner
+    static size_t collect();
+
+    // Silinmeyi bekleyen nesne sayisi
+    static size_t pendingCount();
+};
+
+class EpochGuard {
+public:
+    EpochGuard() { Epoch::enter(); }
+    ~EpochGuard() { Epoch::exit(); }
+
+    EpochGuard(const EpochGuard&) = delete;
+    EpochGuard& operator=(const EpochGuard&) = delete;
+};
+
+#endif
@@ -0,0 +1,36 @@
+#ifndef POOL_ALLOCATOR_HPP
+#define POOL_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <new>
+
+// Kucuk, sabit boyutlu dugumler icin boyut sinifli havuz (LinkedList,
+// hash indeks ve B+ tree dugumleri). Her thread'in sinif basina kendi bos
+// listesi vardir; ayirma ve birakma kilit almaz. Liste bosalinca once
+// ortak havuzdan bir parti alinir, o da bossa 64 KB'lik bir slab
+// dilimlenir. Bir thread'de fazla biriken bloklar partiler halinde ortak
+// havuza doner; baska thread'in biraktigi dugumler oradan tekrar kullanilir.
+// Slab'ler isletim sistemine geri verilmez.
+//
+// Konteynerlere Alloc sablon parametresi olarak verilir: statik allocate
+// ve deallocate; deallocate'e ayirmadaki boyut verilmelidir.
+class PoolAllocator {
+public:
+    // Bundan buyuk istekler dogrudan operator new'e gider
+    static const size_t MAX_POOLED_SIZE = 1024;
+
+    static void* allocate(size_t size);
+    static void deallocate(void* ptr, size_t size);
+
+    // Slab'lere ayrilan toplam bayt (butun thread'ler)
+    static size_t bytesReserved();
+};
+
+// Ayni arayuzle dogrudan heap
+class HeapAllocator {
+public:
+    static void* allocate(size_t size) { return ::operator new(size); }
+    static void deallocate(void* ptr, size_t) { ::operator delete(ptr); }
+};
+
+#endif
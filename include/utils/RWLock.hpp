@@ -0,0 +1,95 @@
+#ifndef RWLOCK_HPP
+#define RWLOCK_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+
+// Kilit bekleme metrikleri. *_waits: hemen alinamayip beklenen edinimler,
+// *_wait_ns: bu beklemelerin toplam suresi.
+struct LockStats {
+    uint64_t read_acquires;
+    uint64_t read_waits;
+    uint64_t read_wait_ns;
+    uint64_t write_acquires;
+    uint64_t write_waits;
+    uint64_t write_wait_ns;
+    uint64_t max_wait_ns;
+};
+
+// Okuyucu/yazici kilidi: okuyucular birlikte girer, yazici tek basina.
+// Yazici oncelikli: bekleyen yazici gate'i tutar, yeni okuyucular gate'te
+// bekler; surekli okuma yukunde yazici ac kalmaz.
+// Once try_lock denenir; kilit bossa saat okunmaz, sadece gercek bekleme
+// zamanlanir. Sayaclar kilit basina ve tum kilitler icin toplam tutulur.
+class RWLock {
+private:
+    std::shared_mutex mutex;
+    std::mutex gate;
+    std::atomic<uint64_t> readAcquires;
+    std::atomic<uint64_t> readWaits;
+    std::atomic<uint64_t> readWaitNs;
+    std::atomic<uint64_t> writeAcquires;
+    std::atomic<uint64_t> writeWaits;
+    std::atomic<uint64_t> writeWaitNs;
+    std::atomic<uint64_t> maxWaitNs;
+
+public:
+    RWLock();
+
+    RWLock(const RWLock&) = delete;
+    RWLock& operator=(const RWLock&) = delete;
+
+    void lockRead();
+    void unlockRead();
+    void lockWrite();
+    void unlockWrite();
+
+    LockStats getStats() const;
+
+    // Surecteki butun RWLock'larin toplami (silinmis tablolarinkiler dahil)
+    static LockStats globalStats();
+};
+
+class ReadGuard {
+private:
+    RWLock* lock;
+
+public:
+    explicit ReadGuard(RWLock& l) : lock(&l) { lock->lockRead(); }
+    ~ReadGuard() { lock->unlockRead(); }
+
+    ReadGuard(const ReadGuard&) = delete;
+    ReadGuard& operator=(const ReadGuard&) = delete;
+};
+
+class WriteGuard {
+private:
+    RWLock* lock;
+
+public:
+    explicit WriteGuard(RWLock& l) : lock(&l) { lock->lockWrite(); }
+    ~WriteGuard() { lock->unlockWrite(); }
+
+    WriteGuard(const WriteGuard&) = delete;
+    WriteGuard& operator=(const WriteGuard&) = delete;
+};
+
+// Birden fazla kilidi okuma icin alir. Kilitler adres sirasiyla alinir;
+// her yerde ayni sira kullanildigi icin iki sorgu birbirini kilitleyemez.
+// Ayni kilit birden fazla verilirse bir kez alinir.
+class ReadGuardSet {
+private:
+    std::vector<RWLock*> locks;
+
+public:
+    explicit ReadGuardSet(std::vector<RWLock*> l);
+    ~ReadGuardSet();
+
+    ReadGuardSet(const ReadGuardSet&) = delete;
+    ReadGuardSet& operator=(const ReadGuardSet&) = delete;
+};
+
+#endif
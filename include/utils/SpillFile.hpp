@@ -0,0 +1,50 @@
+#ifndef SPILLFILE_HPP
+#define SPILLFILE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+// Bellek butcesini asan operatorlerin (grace hash join vb.) ara verisini
+// yazdigi gecici dosya. Once sirayla yazilir, sonra rewind() ile bastan
+// okunur. Dosya tmpfile() ile acilir; kapaninca isletim sistemi siler.
+class SpillFile {
+private:
+    std::FILE* file;
+    size_t bytesWritten;
+    bool writeFailed;
+
+public:
+    SpillFile();
+    ~SpillFile();
+
+    SpillFile(const SpillFile&) = delete;
+    SpillFile& operator=(const SpillFile&) = delete;
+
+    bool open();
+    bool isOpen() const { return file != nullptr; }
+
+    void write(const void* data, size_t size);
+    void writeUInt64(uint64_t value);
+    void writeInt64(int64_t value);
+    void writeDouble(double value);
+    void writeString(const std::string& value);
+
+    // Yazma bitti, okumaya bastan basla
+    void rewind();
+
+    bool read(void* data, size_t size);
+    bool readUInt64(uint64_t& value);
+    bool readInt64(int64_t& value);
+    bool readDouble(double& value);
+    bool readString(std::string& value);
+
+    size_t size() const { return bytesWritten; }
+
+    // Bir yazma (ya da rewind'daki flush) eksik kaldiysa kalici olarak true;
+    // dosyanin icerigi artik eksiktir, okuyan operator bunu kullanmamali
+    bool failed() const { return writeFailed; }
+};
+
+#endif
@@ -0,0 +1,57 @@
+#ifndef THREADPOOL_HPP
+#define THREADPOOL_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+// Tablo taramalarinda varsayilan morsel boyu (satir)
+static const size_t MORSEL_ROWS = 16384;
+
+// Sabit sayida worker thread'i olan havuz. Motor icindeki paralel isler
+// (partition'li join vb.) her seferinde thread acmak yerine bunu kullanir.
+class ThreadPool {
+private:
+    std::vector<std::thread> workers;
+    std::queue<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool stopping;
+
+    void workerLoop();
+
+public:
+    // threadCount == 0 ise donanim thread sayisi kullanilir
+    explicit ThreadPool(size_t threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void submit(std::function<void()> task);
+
+    // fn(0..taskCount-1) cagrilarini havuza dagitir ve hepsi bitene kadar bekler.
+    // Cagiran thread de is alir; bu sayede ic ice cagrilar kilitlenmez.
+    // fn istisna atarsa kalan indeksler atlanir, ilk istisna cagirana atilir.
+    void parallelFor(size_t taskCount, const std::function<void(size_t)>& fn);
+
+    // Morsel-driven tarama: [0, itemCount) araligi morselSize'lik parcalara
+    // bolunur ve fn(morsel, begin, end) her parca icin bir kez cagrilir.
+    // Her katilimci (cagiran + yardimcilar) bitisik bir morsel dilimiyle
+    // baslar, kendi diliminin basindan alir; dilimi bitince en dolu diger
+    // dilimin sonundan calar. Sonuclar morsel numarasiyla sirali birlestirilebilir.
+    // Istisnada parallelFor gibi davranir.
+    void parallelMorsels(size_t itemCount, size_t morselSize,
+                         const std::function<void(size_t, size_t, size_t)>& fn);
+
+    size_t getThreadCount() const;
+
+    // Motorun ortak havuzu
+    static ThreadPool& global();
+};
+
+#endif
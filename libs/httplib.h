@@ -5,7 +5,13 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <cctype>
 #include <functional>
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
 #include <sys/socket.h>
 #include <netinet/in.h>
 #include <unistd.h>
@@ -16,15 +22,38 @@ namespace httplib {
     struct Request {
         std::string method;
         std::string path;
-        std::map<std::string, std::string> params;
+        std::multimap<std::string, std::string> params;
  
         bool has_param(const std::string& key) const {
             return params.find(key) != params.end();
         }
-        std::string get_param_value(const std::string& key) const {
-            return params.at(key);
+        std::string get_param_value(const std::string& key, size_t id = 0) const {
+            auto range = params.equal_range(key);
+            for (auto it = range.first; it != range.second; ++it, --id) {
+                if (id == 0) return it->second;
+            }
+            return std::string();
+        }
+        size_t get_param_value_count(const std::string& key) const {
+            return params.count(key);
         }
     };
+
+    // %XX ve '+' kodlamasini cozer
+    inline std::string decode_url(const std::string& s) {
+        std::string out;
+        for (size_t i = 0; i < s.size(); i++) {
+            if (s[i] == '%' && i + 2 < s.size() && isxdigit((unsigned char)s[i + 1]) && isxdigit((unsigned char)s[i + 2])) {
+                out += (char)std::stoi(s.substr(i + 1, 2), nullptr, 16);
+                i += 2;
+            } else if (s[i] == '+') {
+                out += ' ';
+            } else {
+                out += s[i];
+            }
+        }
+        return out;
+    }
  
     struct Response {
         int status = 200;
@@ -42,6 +71,14 @@ namespace httplib {
             handlers[path] = handler;
         }
  
+        // Baglantilari isleyen thread sayisi; listen'dan once ayarlanir
+        void set_thread_count(size_t count) {
+            thread_count = count > 0 ? count : 1;
+        }
+ 
+        // Baglantilar kuyruga alinir ve thread_count worker tarafindan
+        // paralel islenir: handler'lar ayni anda calisabilir, paylastiklari
+        // durumu kendileri kilitler
         bool listen(const char* host, int port) {
             int server_fd = socket(AF_INET, SOCK_STREAM, 0);
             if (server_fd < 0) return false;
@@ -59,46 +96,90 @@ namespace httplib {
  
             std::cout << "Sunucu " << port << " portunda aktif..." << std::endl;
  
+            // Worker'lar surec boyunca yasar (listen donmez)
+            for (size_t i = 0; i < thread_count; i++) {
+                std::thread([this]() { worker_loop(); }).detach();
+            }
+ 
             while (true) {
                 int new_socket = accept(server_fd, nullptr, nullptr);
-                char buffer[2048] = {0};
-                read(new_socket, buffer, 2048);
- 
-                // Çok basit HTTP ayrıştırıcı
-                std::string raw_req(buffer);
-                Request req;
-                Response res;
- 
-                // Path ve Query string ayıklama
-                size_t first_space = raw_req.find(' ');
-                size_t second_space = raw_req.find(' ', first_space + 1);
-                std::string full_path = raw_req.substr(first_space + 1, second_space - first_space - 1);
-                size_t q_mark = full_path.find('?');
-                req.path = full_path.substr(0, q_mark);
- 
-                if (q_mark != std::string::npos) {
-                    std::string query = full_path.substr(q_mark + 1);
-                    size_t eq = query.find('=');
-                    req.params[query.substr(0, eq)] = query.substr(eq + 1);
+                if (new_socket < 0) continue;
+                {
+                    std::lock_guard<std::mutex> lock(queue_mutex);
+                    pending.push_back(new_socket);
                 }
+                queue_ready.notify_one();
+            }
+            return true;
+        }
  
-                if (handlers.count(req.path)) {
-                    handlers[req.path](req, res);
+    private:
+        std::map<std::string, Handler> handlers;  // listen'dan sonra degismez
+        size_t thread_count = std::max(8u, std::thread::hardware_concurrency());
+        std::deque<int> pending;
+        std::mutex queue_mutex;
+        std::condition_variable queue_ready;
+ 
+        void worker_loop() {
+            while (true) {
+                int socket;
+                {
+                    std::unique_lock<std::mutex> lock(queue_mutex);
+                    queue_ready.wait(lock, [this]() { return !pending.empty(); });
+                    socket = pending.front();
+                    pending.pop_front();
                 }
+                handle(socket);
+            }
+        }
  
-                std::string response = "HTTP/1.1 " + std::to_string(res.status) + " OK\r\n";
-                response += "Content-Type: text/plain\r\n";
-                response += "Content-Length: " + std::to_string(res.body.length()) + "\r\n\r\n";
-                response += res.body;
+        void handle(int new_socket) {
+            char buffer[2048] = {0};
+            read(new_socket, buffer, 2048);
+ 
+            // Çok basit HTTP ayrıştırıcı
+            std::string raw_req(buffer);
+            Request req;
+            Response res;
+ 
+            // Path ve Query string ayıklama
+            size_t first_space = raw_req.find(' ');
+            size_t second_space = raw_req.find(' ', first_space + 1);
+            std::string full_path = raw_req.substr(first_space + 1, second_space - first_space - 1);
+            size_t q_mark = full_path.find('?');
+            req.path = full_path.substr(0, q_mark);
+ 
+            if (q_mark != std::string::npos) {
+                std::string query = full_path.substr(q_mark + 1);
+                // key=value&key=value; ayni anahtar birden fazla kez gelebilir
+                size_t start = 0;
+                while (start <= query.size()) {
+                    size_t amp = query.find('&', start);
+                    if (amp == std::string::npos) amp = query.size();
+                    std::string pair = query.substr(start, amp - start);
+                    if (!pair.empty()) {
+                        size_t eq = pair.find('=');
+                        std::string key = decode_url(pair.substr(0, eq));
+                        std::string value = eq == std::string::npos ? "" : decode_url(pair.substr(eq + 1));
+                        req.params.emplace(key, value);
+                    }
+                    start = amp + 1;
+                }
+            }
  
-                send(new_socket, response.c_str(), response.length(), 0);
-                close(new_socket);
+            auto handler = handlers.find(req.path);
+            if (handler != handlers.end()) {
+                handler->second(req, res);
             }
-            return true;
-        }
  
-    private:
-        std::map<std::string, Handler> handlers;
+            std::string response = "HTTP/1.1 " + std::to_string(res.status) + " OK\r\n";
+            response += "Content-Type: text/plain\r\n";
+            response += "Content-Length: " + std::to_string(res.body.length()) + "\r\n\r\n";
+            response += res.body;
+ 
+            send(new_socket, response.c_str(), response.length(), 0);
+            close(new_socket);
+        }
     };
 }
  
@@ -1,20 +1,58 @@
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
 #include <iostream>
+#include <mutex>
 #include <string>
+#include <system_error>
 #include <sstream>
 #include <vector>
 #include "include/core/Table.hpp"
 #include "include/core/Row.hpp"
 #include "include/core/Cell.hpp"
+#include "include/core/Mvcc.hpp"
 #include "include/data_structures/LinkedList.hpp"
+#include "include/utils/Epoch.hpp"
 #include "include/utils/FileManager.hpp"
 #include "include/engine/query/query_parser.hpp"
 #include "include/engine/query/query_engine.hpp"
+#include "include/engine/query/plan_cache.hpp"
+#include "include/engine/query/query_optimizer.hpp"
+#include "include/engine/query/shard_engine.hpp"
 #include "libs/httplib.h"
 
 using namespace std;
 
-// Global Veritabanı
-Table* dbTable = nullptr;
+// Global katalog: sunucudaki tum tablolar
+Database catalog;
+
+// Tablo kullanan istekler katalogun sema kilidini okuma icin tutar (tablo
+// silinemez), /create_table ve /drop_table yazma icin. Satir okuyanlar
+// tablonun okuma, /insert ve /delete yazma kilidini alir. Uzun sorgular
+// kilitleri sadece MVCC snapshot'i alirken tutar (query_execute).
+
+// table parametresi verilmeyen istekler (eski tek tablolu API) bu tabloya gider:
+// son olusturulan ya da yuklenen tablo
+string defaultTableName;
+mutex defaultTableMutex;
+
+void setDefaultTable(const string& name) {
+    lock_guard<mutex> lock(defaultTableMutex);
+    defaultTableName = name;
+}
+
+Table* requestTable(const httplib::Request& req) {
+    if (req.has_param("table")) return catalog.getTable(req.get_param_value("table"));
+    lock_guard<mutex> lock(defaultTableMutex);
+    return catalog.getTable(defaultTableName);
+}
+
+// Istek parcali bir tabloya gidiyorsa o tablo, yoksa nullptr
+ShardedTable* requestShardedTable(const httplib::Request& req) {
+    if (req.has_param("table")) return catalog.getShardedTable(req.get_param_value("table"));
+    lock_guard<mutex> lock(defaultTableMutex);
+    return catalog.getShardedTable(defaultTableName);
+}
 
 // JSON Yardımcısı
 string rowToJson(Row* row, const LinkedList<string>& colNames) {
@@ -22,7 +60,7 @@ string rowToJson(Row* row, const LinkedList<string>& colNames) {
     ss << "{";
     ss << "\"id\": " << row->getId() << ", ";
     ss << "\"data\": {";
-    LinkedList<Cell*>& cells = row->getCells();
+    const LinkedList<Cell*>& cells = row->getCells();
     
     auto itCol = colNames.begin();
     auto itCell = cells.begin();
@@ -39,6 +77,8 @@ string rowToJson(Row* row, const LinkedList<string>& colNames) {
             ss << cell->getInt();
         } else if (cell->getType() == CellType::DOUBLE) {
             ss << cell->getDouble();
+        } else {
+            ss << "null";
         }
         
         ++itCol; ++itCell; first = false;
@@ -47,70 +87,255 @@ string rowToJson(Row* row, const LinkedList<string>& colNames) {
     return ss.str();
 }
 
+// Sorgu sonucunu JSON'a cevirir
+string resultToJson(Table* result) {
+    stringstream ss;
+    ss << "{ \"status\": \"success\", \"result\": {";
+    ss << "\"columns\": [";
+    const LinkedList<string>& cols = result->getColumns();
+    bool first = true;
+    for(auto col : cols) { 
+        if(!first) ss << ","; 
+        ss << "\"" << col << "\""; 
+        first = false; 
+    }
+    ss << "], \"rows\": [";
+    
+    const LinkedList<Row*>& rows = result->getRows();
+    bool firstRow = true;
+    for(auto row : rows) {
+        if(!firstRow) ss << ",";
+        ss << "{";
+        const LinkedList<Cell*>& cells = row->getCells();
+        auto itCol = cols.begin(); 
+        auto itCell = cells.begin(); 
+        bool fc = true;
+        while(itCol != cols.end() && itCell != cells.end()) {
+            if(!fc) ss << ",";
+            ss << "\"" << *itCol << "\": ";
+            if ((*itCell)->getType() == CellType::STRING) 
+                ss << "\"" << (*itCell)->getString() << "\"";
+            else if ((*itCell)->getType() == CellType::INT) 
+                ss << (*itCell)->getInt();
+            else if ((*itCell)->getType() == CellType::DOUBLE) 
+                ss << (*itCell)->getDouble();
+            else 
+                ss << "null";
+            ++itCol; ++itCell; fc = false;
+        }
+        ss << "}"; 
+        firstRow = false;
+    }
+    ss << "]}}";
+    return ss.str();
+}
+
+// Tablo ozetini (/get_all formati) JSON'a yazar
+void tableToJson(Table* table, stringstream& ss) {
+    ReadGuard tableGuard(table->getLock());
+    ss << "\"" << table->getName() << "\": {";
+    
+    // Sütunlar
+    ss << "\"columns\": [";
+    const LinkedList<string>& cols = table->getColumns();
+    bool first = true;
+    for(auto col : cols) { if(!first) ss << ","; ss << "\"" << col << "\""; first = false; }
+    ss << "],";
+
+    // Tipler
+    ss << "\"types\": [";
+    const LinkedList<string>& types = table->getTypes();
+    first = true;
+    for(auto t : types) { if(!first) ss << ","; ss << "\"" << t << "\""; first = false; }
+    ss << "],";
+    
+    // Satırlar
+    ss << "\"rows\": [";
+    const LinkedList<Row*>& rows = table->getRows();
+    bool firstRow = true;
+    for(auto row : rows) {
+        if(!firstRow) ss << ",";
+        ss << "{\"id\": " << row->getId() << ", ";
+        const LinkedList<Cell*>& cells = row->getCells();
+        auto itCol = cols.begin(); auto itCell = cells.begin(); bool fc = true;
+        while(itCol != cols.end() && itCell != cells.end()) {
+            if(!fc) ss << ",";
+            ss << "\"" << *itCol << "\": ";
+            if ((*itCell)->getType() == CellType::STRING) ss << "\"" << (*itCell)->getString() << "\"";
+            else if ((*itCell)->getType() == CellType::INT) ss << (*itCell)->getInt();
+            else if ((*itCell)->getType() == CellType::DOUBLE) ss << (*itCell)->getDouble();
+            else ss << "null";
+            ++itCol; ++itCell; fc = false;
+        }
+        ss << "}"; firstRow = false;
+    }
+    ss << "], \"indexes\": {\"btree\": [], \"hash\": []}}";
+}
+
+// /insert'te yeni satirin id'si: tablonun id kolonu (keyColumn) icin
+// parametre verildiyse o deger, verilmediyse (ya da bossa) nextId.
+// Deger tamsayi degilse false.
+bool requestRowId(const httplib::Request& req, const LinkedList<string>& cols, int keyColumn, int nextId,
+                  int& newId) {
+    newId = nextId;
+    if(keyColumn < 0) return true;
+    string keyName;
+    int column = 0;
+    for(const auto& col : cols) {
+        if(column++ == keyColumn) keyName = col;
+    }
+    string val = req.has_param(keyName.c_str()) ? req.get_param_value(keyName.c_str()) : "";
+    if(val.empty()) return true;
+    char* end = nullptr;
+    errno = 0;
+    long id = strtol(val.c_str(), &end, 10);
+    if(*end != '\0' || errno == ERANGE || id < INT_MIN || id > INT_MAX) return false;
+    newId = static_cast<int>(id);
+    return true;
+}
+
+// /insert parametrelerinden satir kurar: her kolonun degeri ayni adli
+// parametreden, kolon tipine gore donusturulerek. id kolonu (keyColumn,
+// yoksa -1) satir id'sini alir.
+Row* rowFromRequest(const httplib::Request& req, const LinkedList<string>& cols,
+                    const LinkedList<string>& types, int newId, int keyColumn) {
+    Row* newRow = new Row(newId);
+    
+    auto itCol = cols.begin();
+    auto itType = types.begin();
+    int column = 0;
+    
+    while(itCol != cols.end()) {
+        string colName = *itCol;
+        string type = (itType != types.end()) ? *itType : "STRING";
+        
+        if(column++ == keyColumn) {
+            newRow->addCell(newId);
+            ++itCol;
+            if(itType != types.end()) ++itType;
+            continue;
+        }
+
+        string val = "";
+        
+        // Parametre kontrolü
+        if (req.has_param(colName.c_str())) {
+            val = req.get_param_value(colName.c_str());
+        } else {
+            cout << "[UYARI] Parametre eksik: [" << colName << "]. Bos gecilecek." << endl;
+        }
+
+        // Hücre Oluşturma ve Dönüştürme
+        Cell* newCell = nullptr;
+        try {
+            if(type == "INT") {
+                int iVal = 0;
+                if(!val.empty()) {
+                    try { iVal = stoi(val); } 
+                    catch(...) { iVal = 0; cout << "[HATA] " << colName << " icin INT donusumu basarisiz: " << val << endl; }
+                }
+                newCell = new Cell(iVal);
+            }
+            else if(type == "DOUBLE") {
+                double dVal = 0.0;
+                if(!val.empty()) {
+                    try { dVal = stod(val); } 
+                    catch(...) { dVal = 0.0; cout << "[HATA] " << colName << " icin DOUBLE donusumu basarisiz: " << val << endl; }
+                }
+                newCell = new Cell(dVal);
+            }
+            else {
+                newCell = new Cell(val);
+            }
+        } catch (...) {
+            newCell = new Cell("ERROR");
+        }
+        
+        newRow->appendCell(newCell);
+        
+        ++itCol;
+        if(itType != types.end()) ++itType;
+    }
+    return newRow;
+}
+
+void lockStatsToJson(const LockStats& stats, stringstream& ss) {
+    ss << "{\"read_acquires\": " << stats.read_acquires << ", \"read_waits\": " << stats.read_waits
+       << ", \"read_wait_ns\": " << stats.read_wait_ns << ", \"write_acquires\": " << stats.write_acquires
+       << ", \"write_waits\": " << stats.write_waits << ", \"write_wait_ns\": " << stats.write_wait_ns
+       << ", \"max_wait_ns\": " << stats.max_wait_ns << "}";
+}
+
+// Plani katalog uzerinde calistirip JSON cevabi dondurur (JOIN'ler
+// katalogdaki diger tablolari isimle bulur)
+string executePlan(const Query* query, const QueryParams* params) {
+    // Ara sonuclar ve sonuc tablosu bu arena'dan ayrilir; JSON yazildiktan
+    // sonra hepsi tek seferde birakilir
+    Arena arena;
+    ArenaScope arenaScope(&arena);
+    Table* result = query_execute(&catalog, query, params);
+    if(!result) {
+        cout << "[ERROR] Query execution returned null" << endl;
+        return "{\"status\": \"error\", \"msg\": \"Query execution failed\"}";
+    }
+    
+    cout << "[DEBUG] Query executed, result table has " << result->getRowCount() << " rows" << endl;
+    string json = resultToJson(result);
+    // query_execute her zaman yeni bir tablo dondurur
+    delete result;
+    return json;
+}
+
 int main() {
     cout << "==========================================" << endl;
     cout << "   C++ DB Engine (Debug & Universal GET)  " << endl;
     cout << "==========================================" << endl;
 
     // 1. Veritabanını Yükle
-    dbTable = FileManager::loadTable("test_db.json");
-    if (dbTable == nullptr) {
+    Table* loaded = FileManager::loadTable("test_db.json");
+    if (loaded == nullptr) {
         cout << "[BILGI] Tablo bulunamadi, varsayilan 'users' tablosu olusturuluyor..." << endl;
         // Varsayılan Tablo Yapısı
         LinkedList<string> cols; cols.push_back("id"); cols.push_back("name"); cols.push_back("age");
         LinkedList<string> types; types.push_back("INT"); types.push_back("STRING"); types.push_back("INT");
-        dbTable = new Table("users", cols, types);
+        loaded = new Table("users", cols, types);
     }
+    // Katalog tablolari STRING kolonlarini sozlukle kodlar (yuklenen satirlar dahil)
+    loaded->enableDictionaryEncoding();
+    catalog.addTable(loaded);
+    setDefaultTable(loaded->getName());
 
     httplib::Server svr;
 
-    // --- 1. TÜM VERİYİ GETİR (/get_all) ---
-    svr.Get("/get_all", [&](const httplib::Request&, httplib::Response& res) {
-        if(!dbTable) { res.set_content("{}", "application/json"); return; }
-        
+    // --- 1. TÜM VERİYİ GETİR (/get_all[?table=...]) ---
+    // table verilmezse katalogdaki butun tablolar doner
+    svr.Get("/get_all", [&](const httplib::Request& req, httplib::Response& res) {
+        ReadGuard schemaGuard(catalog.getSchemaLock());
         stringstream ss;
-        ss << "{ \"" << dbTable->getName() << "\": {";
-        
-        // Sütunlar
-        ss << "\"columns\": [";
-        const LinkedList<string>& cols = dbTable->getColumns();
-        bool first = true;
-        for(auto col : cols) { if(!first) ss << ","; ss << "\"" << col << "\""; first = false; }
-        ss << "],";
-
-        // Tipler
-        ss << "\"types\": [";
-        const LinkedList<string>& types = dbTable->getTypes();
-        first = true;
-        for(auto t : types) { if(!first) ss << ","; ss << "\"" << t << "\""; first = false; }
-        ss << "],";
-        
-        // Satırlar
-        ss << "\"rows\": [";
-        const LinkedList<Row*>& rows = dbTable->getRows();
-        bool firstRow = true;
-        for(auto row : rows) {
-            if(!firstRow) ss << ",";
-            ss << "{\"id\": " << row->getId() << ", ";
-            LinkedList<Cell*>& cells = row->getCells();
-            auto itCol = cols.begin(); auto itCell = cells.begin(); bool fc = true;
-            while(itCol != cols.end() && itCell != cells.end()) {
-                if(!fc) ss << ",";
-                ss << "\"" << *itCol << "\": ";
-                if ((*itCell)->getType() == CellType::STRING) ss << "\"" << (*itCell)->getString() << "\"";
-                else if ((*itCell)->getType() == CellType::INT) ss << (*itCell)->getInt();
-                else ss << (*itCell)->getDouble();
-                ++itCol; ++itCell; fc = false;
+        ss << "{ ";
+        if(req.has_param("table")) {
+            Table* table = catalog.getTable(req.get_param_value("table"));
+            if(table) tableToJson(table, ss);
+        } else {
+            bool first = true;
+            for(const auto& name : catalog.getTableNames()) {
+                Table* table = catalog.getTable(name);
+                if(!table) continue;
+                if(!first) ss << ", ";
+                tableToJson(table, ss);
+                first = false;
             }
-            ss << "}"; firstRow = false;
         }
-        ss << "], \"indexes\": {\"btree\": [], \"hash\": []}}}";
+        ss << "}";
         res.set_content(ss.str(), "application/json");
     });
 
-    // --- 2. VERİ EKLE (/insert) - DEBUG MODU ---
+    // --- 2. VERİ EKLE (/insert[?table=...]) - DEBUG MODU ---
     svr.Get("/insert", [&](const httplib::Request& req, httplib::Response& res) {
-        if(!dbTable) { res.status = 400; return; }
+        ReadGuard schemaGuard(catalog.getSchemaLock());
+        ShardedTable* shardedTable = requestShardedTable(req);
+        Table* dbTable = shardedTable ? nullptr : requestTable(req);
+        if(!shardedTable && !dbTable) { res.status = 400; return; }
         
         cout << "\n[DEBUG] --- Insert Istegi Basladi ---" << endl;
 
@@ -120,79 +345,77 @@ int main() {
             cout << "   -> Anahtar: [" << param.first << "] Deger: [" << param.second << "]" << endl;
         }
 
-        // Yeni ID Hesapla
-        int rowCount = 0;
-        const LinkedList<Row*>& rows = dbTable->getRows();
-        auto itRow = rows.begin();
-        while(itRow != rows.end()) { rowCount++; ++itRow; }
-        int newId = rowCount + 1;
-
-        // Yeni Satırı Oluştur
-        Row* newRow = new Row(newId);
-        
-        const LinkedList<string>& cols = dbTable->getColumns();
-        const LinkedList<string>& types = dbTable->getTypes();
-        LinkedList<Cell*>& rowCells = newRow->getCells();
-
-        auto itCol = cols.begin();
-        auto itType = types.begin();
-        
-        while(itCol != cols.end()) {
-            string colName = *itCol;
-            string type = (itType != types.end()) ? *itType : "STRING";
-            
-            string val = "";
-            
-            // Parametre kontrolü
-            if (req.has_param(colName.c_str())) {
-                val = req.get_param_value(colName.c_str());
-            } else {
-                cout << "[UYARI] Parametre eksik: [" << colName << "]. Bos gecilecek." << endl;
+        // Parcali tablo: satir id'sinin parcasinda, o parcanin worker'i
+        // tarafindan eklenir; tablo kilidi yoktur
+        if(shardedTable) {
+            int keyColumn = shardedTable->getKeyColumnIndex();
+            int newId;
+            if(!requestRowId(req, shardedTable->getColumns(), keyColumn, shardedTable->nextRowId(), newId)) {
+                res.status = 400;
+                res.set_content("{\"status\": \"error\", \"msg\": \"id must be an integer\"}", "application/json");
+                return;
             }
-
-            // Hücre Oluşturma ve Dönüştürme
-            Cell* newCell = nullptr;
-            try {
-                if(type == "INT") {
-                    int iVal = 0;
-                    if(!val.empty()) {
-                        try { iVal = stoi(val); } 
-                        catch(...) { iVal = 0; cout << "[HATA] " << colName << " icin INT donusumu basarisiz: " << val << endl; }
-                    }
-                    newCell = new Cell(iVal);
-                }
-                else if(type == "DOUBLE") {
-                    double dVal = 0.0;
-                    if(!val.empty()) {
-                        try { dVal = stod(val); } 
-                        catch(...) { dVal = 0.0; cout << "[HATA] " << colName << " icin DOUBLE donusumu basarisiz: " << val << endl; }
-                    }
-                    newCell = new Cell(dVal);
-                }
-                else {
-                    newCell = new Cell(val);
-                }
-            } catch (...) {
-                newCell = new Cell("ERROR");
+            Row* newRow = rowFromRequest(req, shardedTable->getColumns(), shardedTable->getTypes(), newId, keyColumn);
+            if(!shardedTable->insertRow(newRow)) {
+                delete newRow;
+                res.status = 409;
+                res.set_content("{\"status\": \"error\", \"msg\": \"Duplicate id\"}", "application/json");
+                return;
             }
-            
-            rowCells.push_back(newCell);
-            
-            ++itCol;
-            if(itType != types.end()) ++itType;
+            cout << "[OK] Yeni satir eklendi. ID: " << newId << endl;
+            res.set_content("{\"status\": \"inserted\"}", "application/json");
+            return;
         }
 
-        dbTable->insertRow(newRow);
+        WriteGuard tableGuard(dbTable->getLock());
+
+        // Yeni ID: verilmediyse en buyuk id + 1 (silinen id'ler tekrar verilmez)
+        int keyColumn = dbTable->getKeyColumnIndex();
+        int newId;
+        if(!requestRowId(req, dbTable->getColumns(), keyColumn, dbTable->nextRowId(), newId)) {
+            res.status = 400;
+            res.set_content("{\"status\": \"error\", \"msg\": \"id must be an integer\"}", "application/json");
+            return;
+        }
+
+        // Yeni Satırı Oluştur
+        Row* newRow = rowFromRequest(req, dbTable->getColumns(), dbTable->getTypes(), newId, keyColumn);
+
+        // Ayni id'li satir varsa eklenmez: indeksler tekil kalir
+        if(!dbTable->insertVersioned(newRow)) {
+            delete newRow;
+            res.status = 409;
+            res.set_content("{\"status\": \"error\", \"msg\": \"Duplicate id\"}", "application/json");
+            return;
+        }
+        dbTable->collectGarbage(Mvcc::oldestSnapshot());
         cout << "[OK] Yeni satir eklendi. ID: " << newId << endl;
         res.set_content("{\"status\": \"inserted\"}", "application/json");
     });
 
-    // --- 3. SATIR SİL (/delete) ---
+    // --- 3. SATIR SİL (/delete[?table=...]) ---
     svr.Get("/delete", [&](const httplib::Request& req, httplib::Response& res) {
+        ReadGuard schemaGuard(catalog.getSchemaLock());
+        ShardedTable* shardedTable = requestShardedTable(req);
+        if(shardedTable) {
+            try {
+                int id = stoi(req.get_param_value("id"));
+                shardedTable->removeRow(id);
+                res.set_content("{\"status\": \"deleted\"}", "application/json");
+            } catch(...) {
+                res.status = 400;
+            }
+            return;
+        }
+        Table* dbTable = requestTable(req);
+        if(!dbTable) { res.status = 400; return; }
+        WriteGuard tableGuard(dbTable->getLock());
         if(req.has_param("id")) {
             try {
                 int id = stoi(req.get_param_value("id"));
-                dbTable->removeRow(id);
+                // Satir eski snapshot'larda gorunmeye devam eder; onlar bitince toplanir
+                dbTable->removeVersioned(id);
+                dbTable->collectGarbage(Mvcc::oldestSnapshot());
                 cout << "[OK] Satir silindi. ID: " << id << endl;
                 res.set_content("{\"status\": \"deleted\"}", "application/json");
             } catch(...) {
@@ -209,7 +432,10 @@ int main() {
 
         cout << "[INFO] Yeni Tablo Istegi: " << name << endl;
 
-        if(dbTable) delete dbTable;
+        if(name.empty()) {
+            res.set_content("{\"status\": \"error\", \"msg\": \"Missing table name\"}", "application/json");
+            return;
+        }
 
         LinkedList<string> cols;
         LinkedList<string> types;
@@ -220,97 +446,202 @@ int main() {
         stringstream ssTypes(typeStr);
         while(getline(ssTypes, segment, ',')) types.push_back(segment);
 
-        dbTable = new Table(name, cols, types);
+        // shards=N: tablo id'ye gore N parcaya bolunur (shard_engine). Her
+        // parca bir thread acar; N 1..ShardedTable::maxShardCount() olmali
+        if(req.has_param("shards")) {
+            string shardStr = req.get_param_value("shards");
+            char* end = nullptr;
+            long shardCount = strtol(shardStr.c_str(), &end, 10);
+            if(shardStr.empty() || *end != '\0' || shardCount < 1 ||
+               static_cast<unsigned long>(shardCount) > ShardedTable::maxShardCount()) {
+                res.status = 400;
+                res.set_content("{\"status\": \"error\", \"msg\": \"shards must be between 1 and " +
+                                to_string(ShardedTable::maxShardCount()) + "\"}", "application/json");
+                return;
+            }
+            ShardedTable* sharded;
+            try {
+                sharded = new ShardedTable(name, cols, types, static_cast<size_t>(shardCount));
+            } catch(const std::system_error&) {
+                res.status = 503;
+                res.set_content("{\"status\": \"error\", \"msg\": \"Could not start shard threads\"}", "application/json");
+                return;
+            }
+            WriteGuard schemaGuard(catalog.getSchemaLock());
+            if(catalog.addShardedTable(sharded) != 0) {
+                delete sharded;
+                res.set_content("{\"status\": \"error\", \"msg\": \"Table already exists\"}", "application/json");
+                return;
+            }
+            setDefaultTable(name);
+            res.set_content("{\"status\": \"table_created\"}", "application/json");
+            return;
+        }
+
+        Table* table = new Table(name, cols, types);
+        table->enableDictionaryEncoding();
+        WriteGuard schemaGuard(catalog.getSchemaLock());
+        if(catalog.addTable(table) != 0) {
+            delete table;
+            res.set_content("{\"status\": \"error\", \"msg\": \"Table already exists\"}", "application/json");
+            return;
+        }
+        setDefaultTable(name);
         res.set_content("{\"status\": \"table_created\"}", "application/json");
     });
+
+    // --- 4b. TABLO SİL (/drop_table?name=...) ---
+    svr.Get("/drop_table", [&](const httplib::Request& req, httplib::Response& res) {
+        string name = req.get_param_value("name");
+        WriteGuard schemaGuard(catalog.getSchemaLock());
+        if(!catalog.dropTable(name)) {
+            res.set_content("{\"status\": \"error\", \"msg\": \"Unknown table\"}", "application/json");
+            return;
+        }
+        cout << "[INFO] Tablo silindi: " << name << endl;
+        res.set_content("{\"status\": \"table_dropped\"}", "application/json");
+    });
+
+    // --- 4c. TABLO LİSTESİ (/tables) ---
+    svr.Get("/tables", [&](const httplib::Request&, httplib::Response& res) {
+        ReadGuard schemaGuard(catalog.getSchemaLock());
+        stringstream ss;
+        ss << "{\"status\": \"success\", \"version\": " << Mvcc::currentVersion()
+           << ", \"active_snapshots\": " << Mvcc::activeSnapshots()
+           << ", \"epoch_pending\": " << Epoch::pendingCount() << ", \"tables\": [";
+        bool first = true;
+        for(const auto& name : catalog.getTableNames()) {
+            ShardedTable* sharded = catalog.getShardedTable(name);
+            if(sharded) {
+                if(!first) ss << ",";
+                ss << "{\"name\": \"" << name << "\", \"rows\": " << sharded->getRowCount()
+                   << ", \"shards\": " << sharded->getShardCount() << "}";
+                first = false;
+                continue;
+            }
+            Table* table = catalog.getTable(name);
+            if(!table) continue;
+            if(!first) ss << ",";
+            ReadGuard tableGuard(table->getLock());
+            ss << "{\"name\": \"" << name << "\", \"rows\": " << table->getRowCount()
+               << ", \"retired_rows\": " << table->getRetiredCount() << "}";
+            first = false;
+        }
+        ss << "]}";
+        res.set_content(ss.str(), "application/json");
+    });
     
     // --- 5. QUERY ÇALIŞTIRMA (/query) ---
+    // Ayni sorgu sekli tekrar geldiginde parse edilmez; plan onbellekten gelir.
     svr.Get("/query", [&](const httplib::Request& req, httplib::Response& res) {
-        if(!dbTable) {
-            res.set_content("{\"status\": \"error\", \"msg\": \"No table loaded\"}", "application/json");
-            return;
-        }
-        
         string queryStr = req.get_param_value("query");
-        // URL decode için basit bir yaklaşım - boşlukları düzelt
-        // httplib zaten decode ediyor ama ekstra boşlukları temizle
-        while(queryStr.find("%20") != string::npos) {
-            queryStr.replace(queryStr.find("%20"), 3, " ");
-        }
-        // Trim
-        queryStr.erase(0, queryStr.find_first_not_of(" \t\r\n"));
-        queryStr.erase(queryStr.find_last_not_of(" \t\r\n") + 1);
         cout << "[SQL] Executing: " << queryStr << endl;
         
-        // Query'yi parse et
-        Query* query = query_parse(queryStr);
-        if(!query) {
+        QueryPlan plan = PlanCache::global().get(queryStr);
+        if(!plan) {
             cout << "[ERROR] Query parse failed for: " << queryStr << endl;
             res.set_content("{\"status\": \"error\", \"msg\": \"Query parse failed\"}", "application/json");
             return;
         }
         
-        cout << "[DEBUG] Query parsed successfully" << endl;
-        query_print(query);
+        res.set_content(executePlan(plan.get(), nullptr), "application/json");
+    });
+
+    // --- 6. HAZIR SORGU (/prepare?query=SELECT ... WHERE id = ?) ---
+    svr.Get("/prepare", [&](const httplib::Request& req, httplib::Response& res) {
+        string queryStr = req.get_param_value("query");
+        QueryPlan plan = PlanCache::global().get(queryStr);
+        if(!plan) {
+            res.set_content("{\"status\": \"error\", \"msg\": \"Query parse failed\"}", "application/json");
+            return;
+        }
         
-        // Database oluştur ve tabloyu ekle
-        Database db;
-        db.addTable(dbTable);
+        int statementId = PreparedStatements::global().add(plan);
+        stringstream ss;
+        ss << "{\"status\": \"prepared\", \"statement_id\": " << statementId
+           << ", \"param_count\": " << plan->param_count << "}";
+        res.set_content(ss.str(), "application/json");
+    });
+
+    // --- 7. HAZIR SORGUYU ÇALIŞTIR (/execute?id=1&param=5&param='Ali') ---
+    svr.Get("/execute", [&](const httplib::Request& req, httplib::Response& res) {
+        if(!req.has_param("id")) {
+            res.set_content("{\"status\": \"error\", \"msg\": \"Missing statement id\"}", "application/json");
+            return;
+        }
         
-        // Query'yi çalıştır
-        Table* result = query_execute(&db, query);
+        QueryPlan plan = PreparedStatements::global().get(atoi(req.get_param_value("id").c_str()));
+        if(!plan) {
+            res.set_content("{\"status\": \"error\", \"msg\": \"Unknown statement id\"}", "application/json");
+            return;
+        }
         
-        if(!result) {
-            cout << "[ERROR] Query execution returned null" << endl;
-            query_destroy(query);
-            res.set_content("{\"status\": \"error\", \"msg\": \"Query execution failed\"}", "application/json");
+        QueryParams params;
+        size_t paramCount = req.get_param_value_count("param");
+        for(size_t i = 0; i < paramCount; i++) {
+            params.push_back(query_param_from_string(req.get_param_value("param", i)));
+        }
+        if(params.size() != static_cast<size_t>(plan->param_count)) {
+            res.set_content("{\"status\": \"error\", \"msg\": \"Wrong number of parameters\"}", "application/json");
             return;
         }
         
-        cout << "[DEBUG] Query executed, result table has " << result->getRows().size() << " rows" << endl;
+        res.set_content(executePlan(plan.get(), &params), "application/json");
+    });
+
+    // --- 8. HAZIR SORGUYU SİL (/deallocate?id=1) ---
+    svr.Get("/deallocate", [&](const httplib::Request& req, httplib::Response& res) {
+        bool removed = PreparedStatements::global().remove(atoi(req.get_param_value("id").c_str()));
+        if(removed) res.set_content("{\"status\": \"deallocated\"}", "application/json");
+        else res.set_content("{\"status\": \"error\", \"msg\": \"Unknown statement id\"}", "application/json");
+    });
+
+    // --- 9. TABLO İSTATİSTİKLERİ (/stats[?table=...]) ---
+    svr.Get("/stats", [&](const httplib::Request& req, httplib::Response& res) {
+        ReadGuard schemaGuard(catalog.getSchemaLock());
+        Table* dbTable = requestTable(req);
+        if(!dbTable) {
+            res.set_content("{\"status\": \"error\", \"msg\": \"No table loaded\"}", "application/json");
+            return;
+        }
         
-        // Sonucu JSON'a çevir
+        ReadGuard tableGuard(dbTable->getLock());
+        shared_ptr<const TableStats> stats = table_stats_get(dbTable);
         stringstream ss;
-        ss << "{ \"status\": \"success\", \"result\": {";
-        ss << "\"columns\": [";
-        const LinkedList<string>& cols = result->getColumns();
+        ss << "{\"status\": \"success\", \"rows\": " << stats->row_count << ", \"columns\": [";
         bool first = true;
-        for(auto col : cols) { 
-            if(!first) ss << ","; 
-            ss << "\"" << col << "\""; 
-            first = false; 
+        for(const auto& col : stats->columns) {
+            if(!first) ss << ",";
+            ss << "{\"name\": \"" << col.name << "\", \"non_null\": " << col.non_null_count
+               << ", \"nulls\": " << col.null_count << ", \"distinct\": " << col.distinct_count;
+            if(col.has_range) ss << ", \"min\": " << col.min << ", \"max\": " << col.max;
+            ss << "}";
+            first = false;
         }
-        ss << "], \"rows\": [";
-        
-        const LinkedList<Row*>& rows = result->getRows();
-        bool firstRow = true;
-        for(auto row : rows) {
-            if(!firstRow) ss << ",";
-            ss << "{";
-            LinkedList<Cell*>& cells = row->getCells();
-            auto itCol = cols.begin(); 
-            auto itCell = cells.begin(); 
-            bool fc = true;
-            while(itCol != cols.end() && itCell != cells.end()) {
-                if(!fc) ss << ",";
-                ss << "\"" << *itCol << "\": ";
-                if ((*itCell)->getType() == CellType::STRING) 
-                    ss << "\"" << (*itCell)->getString() << "\"";
-                else if ((*itCell)->getType() == CellType::INT) 
-                    ss << (*itCell)->getInt();
-                else 
-                    ss << (*itCell)->getDouble();
-                ++itCol; ++itCell; fc = false;
-            }
-            ss << "}"; 
-            firstRow = false;
+        ss << "]}";
+        res.set_content(ss.str(), "application/json");
+    });
+
+    // --- 10. KİLİT BEKLEME METRİKLERİ (/lock_stats) ---
+    // total: surecteki butun kilitler, schema: katalog kilidi, tables: tablo basina
+    svr.Get("/lock_stats", [&](const httplib::Request&, httplib::Response& res) {
+        stringstream ss;
+        ss << "{\"status\": \"success\", \"total\": ";
+        lockStatsToJson(RWLock::globalStats(), ss);
+        ss << ", \"schema\": ";
+        lockStatsToJson(catalog.getSchemaLock().getStats(), ss);
+        ss << ", \"tables\": {";
+        ReadGuard schemaGuard(catalog.getSchemaLock());
+        bool first = true;
+        for(const auto& name : catalog.getTableNames()) {
+            Table* table = catalog.getTable(name);
+            if(!table) continue;
+            if(!first) ss << ", ";
+            ss << "\"" << name << "\": ";
+            lockStatsToJson(table->getLock().getStats(), ss);
+            first = false;
         }
-        ss << "]}}";
-        
-        query_destroy(query);
-        // Eğer result yeni bir tablo ise (filter/select sonucu), silmemiz gerekebilir
-        // Ama şimdilik sadece orijinal tabloyu kullanıyoruz, bu yüzden silmiyoruz
-        
+        ss << "}}";
         res.set_content(ss.str(), "application/json");
     });
 
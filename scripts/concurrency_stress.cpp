@@ -0,0 +1,230 @@
+// Kilitsiz yapilar icin eszamanlilik stres surucusu: ConcurrentBPlusTree,
+// ConcurrentHashIndex ve Epoch geri kazanimi. Yazicilar insert/remove
+// yaparken okuyucular nokta aramasi ve imlec taramasi yapar; sonunda her
+// yapi tek thread'li modelle karsilastirilir. Hata varsa cikis kodu 1.
+//
+// Asil amac sanitizer altinda calistirmak (bkz. scripts/concurrency_stress.sh):
+// ASAN serbest birakilmis dugum okumasini, TSAN veri yarisini yakalar.
+//
+//   concurrency_stress [tur_sayisi]
+
+#include "include/index/ConcurrentBPlusTree.hpp"
+#include "include/index/ConcurrentHashIndex.hpp"
+#include "include/utils/Epoch.hpp"
+#include <atomic>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <set>
+#include <thread>
+#include <vector>
+
+static const int KEY_SPACE = 20000;  // cift anahtarlar sabit, tekler yazicilarin
+static const int WRITERS = 2;
+static const int READERS = 3;
+
+// Yapilar Row'u hic okumaz; anahtardan turetilen sahte pointer yeter
+static Row* fake_row(int key) {
+    return reinterpret_cast<Row*>(static_cast<uintptr_t>(key) * 16 + 8);
+}
+
+// Tek anahtar k, k / 2 % WRITERS numarali yazicinindir; yazicilar ayni
+// anahtara dokunmaz, bitince her birinin modeli tam durumu verir
+static int writer_key(std::mt19937& rng, int writer) {
+    int slot = static_cast<int>(rng() % (KEY_SPACE / 2 / WRITERS));
+    return (slot * WRITERS + writer) * 2 + 1;
+}
+
+static int stress_btree(int rounds) {
+    idx::ConcurrentBPlusTree tree;
+    for (int k = 0; k < KEY_SPACE; k += 2) tree.insert(k, fake_row(k));
+
+    std::atomic<bool> stop(false);
+    std::atomic<int> errors(0);
+    std::atomic<long> scans(0);
+    std::vector<std::set<int>> owned(WRITERS);
+    std::vector<std::thread> threads;
+
+    for (int w = 0; w < WRITERS; w++) {
+        threads.emplace_back([&, w]() {
+            std::mt19937 rng(w + 1);
+            for (int i = 0; i < rounds; i++) {
+                int key = writer_key(rng, w);
+                if (rng() % 2) {
+                    tree.insert(key, fake_row(key));
+                    owned[w].insert(key);
+                } else if (tree.remove(key) != (owned[w].erase(key) == 1)) {
+                    errors++;
+                }
+            }
+        });
+    }
+    for (int r = 0; r < READERS; r++) {
+        threads.emplace_back([&, r]() {
+            std::mt19937 rng(100 + r);
+            while (!stop.load()) {
+                int key = static_cast<int>(rng() % (KEY_SPACE / 2)) * 2;
+                if (tree.lookup(key) != fake_row(key)) errors++;
+
+                // Tarama: anahtarlar artan sirada, sabit cift anahtarlarin hepsi gorunur
+                if (rng() % 64 == 0) {
+                    idx::ConcurrentBPlusTree::Cursor cursor(&tree);
+                    long long previous = LLONG_MIN;
+                    int expected_even = 0;
+                    for (cursor.seek(INT_MIN); cursor.valid(); cursor.next()) {
+                        if (cursor.key() <= previous) errors++;
+                        previous = cursor.key();
+                        if (cursor.key() % 2 != 0) continue;
+                        if (cursor.key() != expected_even || cursor.row() != fake_row(cursor.key())) errors++;
+                        expected_even = cursor.key() + 2;
+                    }
+                    if (expected_even != KEY_SPACE) errors++;
+                    scans++;
+                }
+            }
+        });
+    }
+    for (int w = 0; w < WRITERS; w++) threads[w].join();
+    stop = true;
+    for (size_t i = WRITERS; i < threads.size(); i++) threads[i].join();
+
+    size_t expected_size = KEY_SPACE / 2;
+    for (const auto& keys : owned) {
+        expected_size += keys.size();
+        for (int key : keys) {
+            if (tree.lookup(key) != fake_row(key)) errors++;
+        }
+    }
+    if (tree.size() != expected_size) errors++;
+    std::printf("btree: errors=%d scans=%ld size=%zu\n", errors.load(), scans.load(), tree.size());
+    return errors.load();
+}
+
+static int stress_hash_index(int rounds) {
+    // Kucuk baslar: yazicilar calisirken birkac kez buyur
+    ConcurrentHashIndex<int> index(16);
+    for (int k = 0; k < KEY_SPACE; k += 2) index.insert(k, fake_row(k));
+
+    std::atomic<bool> stop(false);
+    std::atomic<int> errors(0);
+    std::atomic<long> reads(0);
+    std::vector<std::set<int>> owned(WRITERS);
+    std::vector<std::thread> threads;
+
+    for (int w = 0; w < WRITERS; w++) {
+        threads.emplace_back([&, w]() {
+            std::mt19937 rng(w + 1);
+            for (int i = 0; i < rounds; i++) {
+                // Ikinci yarida anahtar araligi genisler, dizi tekrar buyur
+                int key = writer_key(rng, w) + (i > rounds / 2 ? 2 * KEY_SPACE : 0);
+                bool present = owned[w].count(key) == 1;
+                if (rng() % 2) {
+                    // Tekrarlanan anahtar eklenebilir; model tekil kalsin
+                    if (!present) index.insert(key, fake_row(key));
+                    owned[w].insert(key);
+                } else if (present) {
+                    index.remove(key);
+                    owned[w].erase(key);
+                }
+            }
+        });
+    }
+    for (int r = 0; r < READERS; r++) {
+        threads.emplace_back([&, r]() {
+            std::mt19937 rng(200 + r);
+            while (!stop.load()) {
+                int key = static_cast<int>(rng() % (KEY_SPACE / 2)) * 2;
+                if (index.search(key) != fake_row(key)) errors++;
+                reads++;
+            }
+        });
+    }
+    for (int w = 0; w < WRITERS; w++) threads[w].join();
+    stop = true;
+    for (size_t i = WRITERS; i < threads.size(); i++) threads[i].join();
+
+    size_t expected_size = KEY_SPACE / 2;
+    for (const auto& keys : owned) {
+        expected_size += keys.size();
+        for (int key : keys) {
+            if (index.search(key) != fake_row(key)) errors++;
+        }
+    }
+    if (index.getSize() != expected_size) errors++;
+    std::printf("hash index: errors=%d reads=%ld size=%zu capacity=%zu\n", errors.load(), reads.load(),
+                index.getSize(), index.getCapacity());
+    return errors.load();
+}
+
+// Epoch: yazicilar yuvadaki nesneyi yenisiyle degistirip eskisini retire
+// eder; okuyucular guard altinda nesneyi okur. Erken silinen nesne ASAN'da
+// use-after-free, sanitizer'siz calismada bozuk magic olarak gorunur.
+struct Payload {
+    static const uint64_t MAGIC = 0x5EC0DE5EC0DEULL;
+    uint64_t magic;
+    int value;
+
+    explicit Payload(int v) : magic(MAGIC), value(v) {}
+    ~Payload() { magic = 0; }
+};
+
+static void delete_payload(void* ptr) {
+    delete static_cast<Payload*>(ptr);
+}
+
+static int stress_epoch(int rounds) {
+    const int SLOTS = 64;
+    std::vector<std::atomic<Payload*>> slots(SLOTS);
+    for (int i = 0; i < SLOTS; i++) slots[i].store(new Payload(i));
+
+    std::atomic<bool> stop(false);
+    std::atomic<int> errors(0);
+    std::atomic<long> reads(0);
+    std::vector<std::thread> threads;
+
+    for (int w = 0; w < WRITERS; w++) {
+        threads.emplace_back([&, w]() {
+            std::mt19937 rng(w + 1);
+            for (int i = 0; i < rounds; i++) {
+                int slot = static_cast<int>(rng() % SLOTS);
+                Payload* old = slots[slot].exchange(new Payload(slot), std::memory_order_acq_rel);
+                Epoch::retire(old, delete_payload);
+                if (i % 1024 == 0) Epoch::collect();
+            }
+        });
+    }
+    for (int r = 0; r < READERS; r++) {
+        threads.emplace_back([&, r]() {
+            std::mt19937 rng(300 + r);
+            while (!stop.load()) {
+                EpochGuard guard;
+                int slot = static_cast<int>(rng() % SLOTS);
+                Payload* payload = slots[slot].load(std::memory_order_acquire);
+                if (payload->magic != Payload::MAGIC || payload->value != slot) errors++;
+                reads++;
+            }
+        });
+    }
+    for (int w = 0; w < WRITERS; w++) threads[w].join();
+    stop = true;
+    for (size_t i = WRITERS; i < threads.size(); i++) threads[i].join();
+
+    Epoch::collect();
+    size_t pending = Epoch::pendingCount();
+    for (int i = 0; i < SLOTS; i++) delete slots[i].load();
+    std::printf("epoch: errors=%d reads=%ld pending=%zu\n", errors.load(), reads.load(), pending);
+    return errors.load();
+}
+
+int main(int argc, char** argv) {
+    int rounds = argc > 1 ? std::atoi(argv[1]) : 200000;
+    if (rounds <= 0) rounds = 200000;
+
+    int errors = 0;
+    errors += stress_btree(rounds);
+    errors += stress_hash_index(rounds);
+    errors += stress_epoch(rounds);
+    std::printf("%s\n", errors == 0 ? "OK" : "FAILED");
+    return errors == 0 ? 0 : 1;
+}
@@ -0,0 +1,41 @@
+#!/bin/sh
+# concurrency_stress.cpp'yi sanitizer'siz, ASAN ve TSAN ile derleyip calistirir.
+#
+#   scripts/concurrency_stress.sh [tur_sayisi] [plain|asan|tsan ...]
+#
+# Derleme ciktilari build/stress/ altina yazilir. Bir varyant hata verirse
+# cikis kodu 1 olur.
+
+set -u
+cd "$(dirname "$0")/.." || exit 1
+
+ROUNDS=${1:-200000}
+[ $# -gt 0 ] && shift
+VARIANTS=${*:-"plain asan tsan"}
+
+CXX=${CXX:-g++}
+OUT=build/stress
+mkdir -p "$OUT"
+SOURCES=$(find src -name '*.cpp')
+
+status=0
+for variant in $VARIANTS; do
+    case $variant in
+        plain) flags="-O2" ;;
+        asan) flags="-O1 -g -fsanitize=address -fno-omit-frame-pointer" ;;
+        tsan) flags="-O1 -g -fsanitize=thread" ;;
+        *) echo "Bilinmeyen varyant: $variant" >&2; exit 2 ;;
+    esac
+
+    echo "== $variant"
+    # shellcheck disable=SC2086
+    if ! $CXX -std=c++17 $flags -pthread -I. -Iinclude -o "$OUT/concurrency_stress_$variant" \
+        scripts/concurrency_stress.cpp $SOURCES; then
+        status=1
+        continue
+    fi
+    if ! "$OUT/concurrency_stress_$variant" "$ROUNDS"; then
+        status=1
+    fi
+done
+exit $status
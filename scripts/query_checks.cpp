@@ -0,0 +1,312 @@
+// Sorgu motoru icin davranis kontrolleri: kucuk tablolar kurar, SQL
+// calistirir ve sonucu beklenen satirlarla karsilastirir. Hata varsa cikis
+// kodu 1. Derleyip calistirmak icin scripts/query_checks.sh.
+
+#include "include/core/Table.hpp"
+#include "include/engine/query/query_engine.hpp"
+#include "include/engine/query/query_optimizer.hpp"
+#include "include/engine/query/query_parser.hpp"
+#include "include/utils/Epoch.hpp"
+#include "include/utils/ThreadPool.hpp"
+#include <atomic>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+
+static int failures = 0;
+
+static void check(bool ok, const std::string& what) {
+    if (!ok) {
+        std::printf("FAIL: %s\n", what.c_str());
+        failures++;
+    }
+}
+
+static Table* make_table(const std::string& name, const char* const* columns, const char* const* types, int count) {
+    LinkedList<std::string> column_names;
+    LinkedList<std::string> column_types;
+    for (int i = 0; i < count; i++) {
+        column_names.push_back(columns[i]);
+        column_types.push_back(types[i]);
+    }
+    return new Table(name, column_names, column_types);
+}
+
+static std::string cell_text(const Cell* cell) {
+    if (cell == nullptr || cell->isNull()) return "NULL";
+    switch (cell->getType()) {
+        case CellType::INT: return std::to_string(cell->getInt());
+        case CellType::DOUBLE: return std::to_string(cell->getDouble());
+        default: return cell->getString();
+    }
+}
+
+// Sonuc "kolon1,kolon2|a,b|c,d" biciminde; sorgu basarisizsa "NULL RESULT"
+static std::string render(const Table* table) {
+    if (table == nullptr) return "NULL RESULT";
+    std::string out;
+    bool first = true;
+    for (const std::string& column : table->getColumns()) {
+        if (!first) out += ",";
+        out += column;
+        first = false;
+    }
+    for (const Row* row : table->getRows()) {
+        out += "|";
+        for (size_t i = 0; i < row->getCellCount(); i++) {
+            if (i > 0) out += ",";
+            out += cell_text(row->getCell(i));
+        }
+    }
+    return out;
+}
+
+static std::string run(Database* db, const std::string& sql) {
+    Query* query = query_parse(sql);
+    if (query == nullptr) return "PARSE ERROR";
+    Table* result = query_execute(db, query);
+    std::string out = render(result);
+    delete result;
+    delete query;
+    return out;
+}
+
+static void expect(Database* db, const std::string& sql, const std::string& expected) {
+    std::string actual = run(db, sql);
+    check(actual == expected, sql + "\n    beklenen: " + expected + "\n    gelen:    " + actual);
+}
+
+// emp(id, name, dept_id) JOIN dept(id, name): iki tarafta da id ve name var
+static void setup_emp_dept(Database* db) {
+    const char* emp_columns[] = {"id", "name", "dept_id"};
+    const char* emp_types[] = {"INT", "STRING", "INT"};
+    Table* emp = make_table("emp", emp_columns, emp_types, 3);
+    const char* emp_names[] = {"ali", "ayse", "veli", "zeynep"};
+    const int emp_depts[] = {1, 2, 2, 3};
+    for (int i = 0; i < 4; i++) {
+        Row* row = new Row(i + 1);
+        row->addCell(i + 1);
+        row->addCell(std::string(emp_names[i]));
+        row->addCell(emp_depts[i]);
+        emp->insertRow(row);
+    }
+    db->addTable(emp);
+
+    const char* dept_columns[] = {"id", "name"};
+    const char* dept_types[] = {"INT", "STRING"};
+    Table* dept = make_table("dept", dept_columns, dept_types, 2);
+    const char* dept_names[] = {"satis", "arge", "idari"};
+    for (int i = 0; i < 3; i++) {
+        Row* row = new Row(i + 1);
+        row->addCell(i + 1);
+        row->addCell(std::string(dept_names[i]));
+        dept->insertRow(row);
+    }
+    db->addTable(dept);
+}
+
+static void check_qualified_join_columns() {
+    Database db;
+    setup_emp_dept(&db);
+    const std::string join = " FROM emp JOIN dept ON emp.dept_id = dept.id";
+
+    expect(&db, "SELECT dept.id, emp.id" + join + " ORDER BY emp.id",
+           "dept.id,emp.id|1,1|2,2|2,3|3,4");
+    expect(&db, "SELECT emp.name" + join + " WHERE dept.id = 2 ORDER BY emp.name",
+           "emp.name|ayse|veli");
+    expect(&db, "SELECT emp.name, dept.name" + join + " ORDER BY dept.name DESC, emp.id",
+           "emp.name,dept.name|ali,satis|zeynep,idari|ayse,arge|veli,arge");
+    expect(&db, "SELECT dept.name, COUNT(*)" + join + " GROUP BY dept.name ORDER BY dept.name",
+           "dept.name,COUNT(*)|arge,2|idari,1|satis,1");
+    // Tekil kisa ad join sonucunda da bulunur
+    expect(&db, "SELECT dept_id" + join + " WHERE emp.id = 4", "dept_id|3");
+    // Takma adlar
+    expect(&db, "SELECT e.name FROM emp e JOIN dept d ON e.dept_id = d.id WHERE d.name = 'satis'",
+           "e.name|ali");
+    expect(&db, "SELECT d.*" + std::string(" FROM emp e JOIN dept d ON e.dept_id = d.id WHERE e.id = 3"),
+           "d.id,d.name|2,arge");
+    // Ayni tablonun iki kopyasi takma adla ayrilir
+    expect(&db, "SELECT a.name, b.name FROM emp a JOIN emp b ON a.dept_id = b.dept_id"
+                " WHERE a.id < b.id",
+           "a.name,b.name|ayse,veli");
+
+    // Belirsiz veya bilinmeyen adlar hata verir
+    expect(&db, "SELECT id" + join, "NULL RESULT");
+    expect(&db, "SELECT emp.name" + join + " WHERE name = 'ali'", "NULL RESULT");
+    expect(&db, "SELECT emp.name" + join + " ORDER BY id", "NULL RESULT");
+    expect(&db, "SELECT proj.id" + join, "PARSE ERROR");
+    expect(&db, "SELECT id FROM emp JOIN emp ON emp.id = emp.dept_id", "PARSE ERROR");
+
+    // Tek tabloda nitelik dusurulur
+    expect(&db, "SELECT emp.name FROM emp WHERE emp.id = 2", "name|ayse");
+}
+
+// Ayni sorgunun sonuc tablosunun adi: SELECT * join sonucunu projeksiyonsuz
+// dondurur, adi join_engine'in sectigi yolu gosterir
+static std::string result_name(Database* db, const std::string& sql) {
+    Query* query = query_parse(sql);
+    if (query == nullptr) return "PARSE ERROR";
+    Table* result = query_execute(db, query);
+    std::string name = result ? result->getName() : "NULL RESULT";
+    delete result;
+    delete query;
+    return name;
+}
+
+// Indeksli planlar katalog tablosunda calismali: snapshot gorunumunun
+// indeksi yoktur, orada hepsi hash join / tam taramaya duserdi
+static void check_index_plans() {
+    Database db;
+    const char* columns[] = {"id", "v"};
+    const char* types[] = {"INT", "INT"};
+    Table* a = make_table("a", columns, types, 2);
+    Table* b = make_table("b", columns, types, 2);
+    for (int i = 1; i <= 300; i++) {
+        Row* left = new Row(i);
+        left->addCell(i);
+        left->addCell(i % 7);
+        a->insertVersioned(left);
+        Row* right = new Row(i);
+        right->addCell(i);
+        right->addCell(i % 5);
+        b->insertVersioned(right);
+    }
+    db.addTable(a);
+    db.addTable(b);
+
+    check(result_name(&db, "SELECT * FROM a JOIN b ON a.id = b.id") == "join_result_merge",
+          "iki taraf da id'de birlesirken sort-merge join secilmeli");
+    check(result_name(&db, "SELECT * FROM a JOIN b ON a.v = b.id") == "join_result_index_nl",
+          "sag taraf id'de birlesirken indeksli nested loop secilmeli");
+    check(result_name(&db, "SELECT * FROM a JOIN b ON a.v = b.v") == "join_result_hash",
+          "indekssiz kolonlarda hash join secilmeli");
+    expect(&db, "SELECT COUNT(*) FROM a JOIN b ON a.v = b.id", "COUNT(*)|258");
+
+    // Anahtar sirali ORDER BY (LIMIT'siz) ve GROUP BY
+    expect(&db, "SELECT id FROM a WHERE v = 0 ORDER BY id DESC LIMIT 3", "id|294|287|280");
+    std::string ordered = run(&db, "SELECT id FROM a ORDER BY id DESC");
+    check(ordered.compare(0, 15, "id|300|299|298|") == 0 && ordered.size() > 1000,
+          "ORDER BY id DESC: " + ordered.substr(0, 40));
+    expect(&db, "SELECT id, COUNT(*) FROM a WHERE id < 4 GROUP BY id", "id,COUNT(*)|1,1|2,1|3,1");
+}
+
+// /insert'in yolu: silinen satirdan sonra eklenen satir yeni id alir,
+// tekrar eden id reddedilir; id indeksi hic kapanmaz
+static void check_row_ids() {
+    Database db;
+    setup_emp_dept(&db);
+    Table* emp = db.getTable("emp");
+
+    check(emp->removeVersioned(2), "emp id 2 silinmeli");
+    int id = emp->nextRowId();
+    check(id == 5, "silmeden sonra yeni id 5 olmali, gelen " + std::to_string(id));
+    Row* row = new Row(id);
+    row->addCell(id);
+    row->addCell(std::string("ece"));
+    row->addCell(1);
+    check(emp->insertVersioned(row), "yeni id'li satir eklenmeli");
+
+    Row* duplicate = new Row(3);
+    duplicate->addCell(3);
+    duplicate->addCell(std::string("tekrar"));
+    duplicate->addCell(1);
+    check(!emp->insertVersioned(duplicate), "tekrar eden id reddedilmeli");
+    delete duplicate;
+
+    Row* mismatched = new Row(6);
+    mismatched->addCell(7);
+    mismatched->addCell(std::string("uyumsuz"));
+    mismatched->addCell(1);
+    check(!emp->insertVersioned(mismatched), "id kolonu satir id'sinden farkli satir reddedilmeli");
+    delete mismatched;
+
+    check(emp->getKeyColumnIndex() == 0, "id indeksi acik kalmali");
+    expect(&db, "SELECT name FROM emp WHERE id = 3", "name|veli");
+    expect(&db, "SELECT name FROM emp WHERE id = 5", "name|ece");
+    check(emp->removeVersioned(3), "emp id 3 silinmeli");
+    expect(&db, "SELECT id, name FROM emp ORDER BY id", "id,name|1,ali|4,zeynep|5,ece");
+}
+
+// LIMIT/OFFSET int'e sigmali; tasan deger eskiden atoi ile negatife donup
+// butun satirlari donduruyordu
+static void check_limit_values() {
+    Database db;
+    setup_emp_dept(&db);
+    expect(&db, "SELECT id FROM emp LIMIT 2 OFFSET 1", "id|2|3");
+    expect(&db, "SELECT id FROM emp LIMIT 0", "id");
+    expect(&db, "SELECT id FROM emp LIMIT 2147483647 OFFSET 3", "id|4");
+    expect(&db, "SELECT id FROM emp LIMIT 2147483648", "PARSE ERROR");
+    expect(&db, "SELECT id FROM emp LIMIT 99999999999999999999", "PARSE ERROR");
+    expect(&db, "SELECT id FROM emp LIMIT 1 OFFSET 4294967297", "PARSE ERROR");
+    expect(&db, "SELECT id FROM emp LIMIT -1", "PARSE ERROR");
+}
+
+// Istatistik onbellegi: ikinci cagri onbellekten gelir, katalogdan dusen
+// tablonun girdisi silinir
+static void check_stats_cache() {
+    Database db;
+    setup_emp_dept(&db);
+    Table* emp = db.getTable("emp");
+    std::shared_ptr<const TableStats> first = table_stats_get(emp);
+    check(table_stats_get(emp) == first, "degismeyen tablonun istatistigi onbellekten gelmeli");
+    check(first->row_count == 4, "emp 4 satir olmali");
+
+    table_stats_forget(emp);
+    check(table_stats_get(emp) != first, "forget'tan sonra istatistik yeniden toplanmali");
+
+    std::shared_ptr<const TableStats> cached = table_stats_get(emp);
+    const char* columns[] = {"id", "name", "dept_id"};
+    const char* types[] = {"INT", "STRING", "INT"};
+    db.replaceTable(make_table("emp", columns, types, 3));
+    check(table_stats_get(db.getTable("emp"))->row_count == 0, "yeni emp bos olmali");
+    check(cached.use_count() == 1, "degistirilen tablonun girdisi onbellekten silinmeli");
+
+    cached = table_stats_get(db.getTable("dept"));
+    check(db.dropTable("dept"), "dept silinmeli");
+    check(cached.use_count() == 1, "silinen tablonun girdisi onbellekten silinmeli");
+}
+
+// Task'ta atilan istisna worker'i sonlandirmamali: cagiran yardimcilari
+// bekler, ilk istisnayi alir ve havuz sonraki islerde kullanilabilir kalir
+static void check_pool_exceptions() {
+    ThreadPool pool(4);
+    std::atomic<int> ran(0);
+    bool caught = false;
+    try {
+        pool.parallelFor(64, [&ran](size_t i) {
+            ran++;
+            if (i == 5) throw std::runtime_error("parallelFor");
+        });
+    } catch (const std::runtime_error& e) {
+        caught = std::string(e.what()) == "parallelFor";
+    }
+    check(caught, "parallelFor istisnayi cagirana atmali");
+    check(ran.load() <= 64, "parallelFor en fazla 64 kez calismali");
+
+    caught = false;
+    try {
+        pool.parallelMorsels(1000, 10, [](size_t morsel, size_t, size_t) {
+            if (morsel % 30 == 7) throw std::runtime_error("morsel");
+        });
+    } catch (const std::runtime_error& e) {
+        caught = std::string(e.what()) == "morsel";
+    }
+    check(caught, "parallelMorsels istisnayi cagirana atmali");
+
+    std::atomic<size_t> sum(0);
+    pool.parallelMorsels(1000, 10, [&sum](size_t, size_t begin, size_t end) { sum += end - begin; });
+    check(sum.load() == 1000, "istisnadan sonra havuz calismaya devam etmeli");
+}
+
+int main() {
+    check_qualified_join_columns();
+    check_index_plans();
+    check_row_ids();
+    check_limit_values();
+    check_stats_cache();
+    check_pool_exceptions();
+    // Indeks buyurken birakilan kova dizileri epoch ile serbest kalir
+    Epoch::collect();
+    std::printf("%s\n", failures == 0 ? "OK" : "FAILED");
+    return failures == 0 ? 0 : 1;
+}
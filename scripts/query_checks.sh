@@ -0,0 +1,38 @@
+#!/bin/sh
+# query_checks.cpp'yi sanitizer'siz ve ASAN ile derleyip calistirir.
+#
+#   scripts/query_checks.sh [plain|asan ...]
+#
+# Derleme ciktilari build/checks/ altina yazilir. Bir varyant hata verirse
+# cikis kodu 1 olur.
+
+set -u
+cd "$(dirname "$0")/.." || exit 1
+
+VARIANTS=${*:-"plain asan"}
+
+CXX=${CXX:-g++}
+OUT=build/checks
+mkdir -p "$OUT"
+SOURCES=$(find src -name '*.cpp')
+
+status=0
+for variant in $VARIANTS; do
+    case $variant in
+        plain) flags="-O2" ;;
+        asan) flags="-O1 -g -fsanitize=address,undefined -fno-omit-frame-pointer" ;;
+        *) echo "Bilinmeyen varyant: $variant" >&2; exit 2 ;;
+    esac
+
+    echo "== $variant"
+    # shellcheck disable=SC2086
+    if ! $CXX -std=c++17 $flags -pthread -I. -Iinclude -o "$OUT/query_checks_$variant" \
+        scripts/query_checks.cpp $SOURCES; then
+        status=1
+        continue
+    fi
+    if ! "$OUT/query_checks_$variant"; then
+        status=1
+    fi
+done
+exit $status
@@ -1,20 +1,37 @@
 #include "../../include/core/Cell.hpp"
+#include <functional>
+
+Cell::Cell() {
+    this->type = CellType::NULL_VALUE;
+    this->code = 0;
+    this->doubleValue = 0.0;
+}
 
 Cell::Cell(int value) {
     this->type = CellType::INT;
+    this->code = 0;
     this->intValue = value;
 }
 
 Cell::Cell(double value) {
     this->type = CellType::DOUBLE;
+    this->code = 0;
     this->doubleValue = value;
 }
 
 Cell::Cell(std::string value) {
     this->type = CellType::STRING;
+    this->code = 0;
+    this->dictionary = nullptr;
     this->stringValue = value;
 }
 
+Cell::Cell(const StringDictionary* dictionary, uint32_t code) {
+    this->type = CellType::STRING;
+    this->code = code;
+    this->dictionary = dictionary;
+}
+
 CellType Cell::getType() const {
     return this->type;
 }
@@ -29,7 +46,26 @@ double Cell::getDouble() const {
     return this->doubleValue;
 }
 
-std::string Cell::getString() const {
+const std::string& Cell::getString() const {
     if (this->type != CellType::STRING) throw std::runtime_error("Type mismatch: Not STRING");
-    return this->stringValue;
-}
\ No newline at end of file
+    return this->dictionary ? this->dictionary->value(this->code) : this->stringValue;
+}
+
+size_t Cell::getStringHash() const {
+    if (this->type != CellType::STRING) throw std::runtime_error("Type mismatch: Not STRING");
+    return this->dictionary ? this->dictionary->hash(this->code) : std::hash<std::string>{}(this->stringValue);
+}
+
+void Cell::encode(const StringDictionary* dictionary, uint32_t code) {
+    if (this->type != CellType::STRING) return;
+    this->dictionary = dictionary;
+    this->code = code;
+    std::string().swap(this->stringValue);
+}
+
+void Cell::decode() {
+    if (!isEncoded()) return;
+    this->stringValue = this->dictionary->value(this->code);
+    this->dictionary = nullptr;
+    this->code = 0;
+}
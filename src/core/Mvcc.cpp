@@ -0,0 +1,43 @@
+#include "../../include/core/Mvcc.hpp"
+#include <atomic>
+#include <map>
+#include <mutex>
+
+static std::atomic<uint64_t> clockVersion(1);
+
+// versiyon -> o versiyondaki aktif snapshot sayisi
+static std::mutex registryMutex;
+static std::map<uint64_t, size_t> activeVersions;
+static size_t activeCount = 0;
+
+uint64_t Mvcc::currentVersion() {
+    return clockVersion.load(std::memory_order_acquire);
+}
+
+uint64_t Mvcc::nextVersion() {
+    return clockVersion.fetch_add(1, std::memory_order_acq_rel) + 1;
+}
+
+uint64_t Mvcc::oldestSnapshot() {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    return activeVersions.empty() ? UINT64_MAX : activeVersions.begin()->first;
+}
+
+size_t Mvcc::activeSnapshots() {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    return activeCount;
+}
+
+Snapshot::Snapshot() {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    version = Mvcc::currentVersion();
+    activeVersions[version]++;
+    activeCount++;
+}
+
+Snapshot::~Snapshot() {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    auto found = activeVersions.find(version);
+    if (--found->second == 0) activeVersions.erase(found);
+    activeCount--;
+}
@@ -1,6 +1,6 @@
 #include "../../include/core/Row.hpp"
 
-Row::Row(int rowId) {
+Row::Row(int rowId) : beginVersion(0), endVersion(UINT64_MAX) {
     this->id = rowId;
 }
 
@@ -12,27 +12,39 @@ Row::~Row() {
 }
 
 void Row::addCell(int value) {
-    cells.push_back(new Cell(value));
+    appendCell(new Cell(value));
 }
 
 void Row::addCell(double value) {
-    cells.push_back(new Cell(value));
+    appendCell(new Cell(value));
 }
 
 void Row::addCell(std::string value) {
-    cells.push_back(new Cell(value));
+    appendCell(new Cell(value));
 }
 
-Cell* Row::getCell(size_t index) {
-    
-    size_t counter = 0;
-    for (auto cell : cells) {
-        if (counter == index) {
-            return cell;
-        }
-        counter++;
+void Row::addNull() {
+    appendCell(new Cell());
+}
+
+void Row::appendCell(Cell* cell) {
+    cells.push_back(cell);
+    cellIndex.push_back(cell);
+}
+
+void Row::addCopy(const Cell* cell) {
+    if (cell->getType() == CellType::INT) addCell(cell->getInt());
+    else if (cell->getType() == CellType::DOUBLE) addCell(cell->getDouble());
+    else if (cell->isEncoded()) appendCell(new Cell(cell->getDictionary(), cell->getCode()));
+    else if (cell->getType() == CellType::STRING) addCell(cell->getString());
+    else addNull();
+}
+
+Cell* Row::getCell(size_t index) const {
+    if (index >= cellIndex.size()) {
+        throw std::out_of_range("Row::getCell - Index out of bounds");
     }
-    throw std::out_of_range("Row::getCell - Index out of bounds");
+    return cellIndex[index];
 }
 
 int Row::getId() const {
@@ -0,0 +1,71 @@
+#include "../../include/core/StringDictionary.hpp"
+#include <functional>
+
+// Bu kadar deger gorulmeden kardinaliteye bakilmaz
+static const size_t FREEZE_MIN_SEEN = 8192;
+
+static size_t chunk_of(uint32_t code, size_t& offset) {
+    // code + 16 = 2^(k+4) + offset
+    uint32_t shifted = code + 16;
+    size_t top = 31 - __builtin_clz(shifted);
+    offset = shifted - (static_cast<uint32_t>(1) << top);
+    return top - 4;
+}
+
+StringDictionary::StringDictionary() : count(0), frozen(false), seen(0), references(1) {
+    for (size_t i = 0; i < CHUNK_COUNT; i++) chunks[i].store(nullptr, std::memory_order_relaxed);
+}
+
+StringDictionary::~StringDictionary() {
+    for (size_t i = 0; i < CHUNK_COUNT; i++) delete[] chunks[i].load(std::memory_order_relaxed);
+}
+
+const StringDictionary::Entry& StringDictionary::entry(uint32_t code) const {
+    size_t offset;
+    size_t chunk = chunk_of(code, offset);
+    return chunks[chunk].load(std::memory_order_acquire)[offset];
+}
+
+uint32_t StringDictionary::encode(const std::string& value) {
+    seen++;
+    uint32_t found = find(value);
+    if (found != NOT_FOUND || isFrozen()) return found;
+
+    // Degerlerin yarisindan fazlasi farkliysa kod metinden az yer kazandirmaz
+    uint32_t code = count.load(std::memory_order_relaxed);
+    if (code >= MAX_CODES || (seen >= FREEZE_MIN_SEEN && static_cast<size_t>(code) * 2 > seen)) {
+        frozen.store(true, std::memory_order_relaxed);
+        return NOT_FOUND;
+    }
+
+    size_t offset;
+    size_t chunk = chunk_of(code, offset);
+    Entry* entries = chunks[chunk].load(std::memory_order_relaxed);
+    if (!entries) {
+        entries = new Entry[static_cast<size_t>(16) << chunk];
+        chunks[chunk].store(entries, std::memory_order_release);
+    }
+    entries[offset].value = value;
+    entries[offset].hash = std::hash<std::string>{}(value);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        codes.insert(value, code);
+    }
+    count.store(code + 1, std::memory_order_release);
+    return code;
+}
+
+uint32_t StringDictionary::find(const std::string& value) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    const uint32_t* code = codes.find(value);
+    return code ? *code : NOT_FOUND;
+}
+
+void StringDictionary::retain() const {
+    references.fetch_add(1, std::memory_order_relaxed);
+}
+
+void StringDictionary::release() const {
+    if (references.fetch_sub(1, std::memory_order_acq_rel) == 1) delete this;
+}
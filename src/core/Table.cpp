@@ -1,30 +1,138 @@
 #include "../../include/core/Table.hpp"
+#include "../../include/core/Mvcc.hpp"
+#include "../../include/utils/Epoch.hpp"
 #include <iomanip> // std::setw için
+#include <atomic>
+#include <climits>
+
+static std::atomic<uint64_t> nextTableId(1);
 
 Table::Table(const std::string& tableName, const LinkedList<std::string>& colNames, const LinkedList<std::string>& colTypes)
     : primaryIndex(16) {
     this->name = tableName;
     
-    this->bTreeIndex = new idx::BPlusTree(4);
+    this->bTreeIndex = new idx::ConcurrentBPlusTree();
 
-    for(const auto& col : colNames) this->columns.push_back(col);
+    for(const auto& col : colNames) {
+        if (!this->columnIndex.contains(col)) this->columnIndex.insert(col, static_cast<int>(this->columns.size()));
+        this->columns.push_back(col);
+    }
     for(const auto& type : colTypes) this->types.push_back(type);
+
+    this->tableId = nextTableId++;
+    this->modificationCount = 0;
+    this->ownsRows = true;
+
+    this->keyColumn = -1;
+    this->keyColumnValid = true;
+    this->lastRowId = 0;
+    this->encodesStrings = false;
+    int idx = 0;
+    auto typeIt = this->types.begin();
+    for (size_t i = 0; i < this->columns.size() && typeIt != this->types.end(); i++, ++typeIt) {
+        if (*typeIt == "STRING") this->dictionaries.push_back({static_cast<int>(i), nullptr, nullptr, true});
+    }
+    typeIt = this->types.begin();
+    for (const auto& col : this->columns) {
+        if (typeIt == this->types.end()) break;
+        if ((col == "id" || col == "ID" || col == "Id") && *typeIt == "INT") {
+            this->keyColumn = idx;
+            break;
+        }
+        idx++;
+        ++typeIt;
+    }
 }
 
 Table::~Table() {
-    for (auto row : rows) {
-        delete row;
+    if (ownsRows) {
+        for (auto row : rows) {
+            delete row;
+        }
     }
+    for (auto row : retiredRows) delete row;
     delete bTreeIndex;
+    for (auto& column : dictionaries) {
+        if (column.dictionary) column.dictionary->release();
+    }
+    for (auto dictionary : otherDictionaries) dictionary->release();
+}
+
+void Table::enableDictionaryEncoding() {
+    if (encodesStrings) return;
+    encodesStrings = true;
+    for (auto& column : dictionaries) {
+        if (column.dictionary) otherDictionaries.push_back(column.dictionary);
+        column.encoder = new StringDictionary();
+        column.dictionary = column.encoder;
+        column.canonical = true;
+    }
+    for (Row* row : rows) encodeStrings(row);
+}
+
+void Table::encodeStrings(Row* row) {
+    for (auto& column : dictionaries) {
+        if (static_cast<size_t>(column.column) >= row->getCellCount()) continue;
+        Cell* cell = row->getCell(column.column);
+        if (cell->getType() != CellType::STRING) continue;
+        const StringDictionary* dictionary = cell->getDictionary();
+        if (dictionary && dictionary == column.dictionary) continue;
+
+        if (encodesStrings) {
+            // Baska sozlugun hucresi de kendi sozlugune gecer; o sozluk
+            // bu tablodan once silinebilir
+            uint32_t code = column.encoder->encode(cell->getString());
+            if (code != StringDictionary::NOT_FOUND) cell->encode(column.encoder, code);
+            else cell->decode();
+            continue;
+        }
+
+        if (!dictionary) {
+            column.canonical = false;
+        } else if (!column.dictionary) {
+            column.dictionary = dictionary;
+            dictionary->retain();
+        } else {
+            column.canonical = false;
+            bool held = false;
+            for (auto other : otherDictionaries) held = held || other == dictionary;
+            if (!held) {
+                otherDictionaries.push_back(dictionary);
+                dictionary->retain();
+            }
+        }
+    }
+}
+
+void Table::shareDictionaries(Table* view) const {
+    view->dictionaries = dictionaries;
+    for (auto& column : view->dictionaries) {
+        // Gorunume satir eklenmez; kodlayici sadece sahibinde
+        column.encoder = nullptr;
+        if (column.dictionary) column.dictionary->retain();
+    }
+    view->otherDictionaries = otherDictionaries;
+    for (auto dictionary : view->otherDictionaries) dictionary->retain();
 }
 
 void Table::insertRow(Row* row) {
+    if (keyColumn >= 0 && keyColumnValid) {
+        Cell* keyCell = (static_cast<size_t>(keyColumn) < row->getCellCount()) ? row->getCell(keyColumn) : nullptr;
+        if (!keyCell || keyCell->getType() != CellType::INT || keyCell->getInt() != row->getId() ||
+            primaryIndex.search(row->getId()) != nullptr) {
+            keyColumnValid = false;
+        }
+    }
+
+    if (!dictionaries.empty()) encodeStrings(row);
+
     rows.push_back(row);
+    modificationCount++;
+    if (row->getId() > lastRowId) lastRowId = row->getId();
 
     primaryIndex.insert(row->getId(), row);
 
-    idx::RecordID record(0,0,row);
-    bTreeIndex->insert(row->getId(), record);
+    bTreeIndex->insert(row->getId(), row);
 }
 
 Row* Table::getRowById(int id) { return primaryIndex.search(id);}
@@ -37,6 +145,7 @@ void Table::removeRow(int id) {
         primaryIndex.remove(id);
 
         rows.remove(rowToDelete); 
+        modificationCount++;
 
         bTreeIndex->remove(id);
 
@@ -48,6 +157,113 @@ void Table::removeRow(int id) {
     }
 }
 
+bool Table::canInsert(const Row* row) const {
+    if (primaryIndex.search(row->getId()) != nullptr) {
+        std::cerr << "Hata: ID " << row->getId() << " tabloda zaten var (" << name << ")" << std::endl;
+        return false;
+    }
+    if (keyColumn >= 0 && keyColumnValid) {
+        Cell* keyCell = (static_cast<size_t>(keyColumn) < row->getCellCount()) ? row->getCell(keyColumn) : nullptr;
+        if (!keyCell || keyCell->getType() != CellType::INT || keyCell->getInt() != row->getId()) {
+            std::cerr << "Hata: id kolonu satir id'si (" << row->getId() << ") ile ayni olmali (" << name << ")"
+                      << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Table::insertVersioned(Row* row) {
+    if (!canInsert(row)) return false;
+    row->setBeginVersion(Mvcc::nextVersion());
+    insertRow(row);
+    return true;
+}
+
+int Table::nextRowId() const {
+    return lastRowId < INT_MAX ? lastRowId + 1 : INT_MAX;
+}
+
+bool Table::removeVersioned(int id) {
+    Row* row = primaryIndex.search(id);
+    if (row == nullptr) {
+        std::cout << "HATA: Silinecek ID (" << id << ") bulunamadi." << std::endl;
+        return false;
+    }
+
+    primaryIndex.remove(id);
+    rows.remove(row);
+    bTreeIndex->remove(id);
+    modificationCount++;
+
+    row->setEndVersion(Mvcc::nextVersion());
+    retiredRows.push_back(row);
+    std::cout << "ID: " << id << " silindi." << std::endl;
+    return true;
+}
+
+static void delete_row(void* row) {
+    delete static_cast<Row*>(row);
+}
+
+size_t Table::collectGarbage(uint64_t oldestSnapshot) {
+    size_t kept = 0;
+    size_t freed = 0;
+    for (Row* row : retiredRows) {
+        if (row->getEndVersion() <= oldestSnapshot) {
+            // pointView okuyuculari satiri hala tutuyor olabilir
+            Epoch::retire(row, delete_row);
+            freed++;
+        } else {
+            retiredRows[kept++] = row;
+        }
+    }
+    retiredRows.resize(kept);
+    return freed;
+}
+
+Table* Table::snapshotView() const {
+    Table* view = new Table(name, columns, types);
+    view->ownsRows = false;
+    view->keyColumnValid = false;
+    shareDictionaries(view);
+    for (Row* row : rows) view->rows.push_back(row);
+    return view;
+}
+
+Table* Table::pointView(int key) const {
+    Table* view = new Table(name, columns, types);
+    view->ownsRows = false;
+    view->keyColumnValid = false;
+    shareDictionaries(view);
+    Row* row = primaryIndex.search(key);
+    if (row) view->rows.push_back(row);
+    return view;
+}
+
+int Table::getKeyColumnIndex() const {
+    return keyColumnValid ? keyColumn : -1;
+}
+
+int Table::getColumnIndex(const std::string& columnName) const {
+    const int* found = columnIndex.find(columnName);
+    return found ? *found : -1;
+}
+
+const StringDictionary* Table::getDictionary(int column) const {
+    for (const auto& entry : dictionaries) {
+        if (entry.column == column) return entry.dictionary;
+    }
+    return nullptr;
+}
+
+const StringDictionary* Table::getCanonicalDictionary(int column) const {
+    for (const auto& entry : dictionaries) {
+        if (entry.column == column) return entry.canonical ? entry.dictionary : nullptr;
+    }
+    return nullptr;
+}
+
 size_t Table::getRowCount() const {
     return rows.size();
 }
@@ -68,7 +284,7 @@ void Table::print() const {
     
     for (const auto& row : rows) {
         
-        LinkedList<Cell*>& cells = row->getCells();
+        const LinkedList<Cell*>& cells = row->getCells();
         for (auto cell : cells) {
             if (cell->getType() == CellType::INT) {
                 std::cout << std::left << std::setw(15) << cell->getInt();
@@ -76,6 +292,8 @@ void Table::print() const {
                 std::cout << std::left << std::setw(15) << cell->getDouble();
             } else if (cell->getType() == CellType::STRING) {
                 std::cout << std::left << std::setw(15) << cell->getString();
+            } else {
+                std::cout << std::left << std::setw(15) << "NULL";
             }
         }
         std::cout << std::endl;
@@ -0,0 +1,297 @@
+#include "../../../include/engine/query/aggregate_engine.hpp"
+#include "../../../include/engine/query/query_binder.hpp"
+#include "../../../include/engine/query/sort_engine.hpp"
+#include <climits>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct AggregateSpec {
+    AggregateFunction function;
+    int column;  // COUNT(*) icin -1
+};
+
+// Grup basina, toplama basina durum
+struct AggregateState {
+    long long count;
+    double sum;
+    long long int_sum;
+    bool all_int;        // SUM'a sadece INT hucreler girdi (int_sum tam deger)
+    const Cell* extreme; // MIN/MAX: kaynak tablodaki hucre
+};
+
+static Cell* cell_at(Row* row, int column) {
+    return static_cast<size_t>(column) < row->getCellCount() ? row->getCell(column) : nullptr;
+}
+
+static std::string type_at(Table* table, int index) {
+    int i = 0;
+    for (const auto& type : table->getTypes()) {
+        if (i++ == index) return type;
+    }
+    return "STRING";
+}
+
+static void accumulate(AggregateState& state, const AggregateSpec& spec, Row* row) {
+    if (spec.column < 0) {
+        state.count++;
+        return;
+    }
+    Cell* cell = cell_at(row, spec.column);
+    if (!cell || cell->isNull()) return;
+
+    switch (spec.function) {
+        case AggregateFunction::COUNT:
+            state.count++;
+            break;
+        case AggregateFunction::SUM:
+        case AggregateFunction::AVG:
+            if (cell->getType() == CellType::INT) {
+                state.int_sum += cell->getInt();
+                state.sum += cell->getInt();
+            } else if (cell->getType() == CellType::DOUBLE) {
+                state.all_int = false;
+                state.sum += cell->getDouble();
+            } else {
+                return;
+            }
+            state.count++;
+            break;
+        case AggregateFunction::MIN:
+            if (!state.extreme || sort_compare_cells(cell, state.extreme) < 0) state.extreme = cell;
+            break;
+        case AggregateFunction::MAX:
+            if (!state.extreme || sort_compare_cells(cell, state.extreme) > 0) state.extreme = cell;
+            break;
+    }
+}
+
+// COUNT sonucu INT'e sigmiyorsa (SUM gibi) DOUBLE hucre olur; kesilmez
+static Cell* count_cell(long long count) {
+    if (count <= INT_MAX) return new Cell(static_cast<int>(count));
+    return new Cell(static_cast<double>(count));
+}
+
+static Cell* finish(const AggregateState& state, const AggregateSpec& spec) {
+    switch (spec.function) {
+        case AggregateFunction::COUNT:
+            return count_cell(state.count);
+        case AggregateFunction::SUM:
+            if (state.count == 0) return new Cell();
+            if (state.all_int && state.int_sum >= INT_MIN && state.int_sum <= INT_MAX) {
+                return new Cell(static_cast<int>(state.int_sum));
+            }
+            return new Cell(state.all_int ? static_cast<double>(state.int_sum) : state.sum);
+        case AggregateFunction::AVG:
+            if (state.count == 0) return new Cell();
+            return new Cell((state.all_int ? static_cast<double>(state.int_sum) : state.sum) /
+                            static_cast<double>(state.count));
+        case AggregateFunction::MIN:
+        case AggregateFunction::MAX:
+            if (!state.extreme) return new Cell();
+            if (state.extreme->getType() == CellType::INT) return new Cell(state.extreme->getInt());
+            if (state.extreme->getType() == CellType::DOUBLE) return new Cell(state.extreme->getDouble());
+            if (state.extreme->isEncoded()) return new Cell(state.extreme->getDictionary(), state.extreme->getCode());
+            return new Cell(state.extreme->getString());
+    }
+    return new Cell();
+}
+
+static std::string result_type(Table* schema, const AggregateSpec& spec) {
+    switch (spec.function) {
+        case AggregateFunction::COUNT: return "INT";
+        case AggregateFunction::SUM: return type_at(schema, spec.column) == "INT" ? "INT" : "DOUBLE";
+        case AggregateFunction::AVG: return "DOUBLE";
+        default: return type_at(schema, spec.column);
+    }
+}
+
+// Tipli grup anahtari: her kolon icin etiket + deger. Sayilar double olarak
+// yazilir (5 ile 5.0 ayni grup, siralamadaki esitlikle ayni); NULL'lar tek grup.
+// dictionaries[i], kolonun canonical sozlugudur (yoksa nullptr): o sozlukle
+// kodlu metin yerine kodu yazilir. Canonical kolonda sozlukteki bir deger
+// duz metin olarak bulunmaz, kod ve metin anahtarlari ayni grubu bolmez.
+static void encode_key(Row* row, const std::vector<int>& columns,
+                       const std::vector<const StringDictionary*>& dictionaries, std::string& out) {
+    out.clear();
+    for (size_t i = 0; i < columns.size(); i++) {
+        Cell* cell = cell_at(row, columns[i]);
+        if (!cell || cell->isNull()) {
+            out.push_back('N');
+        } else if (dictionaries[i] && cell->getDictionary() == dictionaries[i]) {
+            uint32_t code = cell->getCode();
+            out.push_back('C');
+            out.append(reinterpret_cast<const char*>(&code), sizeof(code));
+        } else if (cell->getType() == CellType::STRING) {
+            const std::string& text = cell->getString();
+            uint64_t length = text.size();
+            out.push_back('S');
+            out.append(reinterpret_cast<const char*>(&length), sizeof(length));
+            out.append(text);
+        } else {
+            double number = cell->getType() == CellType::INT ? cell->getInt() : cell->getDouble();
+            if (number == 0) number = 0;  // -0.0 ile 0.0 ayni grup
+            out.push_back('D');
+            out.append(reinterpret_cast<const char*>(&number), sizeof(number));
+        }
+    }
+}
+
+// Tek canonical STRING kolonlu GROUP BY: kod dogrudan dizi indeksi
+static bool code_key(Row* row, int column, const StringDictionary* dictionary, uint32_t& code) {
+    Cell* cell = cell_at(row, column);
+    if (!cell || cell->getDictionary() != dictionary) return false;
+    code = cell->getCode();
+    return true;
+}
+
+// Tek INT kolonlu GROUP BY icin dogrudan int anahtar
+static bool int_key(Row* row, int column, int& key) {
+    Cell* cell = cell_at(row, column);
+    if (!cell || cell->isNull()) return false;
+    if (cell->getType() == CellType::INT) {
+        key = cell->getInt();
+        return true;
+    }
+    if (cell->getType() == CellType::DOUBLE) {
+        double d = cell->getDouble();
+        if (d < INT_MIN || d > INT_MAX || d != static_cast<double>(static_cast<int>(d))) return false;
+        key = static_cast<int>(d);
+        return true;
+    }
+    return false;
+}
+
+static bool same_group(Row* a, Row* b, const std::vector<int>& columns) {
+    for (int column : columns) {
+        if (sort_compare_cells(cell_at(a, column), cell_at(b, column)) != 0) return false;
+    }
+    return true;
+}
+
+Table* aggregate_rows(Table* schema, const std::vector<Row*>& rows, const CompiledPredicate* filter,
+                      const LinkedList<std::string>& group_by, const LinkedList<SelectAggregate>& aggregates,
+                      bool ordered) {
+    if (!schema) return nullptr;
+
+    LinkedList<std::string> columns;
+    LinkedList<std::string> types;
+    std::vector<int> group_columns;
+    for (const auto& name : group_by) {
+        int column = query_bind_column(schema, name);
+        if (column < 0) {
+            std::cerr << "Hata: GROUP BY kolonu bulunamadi: " << name << std::endl;
+            return nullptr;
+        }
+        group_columns.push_back(column);
+        columns.push_back(name);
+        types.push_back(type_at(schema, column));
+    }
+
+    std::vector<AggregateSpec> specs;
+    for (const auto& aggregate : aggregates) {
+        AggregateSpec spec;
+        spec.function = aggregate.function;
+        spec.column = -1;
+        if (!aggregate.column_name.empty()) {
+            spec.column = query_bind_column(schema, aggregate.column_name);
+            if (spec.column < 0) {
+                std::cerr << "Hata: Toplama kolonu bulunamadi: " << aggregate.column_name << std::endl;
+                return nullptr;
+            }
+        }
+        specs.push_back(spec);
+        columns.push_back(aggregate.output_name);
+        types.push_back(spec.column < 0 ? "INT" : result_type(schema, spec));
+    }
+
+    // Gruplarin durumlari tek dizide: grup g'nin toplamalari [g * n, g * n + n)
+    std::vector<Row*> group_rows;
+    std::vector<AggregateState> states;
+    AggregateState initial = {0, 0, 0, true, nullptr};
+    auto new_group = [&](Row* row) -> size_t {
+        group_rows.push_back(row);
+        states.insert(states.end(), specs.size(), initial);
+        return group_rows.size() - 1;
+    };
+    auto add = [&](size_t group, Row* row) {
+        AggregateState* state = states.data() + group * specs.size();
+        for (size_t i = 0; i < specs.size(); i++) accumulate(state[i], specs[i], row);
+    };
+
+    if (group_columns.empty()) {
+        new_group(nullptr);
+        for (Row* row : rows) {
+            if (filter && !filter->matches(row)) continue;
+            add(0, row);
+        }
+    } else if (ordered) {
+        for (Row* row : rows) {
+            if (filter && !filter->matches(row)) continue;
+            if (group_rows.empty() || !same_group(group_rows.back(), row, group_columns)) new_group(row);
+            add(group_rows.size() - 1, row);
+        }
+    } else {
+        bool single_int = group_columns.size() == 1 && type_at(schema, group_columns[0]) == "INT";
+        std::vector<const StringDictionary*> dictionaries;
+        for (int column : group_columns) dictionaries.push_back(schema->getCanonicalDictionary(column));
+        const StringDictionary* single_code = group_columns.size() == 1 ? dictionaries[0] : nullptr;
+        std::unordered_map<int, size_t> int_groups;
+        std::vector<size_t> code_groups;  // kod -> grup + 1 (0: henuz yok)
+        std::unordered_map<std::string, size_t> groups;
+        std::string key;
+        for (Row* row : rows) {
+            if (filter && !filter->matches(row)) continue;
+            size_t group;
+            int number;
+            uint32_t code;
+            if (single_int && int_key(row, group_columns[0], number)) {
+                auto found = int_groups.find(number);
+                group = found != int_groups.end() ? found->second : (int_groups[number] = new_group(row));
+            } else if (single_code && code_key(row, group_columns[0], single_code, code)) {
+                if (code >= code_groups.size()) code_groups.resize(code + 1, 0);
+                if (code_groups[code] == 0) code_groups[code] = new_group(row) + 1;
+                group = code_groups[code] - 1;
+            } else {
+                encode_key(row, group_columns, dictionaries, key);
+                auto found = groups.find(key);
+                group = found != groups.end() ? found->second : (groups[key] = new_group(row));
+            }
+            add(group, row);
+        }
+    }
+
+    Table* result = new Table(schema->getName() + "_grouped", columns, types);
+    for (size_t g = 0; g < group_rows.size(); g++) {
+        Row* row = new Row(static_cast<int>(g + 1));
+        for (int column : group_columns) row->addCopy(cell_at(group_rows[g], column));
+        for (size_t i = 0; i < specs.size(); i++) row->appendCell(finish(states[g * specs.size() + i], specs[i]));
+        result->insertRow(row);
+    }
+    return result;
+}
+
+bool aggregate_is_row_count(const LinkedList<SelectAggregate>& aggregates) {
+    if (aggregates.empty()) return false;
+    for (const auto& aggregate : aggregates) {
+        if (aggregate.function != AggregateFunction::COUNT || !aggregate.column_name.empty()) return false;
+    }
+    return true;
+}
+
+Table* aggregate_row_count(Table* table, const LinkedList<SelectAggregate>& aggregates) {
+    LinkedList<std::string> columns;
+    LinkedList<std::string> types;
+    for (const auto& aggregate : aggregates) {
+        columns.push_back(aggregate.output_name);
+        types.push_back("INT");
+    }
+    Table* result = new Table(table->getName() + "_grouped", columns, types);
+    Row* row = new Row(1);
+    long long count = static_cast<long long>(table->getRowCount());
+    for (size_t i = 0; i < aggregates.size(); i++) row->appendCell(count_cell(count));
+    result->insertRow(row);
+    return result;
+}
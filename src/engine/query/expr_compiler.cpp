@@ -0,0 +1,707 @@
+#include "../../../include/engine/query/expr_compiler.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+// Yorumlayici: derlenemeyen ifadeler ve beklenmeyen hucre tipleri icin
+// ---------------------------------------------------------------------------
+
+// WHERE agacinin bir satirdaki degeri. INT/DOUBLE sayilar number'da,
+// STRING text'te tutulur (hucreye ya da AST'ye isaret eder, kopyalanmaz).
+struct ExprValue {
+    CellType type;
+    double number;
+    const std::string* text;
+};
+
+static ExprValue null_value() {
+    return {CellType::NULL_VALUE, 0, nullptr};
+}
+
+static ExprValue number_value(double number) {
+    return {CellType::DOUBLE, number, nullptr};
+}
+
+static bool is_numeric(const ExprValue& v) {
+    return v.type == CellType::INT || v.type == CellType::DOUBLE;
+}
+
+// Metni tamamen sayiya cevirebiliyorsa true ('42', '3.5')
+static bool parse_number(const std::string& text, double& out) {
+    if (text.empty()) return false;
+    char* end = nullptr;
+    out = std::strtod(text.c_str(), &end);
+    return end == text.c_str() + text.size();
+}
+
+static std::string number_to_text(double number) {
+    if (number == static_cast<double>(static_cast<long long>(number))) {
+        return std::to_string(static_cast<long long>(number));
+    }
+    return std::to_string(number);
+}
+
+// SQL LIKE: % herhangi bir dizi, _ tek karakter
+static bool like_match(const std::string& text, const std::string& pattern) {
+    size_t t = 0, p = 0;
+    size_t star_p = std::string::npos, star_t = 0;
+    while (t < text.size()) {
+        if (p < pattern.size() && (pattern[p] == '_' || pattern[p] == text[t])) {
+            t++;
+            p++;
+        } else if (p < pattern.size() && pattern[p] == '%') {
+            star_p = p++;
+            star_t = t;
+        } else if (star_p != std::string::npos) {
+            p = star_p + 1;
+            t = ++star_t;
+        } else {
+            return false;
+        }
+    }
+    while (p < pattern.size() && pattern[p] == '%') p++;
+    return p == pattern.size();
+}
+
+static bool compare_ordering(int cmp, ComparisonOperator op) {
+    switch (op) {
+        case ComparisonOperator::EQUAL: return cmp == 0;
+        case ComparisonOperator::NOT_EQUAL: return cmp != 0;
+        case ComparisonOperator::LESS_THAN: return cmp < 0;
+        case ComparisonOperator::LESS_EQUAL: return cmp <= 0;
+        case ComparisonOperator::GREATER_THAN: return cmp > 0;
+        case ComparisonOperator::GREATER_EQUAL: return cmp >= 0;
+        default: return false;
+    }
+}
+
+// NULL iceren karsilastirmalar false. Sayi ile metin karsilastirilirsa metin
+// sayiya cevrilebiliyorsa sayisal, degilse metin olarak karsilastirilir.
+static bool compare_values(const ExprValue& a, const ExprValue& b, ComparisonOperator op) {
+    if (a.type == CellType::NULL_VALUE || b.type == CellType::NULL_VALUE) return false;
+
+    if (op == ComparisonOperator::LIKE) {
+        std::string lhs = is_numeric(a) ? number_to_text(a.number) : *a.text;
+        std::string rhs = is_numeric(b) ? number_to_text(b.number) : *b.text;
+        return like_match(lhs, rhs);
+    }
+
+    if (is_numeric(a) && is_numeric(b)) {
+        return compare_ordering(a.number < b.number ? -1 : (a.number > b.number ? 1 : 0), op);
+    }
+    if (!is_numeric(a) && !is_numeric(b)) {
+        return compare_ordering(a.text->compare(*b.text), op);
+    }
+
+    const ExprValue& num = is_numeric(a) ? a : b;
+    const ExprValue& str = is_numeric(a) ? b : a;
+    double parsed;
+    int cmp;
+    if (parse_number(*str.text, parsed)) {
+        cmp = num.number < parsed ? -1 : (num.number > parsed ? 1 : 0);
+    } else {
+        cmp = number_to_text(num.number).compare(*str.text);
+    }
+    if (!is_numeric(a)) cmp = -cmp;
+    return compare_ordering(cmp, op);
+}
+
+static bool evaluate_expr(Row* row, const BoundExpr* expr);
+
+static ExprValue evaluate_value(Row* row, const BoundExpr* expr) {
+    switch (expr->kind) {
+        case ExprKind::COLUMN: {
+            if (static_cast<size_t>(expr->column_index) >= row->getCellCount()) return null_value();
+            Cell* cell = row->getCell(expr->column_index);
+            if (cell->isNull()) return null_value();
+            if (cell->getType() == CellType::INT) return {CellType::INT, static_cast<double>(cell->getInt()), nullptr};
+            if (cell->getType() == CellType::DOUBLE) return {CellType::DOUBLE, cell->getDouble(), nullptr};
+            return {CellType::STRING, 0, &cell->getString()};
+        }
+        case ExprKind::LITERAL:
+            return {expr->value_type, expr->number, &expr->text};
+        case ExprKind::ARITHMETIC: {
+            ExprValue rhs = evaluate_value(row, expr->right);
+            if (!expr->left) return is_numeric(rhs) ? number_value(-rhs.number) : null_value();
+            ExprValue lhs = evaluate_value(row, expr->left);
+            if (!is_numeric(lhs) || !is_numeric(rhs)) return null_value();
+            switch (expr->arith_op) {
+                case ArithmeticOperator::ADD: return number_value(lhs.number + rhs.number);
+                case ArithmeticOperator::SUBTRACT: return number_value(lhs.number - rhs.number);
+                case ArithmeticOperator::MULTIPLY: return number_value(lhs.number * rhs.number);
+                case ArithmeticOperator::DIVIDE:
+                    if (rhs.number == 0) return null_value();
+                    return number_value(lhs.number / rhs.number);
+            }
+            return null_value();
+        }
+        default:
+            // Mantiksal ifade deger olarak kullanilirsa 1 / 0
+            return {CellType::INT, evaluate_expr(row, expr) ? 1.0 : 0.0, nullptr};
+    }
+}
+
+static bool evaluate_expr(Row* row, const BoundExpr* expr) {
+    switch (expr->kind) {
+        case ExprKind::AND:
+            return evaluate_expr(row, expr->left) && evaluate_expr(row, expr->right);
+        case ExprKind::OR:
+            return evaluate_expr(row, expr->left) || evaluate_expr(row, expr->right);
+        case ExprKind::NOT:
+            return !evaluate_expr(row, expr->left);
+        case ExprKind::COMPARISON:
+            return compare_values(evaluate_value(row, expr->left), evaluate_value(row, expr->right), expr->op);
+        case ExprKind::IN_LIST: {
+            ExprValue value = evaluate_value(row, expr->left);
+            if (value.type == CellType::NULL_VALUE) return false;
+            bool found = false;
+            for (auto item : expr->list) {
+                if (compare_values(value, evaluate_value(row, item), ComparisonOperator::EQUAL)) {
+                    found = true;
+                    break;
+                }
+            }
+            return found != expr->negated;
+        }
+        case ExprKind::IS_NULL: {
+            bool is_null = evaluate_value(row, expr->left).type == CellType::NULL_VALUE;
+            return is_null != expr->negated;
+        }
+        default: {
+            // Tek basina deger: sifirdan farkli sayi ya da bos olmayan metin
+            ExprValue value = evaluate_value(row, expr);
+            if (is_numeric(value)) return value.number != 0;
+            return value.type == CellType::STRING && !value.text->empty();
+        }
+    }
+}
+
+bool bound_expr_evaluate(const BoundExpr* expr, Row* row) {
+    return expr ? evaluate_expr(row, expr) : true;
+}
+
+// ---------------------------------------------------------------------------
+// Derleyici
+// ---------------------------------------------------------------------------
+
+// Sayisal alt ifade sonucu. OTHER: hucre sayi degil (yorumlayiciya dus).
+enum class NumResult {
+    OK,
+    NULL_VALUE,
+    OTHER
+};
+
+struct ValueNode;
+typedef NumResult (*ValueFn)(const ValueNode* node, Row* row, double& out);
+
+struct ValueNode {
+    ValueFn fn;
+    int column;
+    double number;
+    ValueNode* left;
+    ValueNode* right;
+
+    ValueNode() : fn(nullptr), column(-1), number(0), left(nullptr), right(nullptr) {}
+    ~ValueNode() {
+        delete left;
+        delete right;
+    }
+};
+
+typedef bool (*PredicateFn)(const PredicateNode* node, Row* row);
+
+struct PredicateNode {
+    PredicateFn fn;
+    const BoundExpr* expr;  // yedek yol icin kaynak dugum
+    int column;
+    bool negated;
+    int64_t integer;
+    double number;
+    std::string text;
+    std::vector<double> numbers;     // IN listesi (sirali)
+    std::vector<std::string> texts;  // IN listesi (sirali)
+    // STRING kolonun sozlugu: bu sozlukle kodlu hucreler metin yerine kodla
+    // karsilastirilir. Sozlukte olmayan sabit NOT_FOUND (hicbir koda esit degil).
+    const StringDictionary* dictionary;
+    uint32_t code;
+    std::vector<uint32_t> codes;     // IN listesindeki sabitlerin kodlari (sirali)
+    ValueNode* lhs;
+    ValueNode* rhs;
+    PredicateNode* left;
+    PredicateNode* right;
+
+    PredicateNode()
+        : fn(nullptr), expr(nullptr), column(-1), negated(false), integer(0), number(0), dictionary(nullptr),
+          code(StringDictionary::NOT_FOUND), lhs(nullptr), rhs(nullptr), left(nullptr), right(nullptr) {}
+    ~PredicateNode() {
+        delete lhs;
+        delete rhs;
+        delete left;
+        delete right;
+    }
+};
+
+static inline Cell* cell_at(Row* row, int column) {
+    return static_cast<size_t>(column) < row->getCellCount() ? row->getCell(column) : nullptr;
+}
+
+static inline bool fallback(const PredicateNode* n, Row* row) {
+    return evaluate_expr(row, n->expr);
+}
+
+template <ComparisonOperator OP, typename T>
+static inline bool apply_op(const T& a, const T& b) {
+    if constexpr (OP == ComparisonOperator::EQUAL) return a == b;
+    else if constexpr (OP == ComparisonOperator::NOT_EQUAL) return a != b;
+    else if constexpr (OP == ComparisonOperator::LESS_THAN) return a < b;
+    else if constexpr (OP == ComparisonOperator::LESS_EQUAL) return a <= b;
+    else if constexpr (OP == ComparisonOperator::GREATER_THAN) return a > b;
+    else if constexpr (OP == ComparisonOperator::GREATER_EQUAL) return a >= b;
+    else return false;
+}
+
+// --- Karsilastirma kernelleri (operator sablon parametresi) ---
+
+// INT kolon op tamsayi sabit
+template <ComparisonOperator OP>
+struct IntColumnIntConst {
+    static bool run(const PredicateNode* n, Row* row) {
+        Cell* cell = cell_at(row, n->column);
+        if (cell && cell->getType() == CellType::INT) {
+            return apply_op<OP, int64_t>(cell->getInt(), n->integer);
+        }
+        return fallback(n, row);
+    }
+};
+
+// INT/DOUBLE kolon op sayi sabit
+template <ComparisonOperator OP>
+struct NumberColumnConst {
+    static bool run(const PredicateNode* n, Row* row) {
+        Cell* cell = cell_at(row, n->column);
+        if (cell && cell->getType() == CellType::DOUBLE) return apply_op<OP, double>(cell->getDouble(), n->number);
+        if (cell && cell->getType() == CellType::INT) return apply_op<OP, double>(cell->getInt(), n->number);
+        return fallback(n, row);
+    }
+};
+
+// STRING kolon op metin sabit
+template <ComparisonOperator OP>
+struct StringColumnConst {
+    static bool run(const PredicateNode* n, Row* row) {
+        Cell* cell = cell_at(row, n->column);
+        if (cell && cell->getType() == CellType::STRING) {
+            if constexpr (OP == ComparisonOperator::EQUAL || OP == ComparisonOperator::NOT_EQUAL) {
+                if (n->dictionary && cell->getDictionary() == n->dictionary) {
+                    return apply_op<OP, uint32_t>(cell->getCode(), n->code);
+                }
+            }
+            const std::string& value = cell->getString();
+            if constexpr (OP == ComparisonOperator::EQUAL) return value == n->text;
+            else if constexpr (OP == ComparisonOperator::NOT_EQUAL) return value != n->text;
+            else return apply_op<OP, int>(value.compare(n->text), 0);
+        }
+        return fallback(n, row);
+    }
+};
+
+// Sayisal ifade op sayisal ifade (aritmetik, kolon-kolon)
+template <ComparisonOperator OP>
+struct NumberValues {
+    static bool run(const PredicateNode* n, Row* row) {
+        double a, b;
+        NumResult ra = n->lhs->fn(n->lhs, row, a);
+        NumResult rb = n->rhs->fn(n->rhs, row, b);
+        if (ra == NumResult::OK && rb == NumResult::OK) return apply_op<OP, double>(a, b);
+        if (ra == NumResult::OTHER || rb == NumResult::OTHER) return fallback(n, row);
+        return false;  // NULL
+    }
+};
+
+template <template <ComparisonOperator> class Kernel>
+static PredicateFn pick_kernel(ComparisonOperator op) {
+    switch (op) {
+        case ComparisonOperator::EQUAL: return &Kernel<ComparisonOperator::EQUAL>::run;
+        case ComparisonOperator::NOT_EQUAL: return &Kernel<ComparisonOperator::NOT_EQUAL>::run;
+        case ComparisonOperator::LESS_THAN: return &Kernel<ComparisonOperator::LESS_THAN>::run;
+        case ComparisonOperator::LESS_EQUAL: return &Kernel<ComparisonOperator::LESS_EQUAL>::run;
+        case ComparisonOperator::GREATER_THAN: return &Kernel<ComparisonOperator::GREATER_THAN>::run;
+        case ComparisonOperator::GREATER_EQUAL: return &Kernel<ComparisonOperator::GREATER_EQUAL>::run;
+        default: return nullptr;
+    }
+}
+
+// --- LIKE kernelleri: desen derlemede siniflandirilir ---
+
+template <typename Match>
+static bool like_kernel(const PredicateNode* n, Row* row) {
+    Cell* cell = cell_at(row, n->column);
+    if (cell && cell->getType() == CellType::STRING) return Match::run(cell->getString(), n->text);
+    return fallback(n, row);
+}
+
+struct LikeExact {
+    static bool run(const std::string& s, const std::string& p) { return s == p; }
+};
+struct LikePrefix {
+    static bool run(const std::string& s, const std::string& p) {
+        return s.size() >= p.size() && s.compare(0, p.size(), p) == 0;
+    }
+};
+struct LikeSuffix {
+    static bool run(const std::string& s, const std::string& p) {
+        return s.size() >= p.size() && s.compare(s.size() - p.size(), p.size(), p) == 0;
+    }
+};
+struct LikeContains {
+    static bool run(const std::string& s, const std::string& p) { return s.find(p) != std::string::npos; }
+};
+struct LikeGeneral {
+    static bool run(const std::string& s, const std::string& p) { return like_match(s, p); }
+};
+
+// --- Diger dugumler ---
+
+static bool and_kernel(const PredicateNode* n, Row* row) {
+    return n->left->fn(n->left, row) && n->right->fn(n->right, row);
+}
+
+static bool or_kernel(const PredicateNode* n, Row* row) {
+    return n->left->fn(n->left, row) || n->right->fn(n->right, row);
+}
+
+static bool not_kernel(const PredicateNode* n, Row* row) {
+    return !n->left->fn(n->left, row);
+}
+
+static bool const_false_kernel(const PredicateNode*, Row*) {
+    return false;
+}
+
+static bool const_true_kernel(const PredicateNode*, Row*) {
+    return true;
+}
+
+static bool is_null_kernel(const PredicateNode* n, Row* row) {
+    Cell* cell = cell_at(row, n->column);
+    bool is_null = !cell || cell->isNull();
+    return is_null != n->negated;
+}
+
+static bool in_number_kernel(const PredicateNode* n, Row* row) {
+    Cell* cell = cell_at(row, n->column);
+    double value;
+    if (cell && cell->getType() == CellType::INT) value = cell->getInt();
+    else if (cell && cell->getType() == CellType::DOUBLE) value = cell->getDouble();
+    else return fallback(n, row);
+    bool found = std::binary_search(n->numbers.begin(), n->numbers.end(), value);
+    return found != n->negated;
+}
+
+static bool in_string_kernel(const PredicateNode* n, Row* row) {
+    Cell* cell = cell_at(row, n->column);
+    if (!cell || cell->getType() != CellType::STRING) return fallback(n, row);
+    bool found;
+    if (n->dictionary && cell->getDictionary() == n->dictionary) {
+        found = std::binary_search(n->codes.begin(), n->codes.end(), cell->getCode());
+    } else {
+        found = std::binary_search(n->texts.begin(), n->texts.end(), cell->getString());
+    }
+    return found != n->negated;
+}
+
+static bool generic_kernel(const PredicateNode* n, Row* row) {
+    return evaluate_expr(row, n->expr);
+}
+
+// --- Sayisal deger dugumleri ---
+
+static NumResult value_const(const ValueNode* n, Row*, double& out) {
+    out = n->number;
+    return NumResult::OK;
+}
+
+static NumResult value_column(const ValueNode* n, Row* row, double& out) {
+    Cell* cell = cell_at(row, n->column);
+    if (!cell || cell->isNull()) return NumResult::NULL_VALUE;
+    if (cell->getType() == CellType::INT) out = cell->getInt();
+    else if (cell->getType() == CellType::DOUBLE) out = cell->getDouble();
+    else return NumResult::OTHER;
+    return NumResult::OK;
+}
+
+template <ArithmeticOperator OP>
+static NumResult value_arithmetic(const ValueNode* n, Row* row, double& out) {
+    double a, b;
+    // Aritmetikte sayi olmayan deger yorumlayicidaki gibi NULL'dur
+    if (n->left->fn(n->left, row, a) != NumResult::OK) return NumResult::NULL_VALUE;
+    if (n->right->fn(n->right, row, b) != NumResult::OK) return NumResult::NULL_VALUE;
+    if constexpr (OP == ArithmeticOperator::ADD) out = a + b;
+    else if constexpr (OP == ArithmeticOperator::SUBTRACT) out = a - b;
+    else if constexpr (OP == ArithmeticOperator::MULTIPLY) out = a * b;
+    else {
+        if (b == 0) return NumResult::NULL_VALUE;
+        out = a / b;
+    }
+    return NumResult::OK;
+}
+
+static NumResult value_negate(const ValueNode* n, Row* row, double& out) {
+    if (n->right->fn(n->right, row, out) != NumResult::OK) return NumResult::NULL_VALUE;
+    out = -out;
+    return NumResult::OK;
+}
+
+static bool is_number_literal(const BoundExpr* e) {
+    return e->kind == ExprKind::LITERAL && (e->value_type == CellType::INT || e->value_type == CellType::DOUBLE);
+}
+
+static bool is_numeric_column(const BoundExpr* e) {
+    return e->kind == ExprKind::COLUMN && (e->value_type == CellType::INT || e->value_type == CellType::DOUBLE);
+}
+
+// Karsilastirmada sayi gibi kullanilabilen sabit: sayi ya da sayiya
+// cevrilebilen metin (yorumlayici sayi-metin karsilastirmasini boyle yapar)
+static bool literal_as_number(const BoundExpr* e, double& out) {
+    if (is_number_literal(e)) {
+        out = e->number;
+        return true;
+    }
+    return e->kind == ExprKind::LITERAL && e->value_type == CellType::STRING && parse_number(e->text, out);
+}
+
+static ValueNode* compile_value(const BoundExpr* e) {
+    if (is_number_literal(e)) {
+        ValueNode* n = new ValueNode();
+        n->fn = value_const;
+        n->number = e->number;
+        return n;
+    }
+    if (is_numeric_column(e)) {
+        ValueNode* n = new ValueNode();
+        n->fn = value_column;
+        n->column = e->column_index;
+        return n;
+    }
+    if (e->kind != ExprKind::ARITHMETIC) return nullptr;
+
+    ValueNode* right = compile_value(e->right);
+    if (!right) return nullptr;
+    ValueNode* left = nullptr;
+    if (e->left) {
+        left = compile_value(e->left);
+        if (!left) {
+            delete right;
+            return nullptr;
+        }
+    }
+
+    ValueNode* n = new ValueNode();
+    n->left = left;
+    n->right = right;
+    if (!left) {
+        n->fn = value_negate;
+        return n;
+    }
+    switch (e->arith_op) {
+        case ArithmeticOperator::ADD: n->fn = value_arithmetic<ArithmeticOperator::ADD>; break;
+        case ArithmeticOperator::SUBTRACT: n->fn = value_arithmetic<ArithmeticOperator::SUBTRACT>; break;
+        case ArithmeticOperator::MULTIPLY: n->fn = value_arithmetic<ArithmeticOperator::MULTIPLY>; break;
+        case ArithmeticOperator::DIVIDE: n->fn = value_arithmetic<ArithmeticOperator::DIVIDE>; break;
+    }
+    return n;
+}
+
+// Karsilastirmada sabit sola yazilmissa ("5 < x") operatoru cevir
+static ComparisonOperator flip(ComparisonOperator op) {
+    switch (op) {
+        case ComparisonOperator::LESS_THAN: return ComparisonOperator::GREATER_THAN;
+        case ComparisonOperator::LESS_EQUAL: return ComparisonOperator::GREATER_EQUAL;
+        case ComparisonOperator::GREATER_THAN: return ComparisonOperator::LESS_THAN;
+        case ComparisonOperator::GREATER_EQUAL: return ComparisonOperator::LESS_EQUAL;
+        default: return op;
+    }
+}
+
+static void compile_like(PredicateNode* n, const BoundExpr* column, const std::string& pattern) {
+    n->column = column->column_index;
+
+    // Sadece bastaki/sondaki % ve joker icermeyen govde ozel kernel alir
+    size_t begin = 0, end = pattern.size();
+    bool leading = begin < end && pattern[begin] == '%';
+    if (leading) begin++;
+    bool trailing = end > begin && pattern[end - 1] == '%';
+    if (trailing) end--;
+    std::string body = pattern.substr(begin, end - begin);
+
+    if (body.find_first_of("%_") != std::string::npos) {
+        n->text = pattern;
+        n->fn = like_kernel<LikeGeneral>;
+        return;
+    }
+    n->text = body;
+    if (leading && trailing) n->fn = like_kernel<LikeContains>;
+    else if (leading) n->fn = like_kernel<LikeSuffix>;
+    else if (trailing) n->fn = like_kernel<LikePrefix>;
+    else n->fn = like_kernel<LikeExact>;
+}
+
+static void compile_comparison(PredicateNode* n, const BoundExpr* e) {
+    const BoundExpr* left = e->left;
+    const BoundExpr* right = e->right;
+    ComparisonOperator op = e->op;
+
+    if (op == ComparisonOperator::LIKE) {
+        if (left->kind == ExprKind::COLUMN && left->value_type == CellType::STRING &&
+            right->kind == ExprKind::LITERAL && right->value_type == CellType::STRING) {
+            compile_like(n, left, right->text);
+        }
+        return;
+    }
+
+    if (left->kind == ExprKind::LITERAL && right->kind == ExprKind::COLUMN) {
+        std::swap(left, right);
+        op = flip(op);
+    }
+
+    if (left->kind == ExprKind::COLUMN && right->kind == ExprKind::LITERAL) {
+        if (right->value_type == CellType::NULL_VALUE) {
+            n->fn = const_false_kernel;
+            return;
+        }
+        n->column = left->column_index;
+        double number;
+        if (is_numeric_column(left) && literal_as_number(right, number)) {
+            if (left->value_type == CellType::INT && std::floor(number) == number && std::fabs(number) < 9e18) {
+                n->integer = static_cast<int64_t>(number);
+                n->fn = pick_kernel<IntColumnIntConst>(op);
+            } else {
+                n->number = number;
+                n->fn = pick_kernel<NumberColumnConst>(op);
+            }
+            return;
+        }
+        if (left->value_type == CellType::STRING && right->value_type == CellType::STRING) {
+            n->text = right->text;
+            if (left->dictionary && (op == ComparisonOperator::EQUAL || op == ComparisonOperator::NOT_EQUAL)) {
+                n->dictionary = left->dictionary;
+                n->code = left->dictionary->find(right->text);
+            }
+            n->fn = pick_kernel<StringColumnConst>(op);
+        }
+        return;
+    }
+
+    // Sayisal ifadeler; metin sabit sayiya cevrilebiliyorsa sayi sayilir
+    ValueNode* lhs = compile_value(left);
+    ValueNode* rhs = compile_value(right);
+    double number;
+    if (!lhs && rhs && literal_as_number(left, number)) {
+        lhs = new ValueNode();
+        lhs->fn = value_const;
+        lhs->number = number;
+    }
+    if (!rhs && lhs && literal_as_number(right, number)) {
+        rhs = new ValueNode();
+        rhs->fn = value_const;
+        rhs->number = number;
+    }
+    if (lhs && rhs) {
+        n->lhs = lhs;
+        n->rhs = rhs;
+        n->fn = pick_kernel<NumberValues>(op);
+        return;
+    }
+    delete lhs;
+    delete rhs;
+}
+
+static void compile_in_list(PredicateNode* n, const BoundExpr* e) {
+    const BoundExpr* column = e->left;
+    if (column->kind != ExprKind::COLUMN) return;
+
+    bool all_numbers = is_numeric_column(column);
+    bool all_texts = column->value_type == CellType::STRING;
+    for (auto item : e->list) {
+        if (!is_number_literal(item)) all_numbers = false;
+        if (item->kind != ExprKind::LITERAL || item->value_type != CellType::STRING) all_texts = false;
+    }
+
+    n->column = column->column_index;
+    n->negated = e->negated;
+    if (all_numbers) {
+        for (auto item : e->list) n->numbers.push_back(item->number);
+        std::sort(n->numbers.begin(), n->numbers.end());
+        n->fn = in_number_kernel;
+    } else if (all_texts) {
+        for (auto item : e->list) n->texts.push_back(item->text);
+        std::sort(n->texts.begin(), n->texts.end());
+        n->dictionary = column->dictionary;
+        if (n->dictionary) {
+            for (const auto& text : n->texts) {
+                uint32_t code = n->dictionary->find(text);
+                if (code != StringDictionary::NOT_FOUND) n->codes.push_back(code);
+            }
+            std::sort(n->codes.begin(), n->codes.end());
+        }
+        n->fn = in_string_kernel;
+    }
+}
+
+static PredicateNode* compile(const BoundExpr* e) {
+    PredicateNode* n = new PredicateNode();
+    n->expr = e;
+
+    switch (e->kind) {
+        case ExprKind::AND:
+        case ExprKind::OR:
+            n->left = compile(e->left);
+            n->right = compile(e->right);
+            n->fn = e->kind == ExprKind::AND ? and_kernel : or_kernel;
+            break;
+        case ExprKind::NOT:
+            n->left = compile(e->left);
+            n->fn = not_kernel;
+            break;
+        case ExprKind::COMPARISON:
+            compile_comparison(n, e);
+            break;
+        case ExprKind::IN_LIST:
+            compile_in_list(n, e);
+            break;
+        case ExprKind::IS_NULL:
+            if (e->left->kind == ExprKind::COLUMN) {
+                n->column = e->left->column_index;
+                n->negated = e->negated;
+                n->fn = is_null_kernel;
+            }
+            break;
+        default:
+            break;
+    }
+
+    // Ozel kernel bulunamadiysa dugum yorumlayici ile calisir
+    if (!n->fn) n->fn = generic_kernel;
+    return n;
+}
+
+CompiledPredicate::CompiledPredicate(const BoundExpr* expr) : root(nullptr) {
+    if (expr) {
+        root = compile(expr);
+    } else {
+        root = new PredicateNode();
+        root->fn = const_true_kernel;
+    }
+}
+
+CompiledPredicate::~CompiledPredicate() {
+    delete root;
+}
+
+bool CompiledPredicate::matches(Row* row) const {
+    return root->fn(root, row);
+}
@@ -3,176 +3,909 @@
  * JOIN SÜTUNLARI DÜZELTİLMİŞ SÜRÜM
  */
 #include "../../../include/engine/query/join_engine.hpp"
+#include "../../../include/engine/query/query_binder.hpp"
 #include "../../../include/core/Table.hpp"
 #include "../../../include/core/Row.hpp"
 #include "../../../include/core/Cell.hpp"
 #include "../../../include/data_structures/LinkedList.hpp"
+#include "../../../include/utils/SpillFile.hpp"
+#include "../../../include/utils/ThreadPool.hpp"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <memory>
 #include <string>
+#include <unordered_set>
+#include <vector>
 
-struct HashEntry {
-    Row* row;
-    HashEntry(Row* r) : row(r) {}
+// Join anahtarlarinin karsilastirildigi tip. Iki kolonun tanimli tiplerinden
+// bir kez secilir; satir basina string donusumu yapilmaz.
+enum class JoinKeyKind {
+    INT,
+    DOUBLE,
+    STRING
+};
+
+static std::string column_type_at(Table* table, int column_index) {
+    int idx = 0;
+    for (const auto& type : table->getTypes()) {
+        if (idx == column_index) return type;
+        idx++;
+    }
+    return "STRING";
+}
+
+static JoinKeyKind resolve_key_kind(Table* left, int left_idx, Table* right, int right_idx) {
+    std::string lt = column_type_at(left, left_idx);
+    std::string rt = column_type_at(right, right_idx);
+    if (lt == "INT" && rt == "INT") return JoinKeyKind::INT;
+    bool l_num = (lt == "INT" || lt == "DOUBLE");
+    bool r_num = (rt == "INT" || rt == "DOUBLE");
+    if (l_num && r_num) return JoinKeyKind::DOUBLE;
+    return JoinKeyKind::STRING;
+}
+
+// Hucre bu anahtar tipiyle join'e girebilir mi? NULL anahtarlar hicbir seyle eslesmez.
+static bool key_usable(JoinKeyKind kind, const Cell* cell) {
+    if (!cell || cell->isNull()) return false;
+    if (kind == JoinKeyKind::INT) return cell->getType() == CellType::INT;
+    if (kind == JoinKeyKind::DOUBLE) return cell->getType() != CellType::STRING;
+    return true;
+}
+
+static double key_as_double(const Cell* cell) {
+    return cell->getType() == CellType::INT ? static_cast<double>(cell->getInt()) : cell->getDouble();
+}
+
+// STRING anahtar tipinde sayisal hucreler (karisik kolonlar) eski davranistaki gibi
+// metin olarak karsilastirilir.
+static std::string key_as_string(const Cell* cell) {
+    if (cell->getType() == CellType::INT) return std::to_string(cell->getInt());
+    if (cell->getType() == CellType::DOUBLE) return std::to_string(cell->getDouble());
+    return cell->getString();
+}
+
+static size_t key_hash(JoinKeyKind kind, const Cell* cell) {
+    if (kind == JoinKeyKind::INT) {
+        // splitmix64 karistirmasi: ardisik id'ler kovalara esit dagilsin
+        unsigned long long x = static_cast<unsigned long long>(static_cast<long long>(cell->getInt()));
+        x += 0x9e3779b97f4a7c15ULL;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return static_cast<size_t>(x ^ (x >> 31));
+    }
+    if (kind == JoinKeyKind::DOUBLE) {
+        double d = key_as_double(cell);
+        if (d == 0.0) d = 0.0;  // -0.0 ile 0.0 ayni kovaya dussun
+        return std::hash<double>{}(d);
+    }
+    // Kodlu hucrenin hash'i sozlukte hazir
+    if (cell->getType() == CellType::STRING) return cell->getStringHash();
+    return std::hash<std::string>{}(key_as_string(cell));
+}
+
+static bool key_equals(JoinKeyKind kind, const Cell* a, const Cell* b) {
+    if (kind == JoinKeyKind::INT) return a->getInt() == b->getInt();
+    if (kind == JoinKeyKind::DOUBLE) return key_as_double(a) == key_as_double(b);
+    if (a->getType() == CellType::STRING && b->getType() == CellType::STRING) {
+        // Ayni sozlukle kodlu iki hucre (ayni kolon, ayni tablo) kodla esitlenir
+        if (a->isEncoded() && a->getDictionary() == b->getDictionary()) return a->getCode() == b->getCode();
+        return a->getString() == b->getString();
+    }
+    return key_as_string(a) == key_as_string(b);
+}
+
+// Bir join eslesmesi. Algoritmalar yalnizca satir referanslarini toplar,
+// degerler en sonda ve sadece istenen kolonlar icin kopyalanir.
+// OUTER JOIN'de eksik taraf nullptr'dir.
+struct JoinMatch {
+    Row* left;
+    Row* right;
 };
 
-// Yardımcı: İki tablonun sütunlarını birleştir
-static void merge_columns(Table* left, Table* right, LinkedList<std::string>& cols, LinkedList<std::string>& types) {
-    for (const auto& col : left->getColumns()) cols.push_back(col);
-    for (const auto& type : left->getTypes()) types.push_back(type);
-    
-    for (const auto& col : right->getColumns()) cols.push_back(col);
-    for (const auto& type : right->getTypes()) types.push_back(type);
+// Join sonucunun semasi. left_cols/right_cols, sonuca giren kolonlarin artan
+// sirali indeksleridir; SELECT'te kullanilmayan kolonlar hic kopyalanmaz.
+struct JoinOutput {
+    LinkedList<std::string> columns;
+    LinkedList<std::string> types;
+    std::vector<int> left_cols;
+    std::vector<int> right_cols;
+    bool all_left;
+    bool all_right;
+};
+
+// Sonuctaki kolon adi: taraf bir tablonun kendisiyse kolonlar sorgudaki
+// adiyla nitelenir; onceki bir join'in sonucu zaten nitelenmistir
+static std::string output_name(const std::string& alias, const std::string& column) {
+    if (alias.empty() || column.find('.') != std::string::npos) return column;
+    return alias + "." + column;
+}
+
+// wanted: "ad.kolon", niteliksiz "kolon" (her taraftaki ayni adli kolon),
+// "ad.*" ya da "*"
+static bool column_wanted(const JoinColumns* output_columns, const std::string& name) {
+    if (!output_columns || !output_columns->wanted || output_columns->wanted->empty()) return true;
+    size_t dot = name.find('.');
+    std::string bare = dot == std::string::npos ? name : name.substr(dot + 1);
+    std::string table_star = dot == std::string::npos ? "*" : name.substr(0, dot + 1) + "*";
+    for (const auto& col : *output_columns->wanted) {
+        if (col == name || col == bare || col == table_star || col == "*") return true;
+    }
+    return false;
+}
+
+// Yardımcı: İki tablonun sütunlarını birleştir (istenmeyen kolonlar atlanir)
+static void add_side_columns(Table* table, const JoinColumns* output_columns, const std::string& alias,
+                             JoinOutput& out, std::vector<int>& picked) {
+    int idx = 0;
+    auto type_it = table->getTypes().begin();
+    for (const auto& col : table->getColumns()) {
+        std::string type = (type_it != table->getTypes().end()) ? *type_it : "STRING";
+        std::string name = output_name(alias, col);
+        if (column_wanted(output_columns, name)) {
+            out.columns.push_back(name);
+            out.types.push_back(type);
+            picked.push_back(idx);
+        }
+        idx++;
+        if (type_it != table->getTypes().end()) ++type_it;
+    }
+}
+
+static void plan_output(Table* left, Table* right, const JoinColumns* output_columns,
+                        JoinOutput& out) {
+    add_side_columns(left, output_columns, output_columns ? output_columns->left_alias : "", out, out.left_cols);
+    add_side_columns(right, output_columns, output_columns ? output_columns->right_alias : "", out, out.right_cols);
+    out.all_left = out.left_cols.size() == left->getColumns().size();
+    out.all_right = out.right_cols.size() == right->getColumns().size();
+}
+
+// Bir tarafin istenen hucrelerini kopyalar; hucre listesi tek gecişte yurunur
+static void copy_side(Row* dst, Row* src, const std::vector<int>& cols, bool all) {
+    if (!src) {
+        for (size_t i = 0; i < cols.size(); i++) dst->addNull();
+        return;
+    }
+    if (all) {
+        for (auto cell : src->getCells()) dst->addCopy(cell);
+        return;
+    }
+    size_t next = 0;
+    int idx = 0;
+    for (auto cell : src->getCells()) {
+        if (next == cols.size()) break;
+        if (idx == cols[next]) {
+            dst->addCopy(cell);
+            next++;
+        }
+        idx++;
+    }
+}
+
+// Bu boyutun ustundeki sonuclarda satirlar thread havuzunda paralel kopyalanir
+static const size_t PARALLEL_MATERIALIZE_MIN_ROWS = 20000;
+
+static Row* build_joined_row(const JoinMatch& match, const JoinOutput& out) {
+    Row* joined_row = new Row(match.left ? match.left->getId() : match.right->getId());
+    copy_side(joined_row, match.left, out.left_cols, out.all_left);
+    copy_side(joined_row, match.right, out.right_cols, out.all_right);
+    return joined_row;
+}
+
+// Eslesme listesinden sonuc tablosunu olusturur. Butun join algoritmalari
+// eslesmeleri toplar, kopyalama tek yerde yapilir.
+static Table* materialize_matches(Table* left_table, Table* right_table, const std::string& name,
+                                  const std::vector<JoinMatch>& matches,
+                                  const JoinColumns* output_columns) {
+    JoinOutput out;
+    plan_output(left_table, right_table, output_columns, out);
+
+    Table* result = new Table(name, out.columns, out.types);
+
+    if (matches.size() < PARALLEL_MATERIALIZE_MIN_ROWS) {
+        for (const auto& match : matches) result->insertRow(build_joined_row(match, out));
+        return result;
+    }
+
+    // Satir kopyalari morsel'ler halinde paralel, indekslere ekleme (Table
+    // thread-safe degil) sirayla
+    std::vector<Row*> rows(matches.size(), nullptr);
+    ThreadPool::global().parallelMorsels(matches.size(), MORSEL_ROWS, [&](size_t, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) rows[i] = build_joined_row(matches[i], out);
+    });
+    for (auto row : rows) result->insertRow(row);
+    return result;
+}
+
+static bool keeps_unmatched_left(JoinType join_type) {
+    return join_type == JoinType::LEFT || join_type == JoinType::FULL;
+}
+
+static bool keeps_unmatched_right(JoinType join_type) {
+    return join_type == JoinType::RIGHT || join_type == JoinType::FULL;
 }
 
 Table* join_nested_loop(Table* left_table, Table* right_table,
                         int left_column_index, int right_column_index,
-                        JoinType join_type) {
+                        JoinType join_type,
+                        const JoinColumns* output_columns) {
     if (!left_table || !right_table) return nullptr;
-    
-    // 1. Sütunları Birleştir (DÜZELTME BURADA)
-    LinkedList<std::string> res_cols;
-    LinkedList<std::string> res_types;
-    merge_columns(left_table, right_table, res_cols, res_types);
-
-    Table* result = new Table("join_result_nl", res_cols, res_types);
-    
+
+    JoinKeyKind kind = resolve_key_kind(left_table, left_column_index, right_table, right_column_index);
+    std::vector<JoinMatch> matches;
+
+    // RIGHT/FULL icin hangi sag satirlarin eslestigini takip et
+    std::vector<bool> right_matched(right_table->getRowCount(), false);
+
     for (auto left_row : left_table->getRows()) {
         Cell* left_cell = left_row->getCell(left_column_index);
-        if (!left_cell) continue;
-        
-        std::string left_key;
-        if (left_cell->getType() == CellType::INT) left_key = std::to_string(left_cell->getInt());
-        else if (left_cell->getType() == CellType::STRING) left_key = left_cell->getString();
-        else continue;
-        
         bool matched = false;
-        
-        for (auto right_row : right_table->getRows()) {
-            Cell* right_cell = right_row->getCell(right_column_index);
-            if (!right_cell) continue;
-            
-            std::string right_key;
-            if (right_cell->getType() == CellType::INT) right_key = std::to_string(right_cell->getInt());
-            else if (right_cell->getType() == CellType::STRING) right_key = right_cell->getString();
-            else continue;
-            
-            if (left_key == right_key) {
-                // Eşleşme bulundu: İki satırı birleştir
-                Row* joined_row = new Row(left_row->getId()); // ID mantığı projeye göre değişebilir
-                
-                // Sol hücreleri ekle
-                for (auto cell : left_row->getCells()) {
-                    if (cell->getType() == CellType::INT) joined_row->addCell(cell->getInt());
-                    else if (cell->getType() == CellType::DOUBLE) joined_row->addCell(cell->getDouble());
-                    else joined_row->addCell(cell->getString());
-                }
-                // Sağ hücreleri ekle
-                for (auto cell : right_row->getCells()) {
-                    if (cell->getType() == CellType::INT) joined_row->addCell(cell->getInt());
-                    else if (cell->getType() == CellType::DOUBLE) joined_row->addCell(cell->getDouble());
-                    else joined_row->addCell(cell->getString());
+
+        if (key_usable(kind, left_cell)) {
+            size_t right_pos = 0;
+            for (auto right_row : right_table->getRows()) {
+                Cell* right_cell = right_row->getCell(right_column_index);
+                if (key_usable(kind, right_cell) && key_equals(kind, left_cell, right_cell)) {
+                    // Eşleşme bulundu: İki satırı birleştir
+                    matches.push_back({left_row, right_row});
+                    right_matched[right_pos] = true;
+                    matched = true;
                 }
-                
-                result->insertRow(joined_row);
-                matched = true;
+                right_pos++;
             }
         }
+
+        if (!matched && keeps_unmatched_left(join_type)) matches.push_back({left_row, nullptr});
     }
-    return result;
+
+    if (keeps_unmatched_right(join_type)) {
+        size_t right_pos = 0;
+        for (auto right_row : right_table->getRows()) {
+            if (!right_matched[right_pos]) matches.push_back({nullptr, right_row});
+            right_pos++;
+        }
+    }
+    return materialize_matches(left_table, right_table, "join_result_nl", matches, output_columns);
+}
+
+// Build/probe tarafi secimi. Hash tablosu kucuk tablo uzerine kurulur.
+struct JoinSides {
+    bool build_left;
+    Table* build_table;
+    Table* probe_table;
+    int build_col;
+    int probe_col;
+    bool keep_unmatched_build;
+    bool keep_unmatched_probe;
+
+    JoinMatch pair(Row* build_row, Row* probe_row) const {
+        return build_left ? JoinMatch{build_row, probe_row} : JoinMatch{probe_row, build_row};
+    }
+};
+
+static JoinSides choose_sides(Table* left_table, Table* right_table, int left_column_index,
+                              int right_column_index, JoinType join_type) {
+    JoinSides sides;
+    sides.build_left = left_table->getRowCount() <= right_table->getRowCount();
+    sides.build_table = sides.build_left ? left_table : right_table;
+    sides.probe_table = sides.build_left ? right_table : left_table;
+    sides.build_col = sides.build_left ? left_column_index : right_column_index;
+    sides.probe_col = sides.build_left ? right_column_index : left_column_index;
+    sides.keep_unmatched_build = sides.build_left ? keeps_unmatched_left(join_type) : keeps_unmatched_right(join_type);
+    sides.keep_unmatched_probe = sides.build_left ? keeps_unmatched_right(join_type) : keeps_unmatched_left(join_type);
+    return sides;
+}
+
+// Build tarafinin hash tablosu girdisi: kovalar ve zincirler indeks dizileriyle
+// tutulur, satir basina node allocation yapilmaz. key == nullptr ise NULL anahtar.
+struct JoinBuildEntry {
+    size_t hash;
+    Row* row;
+    const Cell* key;
+    bool matched;
+};
+
+static size_t bucket_count_for(size_t entries) {
+    size_t bucket_count = 16;
+    while (bucket_count < entries * 2) bucket_count <<= 1;
+    return bucket_count;
 }
 
 Table* join_hash(Table* left_table, Table* right_table,
                  int left_column_index, int right_column_index,
-                 JoinType join_type) {
+                 JoinType join_type,
+                 const JoinColumns* output_columns) {
     if (!left_table || !right_table) return nullptr;
-    
-    // Hash tablosu oluştur
-    LinkedList<HashEntry*> hash_list;
-    for (auto row : left_table->getRows()) {
-        if (row->getCell(left_column_index)) {
-            hash_list.push_back(new HashEntry(row));
-        }
-    }
-    
-    // 1. Sütunları Birleştir (DÜZELTME BURADA)
-    LinkedList<std::string> res_cols;
-    LinkedList<std::string> res_types;
-    merge_columns(left_table, right_table, res_cols, res_types);
-    
-    Table* result = new Table("join_result_hash", res_cols, res_types);
-    
-    for (auto right_row : right_table->getRows()) {
-        Cell* right_cell = right_row->getCell(right_column_index);
-        if (!right_cell) continue;
-        
-        std::string key;
-        if (right_cell->getType() == CellType::INT) key = std::to_string(right_cell->getInt());
-        else if (right_cell->getType() == CellType::STRING) key = right_cell->getString();
-        else continue;
-        
-        for (auto entry : hash_list) {
-            Row* left_row = entry->row;
-            Cell* left_cell = left_row->getCell(left_column_index);
-            
-            std::string left_key;
-             if (left_cell->getType() == CellType::INT) left_key = std::to_string(left_cell->getInt());
-            else if (left_cell->getType() == CellType::STRING) left_key = left_cell->getString();
-            
-            if (left_key == key) {
-                Row* joined_row = new Row(left_row->getId());
-                
-                // Solu kopyala
-                for (auto cell : left_row->getCells()) {
-                    if (cell->getType() == CellType::INT) joined_row->addCell(cell->getInt());
-                    else if (cell->getType() == CellType::DOUBLE) joined_row->addCell(cell->getDouble());
-                    else joined_row->addCell(cell->getString());
-                }
-                // Sağı kopyala
-                for (auto cell : right_row->getCells()) {
-                    if (cell->getType() == CellType::INT) joined_row->addCell(cell->getInt());
-                    else if (cell->getType() == CellType::DOUBLE) joined_row->addCell(cell->getDouble());
-                    else joined_row->addCell(cell->getString());
+
+    JoinKeyKind kind = resolve_key_kind(left_table, left_column_index, right_table, right_column_index);
+    JoinSides sides = choose_sides(left_table, right_table, left_column_index, right_column_index, join_type);
+    std::vector<JoinMatch> matches;
+
+    // 1. Build
+    std::vector<JoinBuildEntry> entries;
+    entries.reserve(sides.build_table->getRowCount());
+    for (auto row : sides.build_table->getRows()) {
+        Cell* cell = row->getCell(sides.build_col);
+        if (!key_usable(kind, cell)) {
+            // NULL anahtarli satir hicbir seyle eslesmez, OUTER JOIN'de aynen cikar
+            if (sides.keep_unmatched_build) matches.push_back(sides.pair(row, nullptr));
+            continue;
+        }
+        entries.push_back({key_hash(kind, cell), row, cell, false});
+    }
+
+    size_t mask = bucket_count_for(entries.size()) - 1;
+    std::vector<int> heads(mask + 1, -1);
+    std::vector<int> next(entries.size(), -1);
+    for (size_t i = 0; i < entries.size(); i++) {
+        size_t b = entries[i].hash & mask;
+        next[i] = heads[b];
+        heads[b] = static_cast<int>(i);
+    }
+
+    // 2. Probe: probe tablosu morsel'ler halinde paralel taranir. Hash tablosu
+    // sadece okunur; eslesmeler ve eslesen build girdileri morsel basina
+    // toplanip morsel sirasiyla birlestirilir.
+    std::vector<Row*> probe_rows;
+    probe_rows.reserve(sides.probe_table->getRowCount());
+    for (auto row : sides.probe_table->getRows()) probe_rows.push_back(row);
+
+    size_t morsels = (probe_rows.size() + MORSEL_ROWS - 1) / MORSEL_ROWS;
+    std::vector<std::vector<JoinMatch>> morsel_matches(morsels);
+    std::vector<std::vector<int>> morsel_matched_entries(morsels);
+    ThreadPool::global().parallelMorsels(probe_rows.size(), MORSEL_ROWS, [&](size_t morsel, size_t begin, size_t end) {
+        std::vector<JoinMatch>& found = morsel_matches[morsel];
+        std::vector<int>& matched_entries = morsel_matched_entries[morsel];
+        for (size_t i = begin; i < end; i++) {
+            Row* probe_row = probe_rows[i];
+            Cell* cell = probe_row->getCell(sides.probe_col);
+            bool matched = false;
+
+            if (key_usable(kind, cell)) {
+                size_t h = key_hash(kind, cell);
+                for (int e = heads[h & mask]; e != -1; e = next[e]) {
+                    const JoinBuildEntry& entry = entries[e];
+                    if (entry.hash != h || !key_equals(kind, entry.key, cell)) continue;
+                    found.push_back(sides.pair(entry.row, probe_row));
+                    if (sides.keep_unmatched_build) matched_entries.push_back(e);
+                    matched = true;
                 }
-                result->insertRow(joined_row);
             }
+
+            if (!matched && sides.keep_unmatched_probe) found.push_back(sides.pair(nullptr, probe_row));
         }
+    });
+    for (size_t m = 0; m < morsels; m++) {
+        matches.insert(matches.end(), morsel_matches[m].begin(), morsel_matches[m].end());
+        for (int e : morsel_matched_entries[m]) entries[e].matched = true;
     }
-    
-    for (auto entry : hash_list) delete entry;
-    
-    return result;
+
+    // 3. OUTER JOIN: build tarafinda eslesmeyenler
+    if (sides.keep_unmatched_build) {
+        for (const auto& entry : entries) {
+            if (!entry.matched) matches.push_back(sides.pair(entry.row, nullptr));
+        }
+    }
+
+    return materialize_matches(left_table, right_table, "join_result_hash", matches, output_columns);
 }
 
-Table* join_execute(Table* left_table, Table* right_table,
-                    const JoinCondition& condition) {
+// Radix join: partition basina hedeflenen build satiri. Girdi + kova dizileri
+// L2 cache'e sigacak sekilde secildi (~4096 * 32 byte).
+static const size_t RADIX_PARTITION_ROWS = 4096;
+static const int RADIX_MAX_BITS = 12;
+
+// Tablonun satirlarini hash'leriyle birlikte diziye alir (paralel, parca parca)
+static std::vector<JoinBuildEntry> collect_entries(Table* table, int column_index, JoinKeyKind kind,
+                                                   ThreadPool& pool) {
+    std::vector<JoinBuildEntry> entries;
+    entries.reserve(table->getRowCount());
+    for (auto row : table->getRows()) entries.push_back({0, row, nullptr, false});
+
+    size_t chunk_count = pool.getThreadCount() * 4;
+    size_t chunk_size = (entries.size() + chunk_count - 1) / chunk_count;
+    pool.parallelFor(chunk_count, [&](size_t chunk) {
+        size_t begin = chunk * chunk_size;
+        size_t end = std::min(entries.size(), begin + chunk_size);
+        for (size_t i = begin; i < end; i++) {
+            Cell* cell = entries[i].row->getCell(column_index);
+            if (!key_usable(kind, cell)) continue;
+            entries[i].key = cell;
+            entries[i].hash = key_hash(kind, cell);
+        }
+    });
+    return entries;
+}
+
+// Girdileri hash'in ust bitlerine gore partition'lara dagitir. Once parca basina
+// histogram, sonra prefix sum ile her parcanin yazacagi yer bulunur; scatter
+// adimi kilitsiz ve paraleldir. offsets[p]..offsets[p+1] partition p'dir.
+static std::vector<JoinBuildEntry> radix_partition(const std::vector<JoinBuildEntry>& input, int bits,
+                                                   std::vector<size_t>& offsets, ThreadPool& pool) {
+    size_t partitions = static_cast<size_t>(1) << bits;
+    int shift = static_cast<int>(sizeof(size_t) * 8) - bits;
+    size_t chunk_count = pool.getThreadCount() * 4;
+    size_t chunk_size = (input.size() + chunk_count - 1) / chunk_count;
+
+    std::vector<size_t> histogram(chunk_count * partitions, 0);
+    pool.parallelFor(chunk_count, [&](size_t chunk) {
+        size_t begin = chunk * chunk_size;
+        size_t end = std::min(input.size(), begin + chunk_size);
+        size_t* hist = &histogram[chunk * partitions];
+        for (size_t i = begin; i < end; i++) {
+            if (input[i].key) hist[input[i].hash >> shift]++;
+        }
+    });
+
+    // histogram[chunk][p] -> o parcanin p partition'ina yazmaya baslayacagi konum
+    offsets.assign(partitions + 1, 0);
+    size_t pos = 0;
+    for (size_t p = 0; p < partitions; p++) {
+        offsets[p] = pos;
+        for (size_t chunk = 0; chunk < chunk_count; chunk++) {
+            size_t count = histogram[chunk * partitions + p];
+            histogram[chunk * partitions + p] = pos;
+            pos += count;
+        }
+    }
+    offsets[partitions] = pos;
+
+    std::vector<JoinBuildEntry> output(pos);
+    pool.parallelFor(chunk_count, [&](size_t chunk) {
+        size_t begin = chunk * chunk_size;
+        size_t end = std::min(input.size(), begin + chunk_size);
+        size_t* cursor = &histogram[chunk * partitions];
+        for (size_t i = begin; i < end; i++) {
+            if (input[i].key) output[cursor[input[i].hash >> shift]++] = input[i];
+        }
+    });
+    return output;
+}
+
+Table* join_radix_hash(Table* left_table, Table* right_table,
+                       int left_column_index, int right_column_index,
+                       JoinType join_type,
+                       const JoinColumns* output_columns) {
     if (!left_table || !right_table) return nullptr;
-    
-    // Kolon indexlerini bul
-    int left_col_idx = -1;
-    int idx = 0;
-    for (const auto& col : left_table->getColumns()) {
-        if (col == condition.left_column) { left_col_idx = idx; break; }
-        idx++;
+
+    JoinKeyKind kind = resolve_key_kind(left_table, left_column_index, right_table, right_column_index);
+    JoinSides sides = choose_sides(left_table, right_table, left_column_index, right_column_index, join_type);
+    ThreadPool& pool = ThreadPool::global();
+
+    std::vector<JoinBuildEntry> build_all = collect_entries(sides.build_table, sides.build_col, kind, pool);
+    std::vector<JoinBuildEntry> probe_all = collect_entries(sides.probe_table, sides.probe_col, kind, pool);
+
+    int bits = 1;
+    while (bits < RADIX_MAX_BITS && (build_all.size() >> bits) > RADIX_PARTITION_ROWS) bits++;
+    size_t partitions = static_cast<size_t>(1) << bits;
+
+    std::vector<size_t> build_offsets;
+    std::vector<size_t> probe_offsets;
+    std::vector<JoinBuildEntry> build = radix_partition(build_all, bits, build_offsets, pool);
+    std::vector<JoinBuildEntry> probe = radix_partition(probe_all, bits, probe_offsets, pool);
+
+    // Her partition kendi hash tablosunu kurar ve kendi eslesme listesine yazar
+    std::vector<std::vector<JoinMatch>> partition_matches(partitions);
+    pool.parallelFor(partitions, [&](size_t p) {
+        size_t b_begin = build_offsets[p];
+        size_t b_end = build_offsets[p + 1];
+        std::vector<JoinMatch>& out = partition_matches[p];
+
+        size_t mask = bucket_count_for(b_end - b_begin) - 1;
+        std::vector<int> heads(mask + 1, -1);
+        std::vector<int> next(b_end - b_begin, -1);
+        for (size_t i = b_begin; i < b_end; i++) {
+            size_t b = build[i].hash & mask;
+            next[i - b_begin] = heads[b];
+            heads[b] = static_cast<int>(i - b_begin);
+        }
+
+        for (size_t j = probe_offsets[p]; j < probe_offsets[p + 1]; j++) {
+            const JoinBuildEntry& probe_entry = probe[j];
+            bool matched = false;
+            for (int e = heads[probe_entry.hash & mask]; e != -1; e = next[e]) {
+                JoinBuildEntry& entry = build[b_begin + e];
+                if (entry.hash != probe_entry.hash || !key_equals(kind, entry.key, probe_entry.key)) continue;
+                out.push_back(sides.pair(entry.row, probe_entry.row));
+                entry.matched = true;
+                matched = true;
+            }
+            if (!matched && sides.keep_unmatched_probe) out.push_back(sides.pair(nullptr, probe_entry.row));
+        }
+
+        if (sides.keep_unmatched_build) {
+            for (size_t i = b_begin; i < b_end; i++) {
+                if (!build[i].matched) out.push_back(sides.pair(build[i].row, nullptr));
+            }
+        }
+    });
+
+    size_t total = 0;
+    for (const auto& part : partition_matches) total += part.size();
+    std::vector<JoinMatch> matches;
+    matches.reserve(total);
+    for (auto& part : partition_matches) {
+        matches.insert(matches.end(), part.begin(), part.end());
+        std::vector<JoinMatch>().swap(part);
     }
-    
-    int right_col_idx = -1;
-    idx = 0;
-    for (const auto& col : right_table->getColumns()) {
-        if (col == condition.right_column) { right_col_idx = idx; break; }
-        idx++;
+
+    // NULL anahtarli satirlar partition'lara girmez; OUTER JOIN'de aynen cikar
+    if (sides.keep_unmatched_build) {
+        for (const auto& entry : build_all) {
+            if (!entry.key) matches.push_back(sides.pair(entry.row, nullptr));
+        }
+    }
+    if (sides.keep_unmatched_probe) {
+        for (const auto& entry : probe_all) {
+            if (!entry.key) matches.push_back(sides.pair(nullptr, entry.row));
+        }
+    }
+
+    return materialize_matches(left_table, right_table, "join_result_radix", matches, output_columns);
+}
+
+// Grace hash join: build tarafinin hash tablosu icin bellek butcesi
+static size_t join_memory_budget = 64 * 1024 * 1024;
+static const size_t GRACE_MAX_PARTITIONS = 256;
+
+void join_set_memory_budget(size_t bytes) {
+    join_memory_budget = bytes;
+}
+
+size_t join_get_memory_budget() {
+    return join_memory_budget;
+}
+
+// Build satiri basina hash tablosu maliyeti: girdi + zincir + ~2 kova.
+// STRING anahtarlarda spill'den okunan anahtar kopyalari da eklenir
+// (ilk satirlardan ornekleyerek).
+static size_t estimate_build_bytes(Table* build_table, int build_col, JoinKeyKind kind) {
+    size_t per_row = sizeof(JoinBuildEntry) + 3 * sizeof(int);
+    if (kind == JoinKeyKind::STRING) {
+        size_t sampled = 0;
+        size_t key_bytes = 0;
+        for (auto row : build_table->getRows()) {
+            if (sampled == 64) break;
+            Cell* cell = row->getCell(build_col);
+            if (key_usable(kind, cell)) key_bytes += sizeof(std::string) + key_as_string(cell).size();
+            sampled++;
+        }
+        if (sampled > 0) per_row += key_bytes / sampled;
+    }
+    return build_table->getRowCount() * per_row;
+}
+
+// Spill dosyasindan geri okunan girdi. Anahtar degeri kopya olarak tutulur;
+// row ise bellekteki kaynak tablonun satirina referanstir.
+struct SpilledEntry {
+    size_t hash;
+    Row* row;
+    int64_t int_key;
+    double double_key;
+    std::string string_key;
+    bool matched;
+};
+
+static void spill_entry(SpillFile& file, JoinKeyKind kind, size_t hash, Row* row, const Cell* cell) {
+    file.writeUInt64(hash);
+    file.writeUInt64(reinterpret_cast<uintptr_t>(row));
+    if (kind == JoinKeyKind::INT) file.writeInt64(cell->getInt());
+    else if (kind == JoinKeyKind::DOUBLE) file.writeDouble(key_as_double(cell));
+    else file.writeString(key_as_string(cell));
+}
+
+static bool load_entry(SpillFile& file, JoinKeyKind kind, SpilledEntry& entry) {
+    uint64_t hash;
+    uint64_t row_ref;
+    if (!file.readUInt64(hash) || !file.readUInt64(row_ref)) return false;
+    entry.hash = static_cast<size_t>(hash);
+    entry.row = reinterpret_cast<Row*>(static_cast<uintptr_t>(row_ref));
+    entry.matched = false;
+    if (kind == JoinKeyKind::INT) return file.readInt64(entry.int_key);
+    if (kind == JoinKeyKind::DOUBLE) return file.readDouble(entry.double_key);
+    return file.readString(entry.string_key);
+}
+
+static bool spilled_equals(JoinKeyKind kind, const SpilledEntry& a, const SpilledEntry& b) {
+    if (kind == JoinKeyKind::INT) return a.int_key == b.int_key;
+    if (kind == JoinKeyKind::DOUBLE) return a.double_key == b.double_key;
+    return a.string_key == b.string_key;
+}
+
+// Partition secimi hash'in orta bitlerinden; kova maskesi alt bitleri kullanir
+static size_t grace_partition(size_t hash, size_t partitions) {
+    return (hash >> 24) & (partitions - 1);
+}
+
+Table* join_grace_hash(Table* left_table, Table* right_table,
+                       int left_column_index, int right_column_index,
+                       JoinType join_type,
+                       const JoinColumns* output_columns) {
+    if (!left_table || !right_table) return nullptr;
+
+    JoinKeyKind kind = resolve_key_kind(left_table, left_column_index, right_table, right_column_index);
+    JoinSides sides = choose_sides(left_table, right_table, left_column_index, right_column_index, join_type);
+
+    // Her partition'in hash tablosu butcenin yarisina sigacak kadar partition
+    size_t estimate = estimate_build_bytes(sides.build_table, sides.build_col, kind);
+    size_t partitions = 1;
+    while (partitions < GRACE_MAX_PARTITIONS && estimate / partitions > join_memory_budget / 2) partitions <<= 1;
+
+    std::vector<std::unique_ptr<SpillFile>> build_files;
+    std::vector<std::unique_ptr<SpillFile>> probe_files;
+    for (size_t p = 0; p < partitions; p++) {
+        build_files.emplace_back(new SpillFile());
+        probe_files.emplace_back(new SpillFile());
+        if (!build_files.back()->open() || !probe_files.back()->open()) {
+            std::cerr << "Hata: Grace join spill dosyalari acilamadi, bellekte hash join yapiliyor" << std::endl;
+            return join_hash(left_table, right_table, left_column_index, right_column_index, join_type,
+                             output_columns);
+        }
     }
-    
-    if (left_col_idx < 0 || right_col_idx < 0) {
-        // Basit bir fallback: Eğer parser ID=UserID dediyse ve sol tabloda ID varsa tamam.
-        // Ama bazen parser sırayı garanti edemezse burada swap denenebilir.
-        // Şimdilik strict varsayıyoruz.
+
+    std::vector<JoinMatch> matches;
+
+    // 1. Iki girdiyi de anahtar hash'ine gore partition dosyalarina dagit
+    for (auto row : sides.build_table->getRows()) {
+        Cell* cell = row->getCell(sides.build_col);
+        if (!key_usable(kind, cell)) {
+            if (sides.keep_unmatched_build) matches.push_back(sides.pair(row, nullptr));
+            continue;
+        }
+        size_t h = key_hash(kind, cell);
+        spill_entry(*build_files[grace_partition(h, partitions)], kind, h, row, cell);
+    }
+    for (auto row : sides.probe_table->getRows()) {
+        Cell* cell = row->getCell(sides.probe_col);
+        if (!key_usable(kind, cell)) {
+            if (sides.keep_unmatched_probe) matches.push_back(sides.pair(nullptr, row));
+            continue;
+        }
+        size_t h = key_hash(kind, cell);
+        spill_entry(*probe_files[grace_partition(h, partitions)], kind, h, row, cell);
+    }
+
+    // Eksik yazilmis bir partition eslesmeleri sessizce kaybettirir; kismi
+    // sonuc donmek yerine bellekte hash join'e donulur
+    for (size_t p = 0; p < partitions; p++) {
+        build_files[p]->rewind();
+        probe_files[p]->rewind();
+        if (build_files[p]->failed() || probe_files[p]->failed()) {
+            std::cerr << "Hata: Grace join partition'i diske yazilamadi, bellekte hash join yapiliyor" << std::endl;
+            return join_hash(left_table, right_table, left_column_index, right_column_index, join_type,
+                             output_columns);
+        }
+    }
+
+    // 2. Partition'lari tek tek join et; bellekte ayni anda tek build partition'i var
+    for (size_t p = 0; p < partitions; p++) {
+        SpillFile& build_file = *build_files[p];
+        SpillFile& probe_file = *probe_files[p];
+
+        std::vector<SpilledEntry> entries;
+        SpilledEntry entry;
+        while (load_entry(build_file, kind, entry)) entries.push_back(entry);
+        build_files[p].reset();
+
+        size_t mask = bucket_count_for(entries.size()) - 1;
+        std::vector<int> heads(mask + 1, -1);
+        std::vector<int> next(entries.size(), -1);
+        for (size_t i = 0; i < entries.size(); i++) {
+            size_t b = entries[i].hash & mask;
+            next[i] = heads[b];
+            heads[b] = static_cast<int>(i);
+        }
+
+        SpilledEntry probe;
+        while (load_entry(probe_file, kind, probe)) {
+            bool matched = false;
+            for (int e = heads[probe.hash & mask]; e != -1; e = next[e]) {
+                SpilledEntry& candidate = entries[e];
+                if (candidate.hash != probe.hash || !spilled_equals(kind, candidate, probe)) continue;
+                matches.push_back(sides.pair(candidate.row, probe.row));
+                candidate.matched = true;
+                matched = true;
+            }
+            if (!matched && sides.keep_unmatched_probe) matches.push_back(sides.pair(nullptr, probe.row));
+        }
+        probe_files[p].reset();
+
+        if (sides.keep_unmatched_build) {
+            for (const auto& candidate : entries) {
+                if (!candidate.matched) matches.push_back(sides.pair(candidate.row, nullptr));
+            }
+        }
+    }
+
+    return materialize_matches(left_table, right_table, "join_result_grace", matches, output_columns);
+}
+
+// Kolon tablonun id indeksleriyle (primaryIndex/bTreeIndex) aranabiliyor mu?
+static bool is_indexed_column(Table* table, int column_index) {
+    return column_index >= 0 && table->getKeyColumnIndex() == column_index;
+}
+
+// Indekse sorulabilecek tamsayi anahtar; INT ya da tam degerli DOUBLE olmali
+static bool index_probe_key(const Cell* cell, int& key) {
+    if (!cell || cell->isNull()) return false;
+    if (cell->getType() == CellType::INT) {
+        key = cell->getInt();
+        return true;
+    }
+    if (cell->getType() == CellType::DOUBLE) {
+        double d = cell->getDouble();
+        // NaN, sonsuz ve int disi degerler int'e cevrilemez (tanimsiz davranis)
+        if (!std::isfinite(d) || d < static_cast<double>(INT_MIN) || d > static_cast<double>(INT_MAX)) return false;
+        if (d != static_cast<double>(static_cast<int>(d))) return false;
+        key = static_cast<int>(d);
+        return true;
+    }
+    return false;
+}
+
+Table* join_index_nested_loop(Table* left_table, Table* right_table,
+                              int left_column_index, int right_column_index,
+                              JoinType join_type,
+                              const JoinColumns* output_columns) {
+    if (!left_table || !right_table) return nullptr;
+
+    // Tercihen sag tablonun indeksi kullanilir; yoksa roller degisir
+    bool probe_right = is_indexed_column(right_table, right_column_index);
+    if (!probe_right && !is_indexed_column(left_table, left_column_index)) return nullptr;
+
+    Table* outer_table = probe_right ? left_table : right_table;
+    Table* inner_table = probe_right ? right_table : left_table;
+    int outer_col = probe_right ? left_column_index : right_column_index;
+    bool keep_unmatched_outer = probe_right ? keeps_unmatched_left(join_type) : keeps_unmatched_right(join_type);
+    bool keep_unmatched_inner = probe_right ? keeps_unmatched_right(join_type) : keeps_unmatched_left(join_type);
+    auto pair = [probe_right](Row* outer_row, Row* inner_row) {
+        return probe_right ? JoinMatch{outer_row, inner_row} : JoinMatch{inner_row, outer_row};
+    };
+
+    std::vector<JoinMatch> matches;
+    std::unordered_set<Row*> inner_matched;
+
+    for (auto outer_row : outer_table->getRows()) {
+        int key;
+        Row* found = nullptr;
+        if (index_probe_key(outer_row->getCell(outer_col), key)) found = inner_table->getRowById(key);
+
+        if (found) {
+            matches.push_back(pair(outer_row, found));
+            if (keep_unmatched_inner) inner_matched.insert(found);
+        } else if (keep_unmatched_outer) {
+            matches.push_back(pair(outer_row, nullptr));
+        }
+    }
+
+    if (keep_unmatched_inner) {
+        for (auto inner_row : inner_table->getRows()) {
+            if (inner_matched.find(inner_row) == inner_matched.end()) matches.push_back(pair(nullptr, inner_row));
+        }
+    }
+
+    return materialize_matches(left_table, right_table, "join_result_index_nl", matches, output_columns);
+}
+
+Table* join_sort_merge(Table* left_table, Table* right_table,
+                       int left_column_index, int right_column_index,
+                       JoinType join_type,
+                       const JoinColumns* output_columns) {
+    if (!left_table || !right_table) return nullptr;
+    if (!is_indexed_column(left_table, left_column_index) || !is_indexed_column(right_table, right_column_index)) {
         return nullptr;
     }
-    
+
+    // Iki taraf da B+ tree'de anahtara gore sirali ve tekil; yaprak seviyeleri birlestirilir
+    idx::ConcurrentBPlusTree::Cursor l(left_table->getBTree());
+    idx::ConcurrentBPlusTree::Cursor r(right_table->getBTree());
+    l.seek(INT_MIN);
+    r.seek(INT_MIN);
+    bool keep_left = keeps_unmatched_left(join_type);
+    bool keep_right = keeps_unmatched_right(join_type);
+    std::vector<JoinMatch> matches;
+
+    while (l.valid() && r.valid()) {
+        if (l.key() == r.key()) {
+            matches.push_back({l.row(), r.row()});
+            l.next();
+            r.next();
+        } else if (l.key() < r.key()) {
+            if (keep_left) matches.push_back({l.row(), nullptr});
+            l.next();
+        } else {
+            if (keep_right) matches.push_back({nullptr, r.row()});
+            r.next();
+        }
+    }
+    for (; keep_left && l.valid(); l.next()) matches.push_back({l.row(), nullptr});
+    for (; keep_right && r.valid(); r.next()) matches.push_back({nullptr, r.row()});
+
+    return materialize_matches(left_table, right_table, "join_result_merge", matches, output_columns);
+}
+
+// Bu toplam satir sayisinin ustunde join_execute radix join'i secer
+static const size_t RADIX_JOIN_MIN_ROWS = 100000;
+
+// Join kolonlarinin sirasi. Sol taraf FROM tablosunun kendisiyse kolonlari
+// niteliksizdir: "ad.kolon" o tablonun "kolon"udur.
+static bool resolve_join_columns(Table* left_table, Table* right_table, const JoinCondition& condition,
+                                 const std::string& left_alias, int& left_col_idx, int& right_col_idx,
+                                 bool report) {
+    left_col_idx = query_bind_column(left_table, condition.left_column);
+    if (left_col_idx == -1 && !left_alias.empty() &&
+        condition.left_column.compare(0, left_alias.size() + 1, left_alias + ".") == 0) {
+        left_col_idx = query_bind_column(left_table, condition.left_column.substr(left_alias.size() + 1));
+    }
+    right_col_idx = query_bind_column(right_table, condition.right_column);
+    if (report && left_col_idx == -1) {
+        std::cerr << "Hata: JOIN kolonu bulunamadi: " << condition.left_column << std::endl;
+    }
+    if (report && right_col_idx == -1) {
+        std::cerr << "Hata: JOIN kolonu bulunamadi: " << condition.right_column << std::endl;
+    }
+    return left_col_idx >= 0 && right_col_idx >= 0;
+}
+
+bool join_can_use_index(Table* left_table, Table* right_table, const JoinCondition& condition,
+                        const std::string& left_alias) {
+    if (!right_table) return false;
+    int left_col_idx, right_col_idx;
+    if (!left_table) {
+        // Ara join sonucu: indeksi yok, kolon tipi bilinmez
+        right_col_idx = query_bind_column(right_table, condition.right_column);
+        return is_indexed_column(right_table, right_col_idx);
+    }
+    if (!resolve_join_columns(left_table, right_table, condition, left_alias, left_col_idx, right_col_idx, false)) {
+        return false;
+    }
+    if (resolve_key_kind(left_table, left_col_idx, right_table, right_col_idx) == JoinKeyKind::STRING) return false;
+    return is_indexed_column(left_table, left_col_idx) || is_indexed_column(right_table, right_col_idx);
+}
+
+Table* join_execute(Table* left_table, Table* right_table,
+                    const JoinCondition& condition,
+                    const JoinColumns* output_columns) {
+    if (!left_table || !right_table) return nullptr;
+
+    int left_col_idx, right_col_idx;
+    const std::string left_alias = output_columns ? output_columns->left_alias : "";
+    if (!resolve_join_columns(left_table, right_table, condition, left_alias, left_col_idx, right_col_idx, true)) {
+        return nullptr;
+    }
+
+    // Join kolonlari id indeksliyse hicbir sey kurmadan indeksler kullanilir:
+    // iki taraf da indeksliyse yaprak zincirleri birlestirilir, tek taraf
+    // indeksliyse o tarafin HashIndex'i probe edilir.
+    bool typed_key = resolve_key_kind(left_table, left_col_idx, right_table, right_col_idx) != JoinKeyKind::STRING;
+    bool left_indexed = typed_key && is_indexed_column(left_table, left_col_idx);
+    bool right_indexed = typed_key && is_indexed_column(right_table, right_col_idx);
+    if (left_indexed && right_indexed) {
+        return join_sort_merge(left_table, right_table, left_col_idx, right_col_idx, condition.join_type, output_columns);
+    }
+    if (left_indexed || right_indexed) {
+        return join_index_nested_loop(left_table, right_table, left_col_idx, right_col_idx, condition.join_type, output_columns);
+    }
+
     // Küçük tablolar için Nested Loop, büyükler için Hash Join (Proje kuralı olabilir)
     // Burada basitlik adına threshold koyuyoruz
-    if (left_table->getRowCount() < 100 && right_table->getRowCount() < 100) {
-        return join_nested_loop(left_table, right_table, left_col_idx, right_col_idx, condition.join_type);
-    } else {
-        return join_hash(left_table, right_table, left_col_idx, right_col_idx, condition.join_type);
+    size_t left_rows = left_table->getRowCount();
+    size_t right_rows = right_table->getRowCount();
+    if (left_rows < 100 && right_rows < 100) {
+        return join_nested_loop(left_table, right_table, left_col_idx, right_col_idx, condition.join_type, output_columns);
     }
-}
\ No newline at end of file
+    // Build tarafinin hash tablosu bellek butcesini asiyorsa diske partition'la
+    JoinSides sides = choose_sides(left_table, right_table, left_col_idx, right_col_idx, condition.join_type);
+    JoinKeyKind kind = resolve_key_kind(left_table, left_col_idx, right_table, right_col_idx);
+    if (estimate_build_bytes(sides.build_table, sides.build_col, kind) > join_memory_budget) {
+        return join_grace_hash(left_table, right_table, left_col_idx, right_col_idx, condition.join_type, output_columns);
+    }
+    // Girdiler cache'i tasiyorsa ve birden fazla cekirdek varsa partition'li paralel join
+    if (left_rows + right_rows >= RADIX_JOIN_MIN_ROWS && ThreadPool::global().getThreadCount() > 1) {
+        return join_radix_hash(left_table, right_table, left_col_idx, right_col_idx, condition.join_type, output_columns);
+    }
+    return join_hash(left_table, right_table, left_col_idx, right_col_idx, condition.join_type, output_columns);
+}
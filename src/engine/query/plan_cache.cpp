@@ -0,0 +1,154 @@
+#include "../../../include/engine/query/plan_cache.hpp"
+#include "../../../include/engine/query/query_lexer.hpp"
+#include "../../../include/engine/query/query_parser.hpp"
+#include <cctype>
+#include <cstdlib>
+
+std::string query_normalize(const std::string& query_string) {
+    std::string out;
+    out.reserve(query_string.size());
+
+    QueryLexer lexer(query_string);
+    bool after_semicolon = false;
+    Token next;
+    for (Token token = lexer.next(); token.type != TokenType::END; token = next) {
+        next = lexer.next();
+        // Gecersiz token'da parse zaten hata verecek; metni oldugu gibi birak
+        if (token.type == TokenType::INVALID) return query_string;
+        // Sadece sondaki tek ';' atilir; aradaki ya da tekrarlanan ';'
+        // parser'a ulasir ve sorgu reddedilir
+        bool semicolon = token.type == TokenType::SEMICOLON;
+        bool skip = semicolon && next.type == TokenType::END && !after_semicolon;
+        after_semicolon = semicolon;
+        if (skip) continue;
+
+        if (!out.empty()) out.push_back(' ');
+        if (token.type == TokenType::KEYWORD) {
+            for (size_t i = 0; i < token.length; i++) {
+                out.push_back(static_cast<char>(std::toupper(static_cast<unsigned char>(token.start[i]))));
+            }
+        } else if (token.type == TokenType::STRING) {
+            char quote = token.start[-1];  // '' ya da "" kacisi icerik icinde aynen kalir
+            out.push_back(quote);
+            out.append(token.start, token.length);
+            out.push_back(quote);
+        } else {
+            out.append(token.start, token.length);
+        }
+    }
+    return out;
+}
+
+PlanCache::PlanCache(size_t capacity) : capacity(capacity == 0 ? 1 : capacity), hits(0), misses(0) {}
+
+QueryPlan PlanCache::get(const std::string& query_string) {
+    std::string key = query_normalize(query_string);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::list<Entry>::iterator* found = index.find(key);
+        if (found) {
+            lru.splice(lru.begin(), lru, *found);
+            hits++;
+            return (*found)->plan;
+        }
+        misses++;
+    }
+
+    // Parse kilit disinda; ayni sorgu ayni anda iki kez parse edilirse
+    // ikincisi onbellekteki kaydi kullanir.
+    Query* query = query_parse(key);
+    if (!query) return nullptr;
+    QueryPlan plan(query, [](const Query* q) { query_destroy(const_cast<Query*>(q)); });
+
+    std::lock_guard<std::mutex> lock(mutex);
+    std::list<Entry>::iterator* found = index.find(key);
+    if (found) {
+        lru.splice(lru.begin(), lru, *found);
+        return (*found)->plan;
+    }
+    lru.push_front(Entry{key, plan});
+    index[key] = lru.begin();
+    if (lru.size() > capacity) {
+        index.erase(lru.back().key);
+        lru.pop_back();
+    }
+    return plan;
+}
+
+void PlanCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    lru.clear();
+    index.clear();
+}
+
+size_t PlanCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return lru.size();
+}
+
+size_t PlanCache::getHits() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return hits;
+}
+
+size_t PlanCache::getMisses() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return misses;
+}
+
+PlanCache& PlanCache::global() {
+    static PlanCache cache;
+    return cache;
+}
+
+PreparedStatements::PreparedStatements() : nextId(1) {}
+
+int PreparedStatements::add(const QueryPlan& plan) {
+    std::lock_guard<std::mutex> lock(mutex);
+    int id = nextId++;
+    statements[id] = plan;
+    return id;
+}
+
+QueryPlan PreparedStatements::get(int id) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto found = statements.find(id);
+    return found == statements.end() ? nullptr : found->second;
+}
+
+bool PreparedStatements::remove(int id) {
+    std::lock_guard<std::mutex> lock(mutex);
+    return statements.erase(id) > 0;
+}
+
+PreparedStatements& PreparedStatements::global() {
+    static PreparedStatements statements;
+    return statements;
+}
+
+QueryParam query_param_from_string(const std::string& value) {
+    QueryParam param;
+    param.type = LiteralType::STRING;
+    param.number = 0;
+
+    if (value.size() >= 2 && (value.front() == '\'' || value.front() == '"') && value.back() == value.front()) {
+        param.text = value.substr(1, value.size() - 2);
+        return param;
+    }
+    if (value == "NULL" || value == "null") {
+        param.type = LiteralType::NULL_VALUE;
+        return param;
+    }
+
+    param.text = value;
+    if (!value.empty()) {
+        char* end = nullptr;
+        double number = std::strtod(value.c_str(), &end);
+        if (end == value.c_str() + value.size()) {
+            param.type = LiteralType::NUMBER;
+            param.number = number;
+        }
+    }
+    return param;
+}
@@ -0,0 +1,156 @@
+#include "../../../include/engine/query/query_binder.hpp"
+#include <iostream>
+
+// Kolon tipleri bir kez vektore acilir; adlar tablonun kolon indeksinden
+// bulunur, baglama sirasinda liste bastan yurunmez.
+struct Schema {
+    Table* table;
+    std::vector<CellType> types;
+
+    explicit Schema(Table* table) : table(table) {
+        auto type_it = table->getTypes().begin();
+        for (size_t i = 0; i < table->getColumns().size(); i++) {
+            bool has_type = type_it != table->getTypes().end();
+            types.push_back(has_type ? column_type_from_string(*type_it) : CellType::STRING);
+            if (has_type) ++type_it;
+        }
+    }
+
+    int find(const std::string& name) const {
+        return query_bind_column(table, name);
+    }
+};
+
+CellType column_type_from_string(const std::string& type) {
+    if (type == "INT") return CellType::INT;
+    if (type == "DOUBLE") return CellType::DOUBLE;
+    return CellType::STRING;
+}
+
+int query_bind_column(Table* table, const std::string& column_name) {
+    if (!table) return -1;
+    int index = table->getColumnIndex(column_name);
+    if (index >= 0 || column_name.find('.') != std::string::npos) return index;
+
+    // Join sonucunun kolonlari "ad.kolon"; niteliksiz ad tek birine uymali
+    std::string suffix = "." + column_name;
+    int position = 0;
+    for (const auto& column : table->getColumns()) {
+        if (column.size() > suffix.size() && column.compare(column.size() - suffix.size(), suffix.size(), suffix) == 0) {
+            if (index >= 0) {
+                std::cerr << "Hata: Kolon adi belirsiz, tablo adiyla nitelenmeli: " << column_name << std::endl;
+                return COLUMN_AMBIGUOUS;
+            }
+            index = position;
+        }
+        position++;
+    }
+    return index;
+}
+
+static BoundExpr* bind_literal(LiteralType type, double number, const std::string& text) {
+    BoundExpr* bound = new BoundExpr(ExprKind::LITERAL);
+    if (type == LiteralType::NUMBER) {
+        bound->value_type = CellType::DOUBLE;
+        bound->number = number;
+    } else if (type == LiteralType::STRING) {
+        bound->value_type = CellType::STRING;
+    }
+    bound->text = text;
+    return bound;
+}
+
+static BoundExpr* bind_node(const Expr* expr, const Schema& schema, const QueryParams* params) {
+    if (!expr) return nullptr;
+
+    switch (expr->kind) {
+        case ExprKind::COLUMN: {
+            int index = schema.find(expr->columnRef());
+            if (index < 0) {
+                if (index != COLUMN_AMBIGUOUS) std::cerr << "Hata: Kolon bulunamadi: " << expr->columnRef() << std::endl;
+                return nullptr;
+            }
+            BoundExpr* bound = new BoundExpr(ExprKind::COLUMN);
+            bound->column_index = index;
+            bound->value_type = schema.types[index];
+            bound->dictionary = schema.table->getDictionary(index);
+            return bound;
+        }
+        case ExprKind::LITERAL: {
+            BoundExpr* bound = bind_literal(expr->literal_type, expr->number, expr->text);
+            if (expr->literal_type == LiteralType::NUMBER && expr->is_integer) bound->value_type = CellType::INT;
+            return bound;
+        }
+        case ExprKind::PARAMETER: {
+            if (!params || expr->param_index >= static_cast<int>(params->size())) {
+                return bind_literal(LiteralType::NULL_VALUE, 0, "");
+            }
+            const QueryParam& param = (*params)[expr->param_index];
+            return bind_literal(param.type, param.number, param.text);
+        }
+        default:
+            break;
+    }
+
+    BoundExpr* bound = new BoundExpr(expr->kind);
+    bound->op = expr->op;
+    bound->arith_op = expr->arith_op;
+    bound->negated = expr->negated;
+    bound->left = bind_node(expr->left, schema, params);
+    bound->right = bind_node(expr->right, schema, params);
+    bool failed = (expr->left && !bound->left) || (expr->right && !bound->right);
+    for (auto item : expr->list) {
+        if (failed) break;
+        BoundExpr* bound_item = bind_node(item, schema, params);
+        if (!bound_item) failed = true;
+        else bound->list.push_back(bound_item);
+    }
+    // Alt ifadelerden biri baglanamadiysa butun ifade baglanamaz
+    if (failed) {
+        delete bound;
+        return nullptr;
+    }
+    return bound;
+}
+
+BoundExpr* query_bind_expr(const Expr* expr, Table* table, const QueryParams* params) {
+    if (!expr || !table) return nullptr;
+    Schema schema(table);
+    return bind_node(expr, schema, params);
+}
+
+BoundProjection query_bind_projection(Table* table, const LinkedList<std::string>& column_names) {
+    BoundProjection projection;
+    if (!table) return projection;
+
+    Schema schema(table);
+    auto type_it = table->getTypes().begin();
+    std::vector<const std::string*> type_names;
+    for (; type_it != table->getTypes().end(); ++type_it) type_names.push_back(&*type_it);
+
+    auto add = [&](int index, const std::string& name) {
+        projection.indices.push_back(index);
+        projection.columns.push_back(name);
+        projection.types.push_back(static_cast<size_t>(index) < type_names.size() ? *type_names[index] : "STRING");
+    };
+    for (const auto& target : column_names) {
+        // "*" butun kolonlar, "ad.*" join sonucunda o tablonun kolonlari
+        if (target == "*" || (target.size() > 2 && target.compare(target.size() - 2, 2, ".*") == 0)) {
+            std::string prefix = target.substr(0, target.size() - 1);
+            int index = 0;
+            for (const auto& column : table->getColumns()) {
+                if (target == "*" || column.compare(0, prefix.size(), prefix) == 0) add(index, column);
+                index++;
+            }
+            continue;
+        }
+        int index = schema.find(target);
+        if (index < 0) {
+            if (index != COLUMN_AMBIGUOUS) std::cerr << "Hata: Kolon bulunamadi: " << target << std::endl;
+            projection.failed = true;
+            continue;
+        }
+        add(index, target);
+    }
+    return projection;
+}
@@ -4,52 +4,149 @@
  */
 #include "../../../include/engine/query/query_engine.hpp"
 #include "../../../include/engine/query/join_engine.hpp"
+#include "../../../include/engine/query/query_binder.hpp"
+#include "../../../include/engine/query/expr_compiler.hpp"
+#include "../../../include/engine/query/query_optimizer.hpp"
+#include "../../../include/engine/query/sort_engine.hpp"
+#include "../../../include/engine/query/aggregate_engine.hpp"
+#include "../../../include/engine/query/shard_engine.hpp"
 #include "../../../include/core/Table.hpp"
 #include "../../../include/core/Row.hpp"
 #include "../../../include/core/Cell.hpp"
+#include "../../../include/core/Mvcc.hpp"
+#include "../../../include/utils/Epoch.hpp"
+#include "../../../include/utils/ThreadPool.hpp"
 #include <algorithm>
+#include <climits>
+#include <cstdlib>
 #include <iostream>
+#include <memory>
 #include <string>
+#include <vector>
 
 Database::Database() {}
-Database::~Database() {}
+
+Database::~Database() {
+    for (auto& entry : tables) {
+        table_stats_forget(entry.value);
+        delete entry.value;
+    }
+    for (auto& entry : shardedTables) delete entry.value;
+    for (auto& retired : retiredTables) delete retired.second;
+}
 
 int Database::addTable(Table* table) {
     if (!table) return -1;
+    std::lock_guard<std::mutex> lock(mutex);
+    if (tables.contains(table->getName()) || shardedTables.contains(table->getName())) return -1;
     tables.insert(table->getName(), table);
     return 0;
 }
 
+int Database::addShardedTable(ShardedTable* table) {
+    if (!table) return -1;
+    std::lock_guard<std::mutex> lock(mutex);
+    if (tables.contains(table->getName()) || shardedTables.contains(table->getName())) return -1;
+    shardedTables.insert(table->getName(), table);
+    return 0;
+}
+
+void Database::replaceTable(Table* table) {
+    if (!table) return;
+    std::lock_guard<std::mutex> lock(mutex);
+    Table*& slot = tables[table->getName()];
+    if (slot && slot != table) {
+        table_stats_forget(slot);
+        retiredTables.emplace_back(Mvcc::nextVersion(), slot);
+    }
+    slot = table;
+    collectRetired();
+}
+
+bool Database::dropTable(const std::string& table_name) {
+    ShardedTable* sharded = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ShardedTable** found = shardedTables.find(table_name);
+        if (found) {
+            sharded = *found;
+            shardedTables.erase(table_name);
+        }
+    }
+    if (sharded) {
+        // Worker'lar kapanirken katalog kilidi tutulmaz
+        delete sharded;
+        return true;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    Table** found = tables.find(table_name);
+    if (!found) return false;
+    table_stats_forget(*found);
+    retiredTables.emplace_back(Mvcc::nextVersion(), *found);
+    tables.erase(table_name);
+    collectRetired();
+    return true;
+}
+
+size_t Database::collectRetired() {
+    uint64_t oldest = Mvcc::oldestSnapshot();
+    size_t kept = 0;
+    size_t freed = 0;
+    for (auto& retired : retiredTables) {
+        if (retired.first <= oldest) {
+            delete retired.second;
+            freed++;
+        } else {
+            retiredTables[kept++] = retired;
+        }
+    }
+    retiredTables.resize(kept);
+    return freed;
+}
+
+size_t Database::collectGarbage() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return collectRetired();
+}
+
 Table* Database::getTable(const std::string& table_name) {
+    std::lock_guard<std::mutex> lock(mutex);
     Table** found = tables.find(table_name);
     return found ? *found : nullptr;
 }
 
-LinkedList<std::string> Database::getTableNames() const {
-    LinkedList<std::string> names;
-    for (auto it = tables.begin(); it != tables.end(); ++it) names.push_back((*it).key);
-    return names;
+ShardedTable* Database::getShardedTable(const std::string& table_name) {
+    std::lock_guard<std::mutex> lock(mutex);
+    ShardedTable** found = shardedTables.find(table_name);
+    return found ? *found : nullptr;
 }
 
-static int get_column_index_by_name(Table* table, const std::string& column_name) {
-    if (!table) return -1;
-    int index = 0;
-    for (const auto& col : table->getColumns()) {
-        if (col == column_name) return index;
-        index++;
+size_t Database::getTableCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return tables.size() + shardedTables.size();
+}
+
+LinkedList<std::string> Database::getTableNames() const {
+    std::vector<std::string> sorted;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        sorted.reserve(tables.size() + shardedTables.size());
+        for (const auto& entry : tables) sorted.push_back(entry.key);
+        for (const auto& entry : shardedTables) sorted.push_back(entry.key);
     }
-    return -1;
+    std::sort(sorted.begin(), sorted.end());
+    LinkedList<std::string> names;
+    for (const auto& name : sorted) names.push_back(name);
+    return names;
 }
 
 // 1. Sayısal karşılaştırma desteği
-static bool evaluate_condition(Row* row, const QueryCondition& condition, Table* table) {
-    if (!row || !table) return false;
-    
-    int col_idx = get_column_index_by_name(table, condition.column_name);
-    if (col_idx < 0) return false;
+static bool evaluate_condition(Row* row, const QueryCondition& condition, int col_idx) {
+    if (!row || col_idx < 0) return false;
     
     Cell* cell = row->getCell(col_idx);
-    if (!cell) return false;
+    if (!cell || cell->isNull()) return false;
     
     std::string cell_val_str;
     if (cell->getType() == CellType::INT) cell_val_str = std::to_string(cell->getInt());
@@ -78,76 +175,162 @@ static bool evaluate_condition(Row* row, const QueryCondition& condition, Table*
     }
 }
 
+static std::vector<Row*> table_rows(Table* table) {
+    std::vector<Row*> rows;
+    rows.reserve(table->getRowCount());
+    for (auto row : table->getRows()) rows.push_back(row);
+    return rows;
+}
+
+static std::vector<Row*> row_vector(const LinkedList<Row*>& rows) {
+    std::vector<Row*> out;
+    out.reserve(rows.size());
+    for (auto row : rows) out.push_back(row);
+    return out;
+}
+
+static const std::vector<Row*>& row_vector(const std::vector<Row*>& rows) {
+    return rows;
+}
+
+static Row* copy_row(Row* row) {
+    Row* new_row = new Row(row->getId());
+    for (auto cell : row->getCells()) new_row->addCopy(cell);
+    return new_row;
+}
+
+// Morsel-driven tarama: satirlar MORSEL_ROWS'luk parcalar halinde havuzda
+// islenir. Once keep ile eslesen kaynak satirlar secilir, sonra secilenlerin
+// cikti satirlari (make_row) yine paralel uretilir ve girdi sirasiyla
+// tabloya eklenir; Table thread-safe olmadigi icin ekleme tek thread'dedir.
+//
+// limit >= 0 ise ilk offset eslesme atlanir, offset + limit eslesme
+// bulununca tarama durur: morsel'ler thread sayisi kadarlik dalgalarla
+// taranir ve yeterli satir birikince sonraki dalga baslamaz. Atlanan ve
+// fazla bulunan satirlar kopyalanmaz.
+template <typename Keep, typename MakeRow>
+static void scan_into(Table* result, const std::vector<Row*>& rows, Keep keep, MakeRow make_row,
+                      int limit = -1, int offset = 0) {
+    ThreadPool& pool = ThreadPool::global();
+    size_t morsels = (rows.size() + MORSEL_ROWS - 1) / MORSEL_ROWS;
+    size_t need = limit >= 0 ? static_cast<size_t>(limit) + static_cast<size_t>(offset) : rows.size();
+    size_t wave = limit >= 0 ? std::max<size_t>(1, pool.getThreadCount()) : std::max<size_t>(1, morsels);
+
+    std::vector<std::vector<Row*>> selected(morsels);
+    std::vector<Row*> chosen;
+    size_t found = 0;
+    for (size_t first = 0; first < morsels && found < need; first += wave) {
+        size_t last = std::min(morsels, first + wave);
+        size_t base = first * MORSEL_ROWS;
+        size_t count = std::min(rows.size(), last * MORSEL_ROWS) - base;
+        pool.parallelMorsels(count, MORSEL_ROWS, [&](size_t morsel, size_t begin, size_t end) {
+            // Tek morsel'in need satiri yeterli: daha oncekiler sirada one gecer
+            std::vector<Row*>& out = selected[first + morsel];
+            for (size_t i = base + begin; i < base + end && out.size() < need; i++) {
+                if (keep(rows[i])) out.push_back(rows[i]);
+            }
+        });
+        for (size_t m = first; m < last; m++) {
+            for (auto row : selected[m]) {
+                if (found >= need) break;
+                if (found++ >= static_cast<size_t>(offset)) chosen.push_back(row);
+            }
+            std::vector<Row*>().swap(selected[m]);
+        }
+    }
+
+    std::vector<Row*> built(chosen.size(), nullptr);
+    pool.parallelMorsels(chosen.size(), MORSEL_ROWS, [&](size_t, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) built[i] = make_row(chosen[i]);
+    });
+    for (auto row : built) result->insertRow(row);
+}
+
+// Kucuk LIMIT icin seri tarama: satir listesi vektore bile alinmaz, ilk
+// offset + limit eslesme bulununca durulur
+template <typename RowRange, typename Keep>
+static void scan_first_into(Table* result, const RowRange& rows, Keep keep, int limit, int offset) {
+    int found = 0;
+    for (Row* row : rows) {
+        if (found >= limit + offset) break;
+        if (!keep(row)) continue;
+        if (found++ < offset) continue;
+        result->insertRow(copy_row(row));
+    }
+}
+
 // 2. Filtreleme fonksiyonu
 Table* query_apply_where(Table* table, const LinkedList<QueryCondition>& conditions) {
     if (!table || conditions.empty()) return table;
     
+    // Kolon sira numaralari satir dongusunden once bir kez bulunur
+    std::vector<int> col_indices;
+    for (const auto& cond : conditions) col_indices.push_back(query_bind_column(table, cond.column_name));
+
     Table* result = new Table(table->getName() + "_filtered", table->getColumns(), table->getTypes());
-    
-    for (auto row : table->getRows()) {
-        bool matches = true;
+
+    auto keep = [&](Row* row) {
+        size_t i = 0;
         for (const auto& cond : conditions) {
-            if (!evaluate_condition(row, cond, table)) {
-                matches = false;
-                break;
-            }
-        }
-        
-        if (matches) {
-            Row* new_row = new Row(row->getId());
-            for (auto cell : row->getCells()) {
-                if (cell->getType() == CellType::INT) new_row->addCell(cell->getInt());
-                else if (cell->getType() == CellType::DOUBLE) new_row->addCell(cell->getDouble());
-                else new_row->addCell(cell->getString());
-            }
-            result->insertRow(new_row);
+            if (!evaluate_condition(row, cond, col_indices[i++])) return false;
         }
+        return true;
+    };
+    scan_into(result, table_rows(table), keep, copy_row);
+    return result;
+}
+
+// Satirlari derlenmis WHERE ile suzup eslesenlerin kopyasini yeni tabloya koyar.
+// Kolonlar ve parametreler tablo basina bir kez baglanir, ifade kolon
+// tiplerine gore ozellesmis kernellere derlenir. limit >= 0 ise ilk offset
+// eslesmeyi atlar ve limit kadar satir bulununca durur.
+template <typename RowRange>
+static Table* filter_rows(Table* table, const RowRange& rows, const Expr* where, const QueryParams* params,
+                          int limit = -1, int offset = 0) {
+    BoundExpr* bound = query_bind_expr(where, table, params);
+    CompiledPredicate predicate(bound);
+    Table* result = new Table(table->getName() + "_filtered", table->getColumns(), table->getTypes());
+
+    auto keep = [&](Row* row) { return predicate.matches(row); };
+    if (limit >= 0 && static_cast<size_t>(limit) + offset <= MORSEL_ROWS) {
+        scan_first_into(result, rows, keep, limit, offset);
+    } else {
+        scan_into(result, row_vector(rows), keep, copy_row, limit, offset);
     }
+    delete bound;
     return result;
 }
 
+// WHERE agacinin tamamiyla filtreleme (AND/OR/NOT, IN, LIKE, aritmetik)
+Table* query_apply_where_expr(Table* table, const Expr* where, const QueryParams* params, int limit, int offset) {
+    if (!table || !where) return table;
+    return filter_rows(table, table->getRows(), where, params, limit, offset);
+}
+
+// WHERE agacinda gecen kolon isimleri (join projection pushdown icin)
+static void collect_expr_columns(const Expr* expr, LinkedList<std::string>& columns) {
+    if (!expr) return;
+    if (expr->kind == ExprKind::COLUMN) columns.push_back(expr->columnRef());
+    collect_expr_columns(expr->left, columns);
+    collect_expr_columns(expr->right, columns);
+    for (auto item : expr->list) collect_expr_columns(item, columns);
+}
+
 // 3. Sütun seçimi (Projection)
 Table* query_apply_select(Table* table, const LinkedList<std::string>& column_names) {
     if (!table || column_names.empty()) return table;
 
-    LinkedList<int> col_indices;
-    LinkedList<std::string> new_col_names;
-    LinkedList<std::string> new_col_types;
-
-    const auto& all_cols = table->getColumns();
-    const auto& all_types = table->getTypes();
-
-    for (const auto& target : column_names) {
-        int idx = 0;
-        auto type_it = all_types.begin();
-        for (const auto& col : all_cols) {
-            if (col == target) {
-                col_indices.push_back(idx);
-                new_col_names.push_back(col);
-                new_col_types.push_back(*type_it);
-                break;
-            }
-            idx++;
-            ++type_it;
-        }
-    }
-
-    if (col_indices.empty()) return table;
+    BoundProjection projection = query_bind_projection(table, column_names);
+    if (projection.indices.empty()) return table;
 
-    Table* result = new Table("Projected_Result", new_col_names, new_col_types);
+    Table* result = new Table("Projected_Result", projection.columns, projection.types);
 
-    for (auto row : table->getRows()) {
+    auto keep = [](Row*) { return true; };
+    scan_into(result, table_rows(table), keep, [&](Row* row) {
         Row* new_row = new Row(row->getId());
-        for (int idx : col_indices) {
-            Cell* old_cell = row->getCell(idx);
-            if (old_cell) {
-                if (old_cell->getType() == CellType::INT) new_row->addCell(old_cell->getInt());
-                else if (old_cell->getType() == CellType::DOUBLE) new_row->addCell(old_cell->getDouble());
-                else new_row->addCell(old_cell->getString());
-            }
-        }
-        result->insertRow(new_row);
-    }
+        for (int idx : projection.indices) new_row->addCopy(row->getCell(idx));
+        return new_row;
+    });
     return result;
 }
 
@@ -164,11 +347,7 @@ Table* query_apply_limit(Table* table, int limit, int offset) {
         if (limit >= 0 && taken >= limit) break;
 
         Row* new_row = new Row(row->getId());
-        for (auto cell : row->getCells()) {
-             if (cell->getType() == CellType::INT) new_row->addCell(cell->getInt());
-             else if (cell->getType() == CellType::DOUBLE) new_row->addCell(cell->getDouble());
-             else new_row->addCell(cell->getString());
-        }
+        for (auto cell : row->getCells()) new_row->addCopy(cell);
         result->insertRow(new_row);
         taken++;
         current++;
@@ -176,14 +355,52 @@ Table* query_apply_limit(Table* table, int limit, int offset) {
     return result;
 }
 
-Table* query_apply_order_by(Table* table, const LinkedList<std::string>& column_names, bool ascending) {
-    return table; // Basitlik için pass geçiyoruz
+Table* query_apply_order_by(Table* table, const LinkedList<OrderByColumn>& order_by, long long limit) {
+    return sort_table(table, order_by, limit);
+}
+
+static bool is_aggregate_output(const Query* query, const std::string& name) {
+    for (const auto& aggregate : query->aggregates) {
+        if (aggregate.output_name == name) return true;
+    }
+    return false;
+}
+
+// SELECT, GROUP BY, toplama ve ORDER BY kolonlari (join sonrasi) tabloda
+// tek bir kolona uymali; ORDER BY toplama sonucunun adini da kullanabilir
+static bool check_columns(Table* table, const Query* query) {
+    auto known = [table](const std::string& name) {
+        int index = query_bind_column(table, name);
+        if (index == -1) std::cerr << "Hata: Kolon bulunamadi: " << name << std::endl;
+        return index >= 0;
+    };
+    for (const auto& column : query->select_columns) {
+        if (column == "*" || column.find(".*") != std::string::npos || is_aggregate_output(query, column)) continue;
+        if (!known(column)) return false;
+    }
+    for (const auto& column : query->group_by) {
+        if (!known(column)) return false;
+    }
+    for (const auto& aggregate : query->aggregates) {
+        if (!aggregate.column_name.empty() && !known(aggregate.column_name)) return false;
+    }
+    for (const auto& item : query->order_by) {
+        if (!is_aggregate_output(query, item.column_name) && !known(item.column_name)) return false;
+    }
+    return true;
+}
+
+// GROUP BY tek kolon ve o kolon tablonun anahtariysa satirlar B+ tree
+// sirasiyla okunur
+static bool group_by_key_ordered(Table* table, const Query* query) {
+    int key_column = table->getKeyColumnIndex();
+    return query->group_by.size() == 1 && key_column >= 0 &&
+           query_bind_column(table, *query->group_by.begin()) == key_column;
 }
 
 // 4. ANA EXECUTE FONKSIYONU (EKSİK JOIN EKLENDİ)
-Table* query_execute(Database* db, const Query* query) {
-    if (!db || !query || query->from_tables.empty()) return nullptr;
-    
+// Kilitler ve snapshot query_execute'ta; burada db'deki tablolar dogrudan okunur
+static Table* run_query(Database* db, const Query* query, const QueryParams* params) {
     std::string table_name = *(query->from_tables.begin());
     Table* current_table = db->getTable(table_name);
     if (!current_table) return nullptr;
@@ -193,68 +410,118 @@ Table* query_execute(Database* db, const Query* query) {
 
     // --- EKSİK OLAN KISIM BURASIYDI: JOIN ---
     if (!query->joins.empty()) {
+        // Projection pushdown: SELECT * degilse join sonucu sadece SELECT, WHERE
+        // ve sonraki join'lerin kullandigi kolonlari tasir; geri kalan hucreler
+        // hic kopyalanmaz.
+        LinkedList<std::string> needed_columns;
+        bool project = !query->select_columns.empty();
+        if (project) {
+            for (const auto& col : query->select_columns) needed_columns.push_back(col);
+            collect_expr_columns(query->where, needed_columns);
+            for (const auto& item : query->order_by) needed_columns.push_back(item.column_name);
+            for (const auto& column : query->group_by) needed_columns.push_back(column);
+            for (const auto& aggregate : query->aggregates) needed_columns.push_back(aggregate.column_name);
+            for (const auto& join : query->joins) needed_columns.push_back(join.left_column);
+        }
+
+        // Sonuc kolonlari tablolarin sorgudaki adlariyla nitelenir; ilk
+        // join'den sonra sol taraf zaten nitelenmistir
+        JoinColumns output;
+        output.wanted = project ? &needed_columns : nullptr;
+        output.left_alias = query->from_alias;
         for (auto it = query->joins.begin(); it != query->joins.end(); ++it) {
             const JoinCondition& join = *it;
             Table* right_table = db->getTable(join.right_table);
-            if (right_table) {
-                Table* joined = join_execute(result, right_table, join);
-                if (joined) {
-                    if (is_temporary && result != current_table) delete result;
-                    result = joined;
-                    is_temporary = true;
-                }
-            }
+            output.right_alias = join.right_alias;
+            Table* joined = right_table ? join_execute(result, right_table, join, &output) : nullptr;
+            if (is_temporary && result != current_table) delete result;
+            if (!joined) return nullptr;
+            result = joined;
+            is_temporary = true;
+            output.left_alias.clear();
         }
     }
     // ----------------------------------------
 
-    // WHERE
-    if (!query->conditions.empty()) {
+    if (!check_columns(result, query)) {
+        if (is_temporary && result != current_table) delete result;
+        return nullptr;
+    }
+
+    // WHERE'deki kolonlarin hepsi (join sonrasi) tabloda olmali; asagidaki
+    // taramalar baglamanin basarili oldugunu varsayar
+    if (query->where) {
+        BoundExpr* check = query_bind_expr(query->where, result, params);
+        if (!check) {
+            if (is_temporary && result != current_table) delete result;
+            return nullptr;
+        }
+        delete check;
+    }
+
+    // ORDER BY + LIMIT birlikteyse sadece offset + limit satir gerekir
+    long long top_k = query->limit >= 0 ? static_cast<long long>(query->limit) + query->offset : -1;
+    bool ordered = false;
+    bool aggregating = !query->aggregates.empty() || !query->group_by.empty();
+    // Siralama ve toplama yoksa LIMIT/OFFSET taramaya itilir: WHERE ilk
+    // offset + limit eslesmede durur, WHERE yoksa SELECT'ten once kesilir
+    bool push_limit = query->limit >= 0 && query->order_by.empty() && !aggregating;
+    bool limit_applied = false;
+
+    // ORDER BY anahtar kolondaysa B+ tree sirasiyla tara: siralama yok,
+    // LIMIT dolunca tarama durur. WHERE'deki anahtar araligi taramayi daraltir.
+    if (!aggregating && result == current_table && sort_can_use_index(current_table, query->order_by)) {
+        AccessPath path = choose_access_path(current_table, query->conditions, params);
+        int lo = INT_MIN, hi = INT_MAX;
+        if (path.type == AccessPathType::INDEX_LOOKUP) lo = hi = path.key;
+        if (path.type == AccessPathType::RANGE_SCAN) {
+            lo = path.range_lo;
+            hi = path.range_hi;
+        }
+        BoundExpr* bound = query->where ? query_bind_expr(query->where, current_table, params) : nullptr;
+        CompiledPredicate predicate(bound);
+        result = path.empty ? new Table(current_table->getName() + "_sorted", current_table->getColumns(),
+                                        current_table->getTypes())
+                            : sort_index_scan(current_table, lo, hi, (*query->order_by.begin()).ascending,
+                                              bound ? &predicate : nullptr, query->limit, query->offset);
+        delete bound;
+        is_temporary = true;
+        ordered = true;
+        limit_applied = true;
+    }
+
+    // WHERE (tek tabloda toplama varsa WHERE toplama taramasinda uygulanir)
+    bool fused_where = aggregating && result == current_table;
+    if (!ordered && !fused_where && (query->where || !query->conditions.empty())) {
         
-        // --- [YENI] OPTIMIZASYON: "ID = Deger" sorgusunda Index Kullan ---
-        // Eger islem henuz basindaysa (Join yapilmadiysa) ve ID araniyorsa
-        if (result == current_table) { 
-            for (auto it = query->conditions.begin(); it != query->conditions.end(); ++it) {
-                const QueryCondition& cond = *it;
-                
-                // Kosul "ID" kolonunda "EQUAL" ise Hash Index'i devreye sok
-                if (cond.column_name == "ID" && cond.op == ComparisonOperator::EQUAL) {
-                    try {
-                        int search_id = std::stoi(cond.value);
-                        
-                        // Index Uzerinden Hizli Arama (O(1))
-                        Row* found_row = result->getRowById(search_id);
-                        
-                        // Sadece bulunan satiri iceren kucuk bir tablo olustur
-                        Table* index_result = new Table(result->getName() + "_index_scan", result->getColumns(), result->getTypes());
-                        
-                        if (found_row) {
-                            // Satirin kopyasini al (Deep Copy)
-                            Row* new_row = new Row(found_row->getId());
-                            for(auto cell : found_row->getCells()) {
-                                if (cell->getType() == CellType::INT) new_row->addCell(cell->getInt());
-                                else if (cell->getType() == CellType::DOUBLE) new_row->addCell(cell->getDouble());
-                                else new_row->addCell(cell->getString());
-                            }
-                            index_result->insertRow(new_row);
-                        }
-                        
-                        // Pointerlari guncelle
-                        if (is_temporary && result != current_table) delete result;
-                        result = index_result;
-                        is_temporary = true;
-                        
-                        // Index kullandik, artik donguden cikabiliriz. 
-                        // Diger kosullar (varsa) asagidaki standart filtrelemede kontrol edilecek.
-                        break; 
-                    } catch (...) {
-                        // ID integer degilse index kullanma, normal yola devam et
-                    }
-                }
+        Table* filtered;
+        if (result == current_table && query->where) {
+            // Erisim yolu istatistiklere gore secilir: tam tarama, hash indeks
+            // ya da anahtar kolon araliginda B+ tree taramasi. Adaylar yine
+            // WHERE'in tamamindan gecer.
+            AccessPath path = choose_access_path(current_table, query->conditions, params);
+            int limit = push_limit ? query->limit : -1;
+            int offset = push_limit ? query->offset : 0;
+            if (push_limit && path.type == AccessPathType::RANGE_SCAN && !path.empty) {
+                // Aralik B+ tree imleciyle yurunur; aralik once listeye toplanmaz
+                BoundExpr* bound = query_bind_expr(query->where, current_table, params);
+                CompiledPredicate predicate(bound);
+                filtered = sort_index_scan(current_table, path.range_lo, path.range_hi, true, &predicate, limit, offset);
+                delete bound;
+            } else if (path.type == AccessPathType::FULL_SCAN && !path.empty) {
+                filtered = filter_rows(current_table, current_table->getRows(), query->where, params, limit, offset);
+            } else {
+                filtered = filter_rows(current_table, access_path_rows(current_table, path), query->where, params,
+                                       limit, offset);
             }
+            limit_applied = push_limit;
+        } else if (query->where) {
+            filtered = push_limit ? query_apply_where_expr(result, query->where, params, query->limit, query->offset)
+                                  : query_apply_where_expr(result, query->where, params);
+            limit_applied = push_limit;
+        } else {
+            filtered = query_apply_where(result, query->conditions);
         }
-
-        Table* filtered = query_apply_where(result, query->conditions);
         if (filtered && filtered != result) {
             if (is_temporary && result != current_table) delete result;
             result = filtered;
@@ -262,6 +529,58 @@ Table* query_execute(Database* db, const Query* query) {
         }
     }
 
+    // GROUP BY / toplama
+    if (aggregating) {
+        Table* aggregated;
+        if (fused_where && !query->where && query->group_by.empty() && aggregate_is_row_count(query->aggregates)) {
+            // Sadece COUNT(*): tablo taranmaz
+            aggregated = aggregate_row_count(current_table, query->aggregates);
+        } else if (fused_where) {
+            // Gruplama anahtar kolondaysa satirlar B+ tree sirasiyla okunur;
+            // gruplar sirali geldigi icin hash tablosu gerekmez
+            AccessPath path = choose_access_path(current_table, query->conditions, params);
+            bool key_ordered = group_by_key_ordered(current_table, query);
+            if (key_ordered && path.type == AccessPathType::FULL_SCAN) path.type = AccessPathType::RANGE_SCAN;
+
+            BoundExpr* bound = query->where ? query_bind_expr(query->where, current_table, params) : nullptr;
+            CompiledPredicate predicate(bound);
+            aggregated = aggregate_rows(current_table, access_path_rows(current_table, path),
+                                        bound ? &predicate : nullptr, query->group_by, query->aggregates,
+                                        key_ordered);
+            delete bound;
+        } else {
+            aggregated = aggregate_rows(result, table_rows(result), nullptr, query->group_by, query->aggregates, false);
+        }
+        if (!aggregated) {
+            if (is_temporary && result != current_table) delete result;
+            return nullptr;
+        }
+        if (is_temporary && result != current_table) delete result;
+        result = aggregated;
+        is_temporary = true;
+    }
+
+    // ORDER BY (SELECT'ten once: siralama kolonu secilmemis olabilir)
+    if (!ordered && !query->order_by.empty()) {
+        Table* sorted = query_apply_order_by(result, query->order_by, top_k);
+        if (sorted && sorted != result) {
+            if (is_temporary && result != current_table) delete result;
+            result = sorted;
+            is_temporary = true;
+        }
+    }
+
+    // LIMIT, SELECT'ten once: sadece gereken satirlar kopyalanir
+    if (push_limit && !limit_applied) {
+        Table* limited = query_apply_limit(result, query->limit, query->offset);
+        if (limited && limited != result) {
+            if (is_temporary && result != current_table) delete result;
+            result = limited;
+            is_temporary = true;
+        }
+        limit_applied = true;
+    }
+
     // SELECT
     if (!query->select_columns.empty()) {
         Table* projected = query_apply_select(result, query->select_columns);
@@ -273,7 +592,7 @@ Table* query_execute(Database* db, const Query* query) {
     }
     
     // LIMIT
-    if (query->limit >= 0) {
+    if (query->limit >= 0 && !limit_applied) {
         Table* limited = query_apply_limit(result, query->limit, query->offset);
         if (limited && limited != result) {
              if (is_temporary && result != current_table) delete result;
@@ -283,9 +602,94 @@ Table* query_execute(Database* db, const Query* query) {
     }
 
     if (result == current_table) {
-        LinkedList<std::string> all_cols = current_table->getColumns();
-        result = query_apply_select(current_table, all_cols);
+        // LinkedList'in kopya kurucusu yok; kopya tablonun kolon listesini serbest birakirdi
+        result = query_apply_select(current_table, current_table->getColumns());
     }
     
     return result;
+}
+
+// Indeks kullanan planlar (erisim yolu, anahtar sirali ORDER BY ya da
+// GROUP BY, indeksli join) okuma kilidi altinda tablonun kendisinde calisir:
+// snapshot gorunumunun indeksi yoktur. Gorunum sadece indekssiz tam
+// taramalar icin alinir; alinmasi O(n) ama kilit sadece o surede tutulur.
+static bool needs_snapshot(Database* db, const Query* query, Table* table, const QueryParams* params) {
+    if (!query->joins.empty()) {
+        Table* left = table;
+        for (const auto& join : query->joins) {
+            if (join_can_use_index(left, db->getTable(join.right_table), join, query->from_alias)) return false;
+            left = nullptr;
+        }
+        return true;
+    }
+    bool aggregating = !query->aggregates.empty() || !query->group_by.empty();
+    if (aggregating && !query->where && query->group_by.empty() && aggregate_is_row_count(query->aggregates)) {
+        return false;
+    }
+    if (choose_access_path(table, query->conditions, params).type != AccessPathType::FULL_SCAN) return false;
+    if (aggregating) return !group_by_key_ordered(table, query);
+    if (!query->order_by.empty()) return !sort_can_use_index(table, query->order_by);
+    return query->limit < 0;
+}
+
+Table* query_execute(Database* db, const Query* query, const QueryParams* params) {
+    if (!db || !query || query->from_tables.empty()) return nullptr;
+
+    size_t given = params ? params->size() : 0;
+    if (given < static_cast<size_t>(query->param_count)) {
+        std::cerr << "Hata: Sorgu " << query->param_count << " parametre bekliyor, " << given << " verildi"
+                  << std::endl;
+        return nullptr;
+    }
+
+    // Gorunumler snapshot'tan sonra silinir (yikim sirasi ters); gorunum
+    // yikimi satirlara dokunmaz
+    Database snapshot_db;
+    std::unique_ptr<Snapshot> snapshot;
+    {
+        ReadGuard schema_guard(db->getSchemaLock());
+        // Parcali tablo kendi worker'larinda calistirir; sema kilidi tablonun
+        // silinmesini engeller
+        ShardedTable* sharded = db->getShardedTable(*(query->from_tables.begin()));
+        if (sharded) return sharded->execute(query, params);
+        for (const auto& join : query->joins) {
+            if (db->getShardedTable(join.right_table)) {
+                std::cerr << "Hata: Parcali tabloyla (" << join.right_table << ") JOIN desteklenmiyor" << std::endl;
+                return nullptr;
+            }
+        }
+
+        Table* current_table = db->getTable(*(query->from_tables.begin()));
+        if (!current_table) return nullptr;
+
+        // id = k: tablo kilidi alinmaz, satir hash indeksten kilitsiz okunur;
+        // nokta okumalari eszamanli insert/delete'i beklemez. Silinen satir
+        // epoch ile serbest birakildigi icin guard boyunca gecerlidir.
+        int point_key;
+        if (query->joins.empty() && access_path_point_key(current_table, query->conditions, params, point_key)) {
+            EpochGuard epoch_guard;
+            snapshot_db.addTable(current_table->pointView(point_key));
+            return run_query(&snapshot_db, query, params);
+        }
+
+        // Okunan tablolarin hepsi birlikte kilitlenir (JOIN'deki tablolar dahil)
+        std::vector<Table*> tables;
+        tables.push_back(current_table);
+        for (const auto& join : query->joins) {
+            Table* right_table = db->getTable(join.right_table);
+            if (right_table && std::find(tables.begin(), tables.end(), right_table) == tables.end()) {
+                tables.push_back(right_table);
+            }
+        }
+        std::vector<RWLock*> table_locks;
+        for (Table* table : tables) table_locks.push_back(&table->getLock());
+        ReadGuardSet table_guard(table_locks);
+
+        if (!needs_snapshot(db, query, current_table, params)) return run_query(db, query, params);
+
+        // Kilitler tutulurken kayit: tablolardaki her satirin versiyonu <= snapshot
+        snapshot.reset(new Snapshot());
+        for (Table* table : tables) snapshot_db.addTable(table->snapshotView());
+    }
+    return run_query(&snapshot_db, query, params);
 }
\ No newline at end of file
@@ -0,0 +1,173 @@
+#include "../../../include/engine/query/query_lexer.hpp"
+#include <cctype>
+
+struct KeywordEntry {
+    const char* word;
+    Keyword keyword;
+};
+
+static const KeywordEntry KEYWORDS[] = {
+    {"SELECT", Keyword::SELECT}, {"FROM", Keyword::FROM},     {"WHERE", Keyword::WHERE},
+    {"JOIN", Keyword::JOIN},     {"INNER", Keyword::INNER},   {"LEFT", Keyword::LEFT},
+    {"RIGHT", Keyword::RIGHT},   {"FULL", Keyword::FULL},     {"OUTER", Keyword::OUTER},
+    {"ON", Keyword::ON},         {"AND", Keyword::AND},       {"OR", Keyword::OR},
+    {"NOT", Keyword::NOT},       {"IN", Keyword::IN},         {"LIKE", Keyword::LIKE},
+    {"IS", Keyword::IS},         {"NULL", Keyword::NULL_KW},  {"ORDER", Keyword::ORDER},
+    {"BY", Keyword::BY},         {"ASC", Keyword::ASC},       {"DESC", Keyword::DESC},
+    {"LIMIT", Keyword::LIMIT},   {"OFFSET", Keyword::OFFSET},
+    {"AS", Keyword::AS},         {"GROUP", Keyword::GROUP},
+};
+
+bool token_equals_ignore_case(const Token& token, const char* word) {
+    size_t i = 0;
+    for (; i < token.length; i++) {
+        if (word[i] == '\0') return false;
+        if (std::toupper(static_cast<unsigned char>(token.start[i])) != word[i]) return false;
+    }
+    return word[i] == '\0';
+}
+
+static bool is_identifier_start(char c) {
+    return std::isalpha(static_cast<unsigned char>(c)) || c == '_';
+}
+
+static bool is_identifier_char(char c) {
+    return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+}
+
+QueryLexer::QueryLexer(const std::string& query)
+    : input(query.data()), length(query.size()), pos(0), hasLookahead(false) {}
+
+Token QueryLexer::scan() {
+    while (pos < length && std::isspace(static_cast<unsigned char>(input[pos]))) pos++;
+
+    Token token;
+    token.type = TokenType::END;
+    token.keyword = Keyword::NONE;
+    token.start = input + pos;
+    token.length = 0;
+    token.position = pos;
+    if (pos >= length) return token;
+
+    char c = input[pos];
+
+    if (is_identifier_start(c)) {
+        size_t begin = pos;
+        while (pos < length && is_identifier_char(input[pos])) pos++;
+        token.type = TokenType::IDENTIFIER;
+        token.length = pos - begin;
+        for (const auto& entry : KEYWORDS) {
+            if (token_equals_ignore_case(token, entry.word)) {
+                token.type = TokenType::KEYWORD;
+                token.keyword = entry.keyword;
+                break;
+            }
+        }
+        return token;
+    }
+
+    if (std::isdigit(static_cast<unsigned char>(c)) ||
+        (c == '.' && pos + 1 < length && std::isdigit(static_cast<unsigned char>(input[pos + 1])))) {
+        size_t begin = pos;
+        while (pos < length && std::isdigit(static_cast<unsigned char>(input[pos]))) pos++;
+        if (pos < length && input[pos] == '.') {
+            pos++;
+            while (pos < length && std::isdigit(static_cast<unsigned char>(input[pos]))) pos++;
+        }
+        if (pos < length && (input[pos] == 'e' || input[pos] == 'E')) {
+            size_t save = pos++;
+            if (pos < length && (input[pos] == '+' || input[pos] == '-')) pos++;
+            if (pos < length && std::isdigit(static_cast<unsigned char>(input[pos]))) {
+                while (pos < length && std::isdigit(static_cast<unsigned char>(input[pos]))) pos++;
+            } else {
+                pos = save;
+            }
+        }
+        token.type = TokenType::NUMBER;
+        token.length = pos - begin;
+        return token;
+    }
+
+    // Metin sabiti. Cift tirnak da eski istemcilerle uyum icin metin sayilir.
+    if (c == '\'' || c == '"') {
+        char quote = c;
+        size_t begin = ++pos;
+        while (pos < length) {
+            if (input[pos] == quote) {
+                if (pos + 1 < length && input[pos + 1] == quote) {
+                    pos += 2;  // '' kacisi
+                    continue;
+                }
+                break;
+            }
+            pos++;
+        }
+        if (pos >= length) {
+            token.type = TokenType::INVALID;  // kapanmamis tirnak
+            token.length = length - token.position;
+            return token;
+        }
+        token.type = TokenType::STRING;
+        token.start = input + begin;
+        token.length = pos - begin;
+        pos++;
+        return token;
+    }
+
+    pos++;
+    token.length = 1;
+    switch (c) {
+        case ',': token.type = TokenType::COMMA; break;
+        case '.': token.type = TokenType::DOT; break;
+        case '(': token.type = TokenType::LPAREN; break;
+        case ')': token.type = TokenType::RPAREN; break;
+        case '*': token.type = TokenType::STAR; break;
+        case '+': token.type = TokenType::PLUS; break;
+        case '-': token.type = TokenType::MINUS; break;
+        case '/': token.type = TokenType::SLASH; break;
+        case ';': token.type = TokenType::SEMICOLON; break;
+        case '?': token.type = TokenType::PARAM; break;
+        case '=':
+            token.type = TokenType::EQUAL;
+            if (pos < length && input[pos] == '=') { pos++; token.length = 2; }
+            break;
+        case '!':
+            if (pos < length && input[pos] == '=') {
+                pos++;
+                token.length = 2;
+                token.type = TokenType::NOT_EQUAL;
+            } else {
+                token.type = TokenType::INVALID;
+            }
+            break;
+        case '<':
+            token.type = TokenType::LESS;
+            if (pos < length && input[pos] == '=') { pos++; token.length = 2; token.type = TokenType::LESS_EQUAL; }
+            else if (pos < length && input[pos] == '>') { pos++; token.length = 2; token.type = TokenType::NOT_EQUAL; }
+            break;
+        case '>':
+            token.type = TokenType::GREATER;
+            if (pos < length && input[pos] == '=') { pos++; token.length = 2; token.type = TokenType::GREATER_EQUAL; }
+            break;
+        default:
+            token.type = TokenType::INVALID;
+            break;
+    }
+    return token;
+}
+
+Token QueryLexer::next() {
+    if (hasLookahead) {
+        hasLookahead = false;
+        return lookahead;
+    }
+    return scan();
+}
+
+const Token& QueryLexer::peek() {
+    if (!hasLookahead) {
+        lookahead = scan();
+        hasLookahead = true;
+    }
+    return lookahead;
+}
@@ -0,0 +1,337 @@
+#include "../../../include/engine/query/query_optimizer.hpp"
+#include "../../../include/utils/ThreadPool.hpp"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+
+static const size_t HISTOGRAM_BUCKETS = 32;
+
+// Maliyet birimleri: tam taramada satir basina 1. Indeks yolunda satirlar
+// rastgele erisildigi icin satir basina biraz daha pahali sayilir.
+static const double SCAN_ROW_COST = 1.0;
+static const double INDEX_ROW_COST = 1.5;
+static const double INDEX_LOOKUP_COST = 2.0;
+
+// Istatistik yokken aralik kosulu icin varsayilan secicilik
+static const double DEFAULT_RANGE_FRACTION = 1.0 / 3.0;
+
+double ColumnStats::estimateRangeFraction(double lo, double hi) const {
+    size_t total = non_null_count + null_count;
+    if (total == 0) return 0;
+    if (!has_range || histogram.size() < 2) return DEFAULT_RANGE_FRACTION;
+    if (hi < lo || hi < min || lo > max) return 0;
+
+    // Tamsayi kolonda [b0, b1] kovasi b1 - b0 + 1 deger kapsar
+    double width_pad = type == CellType::INT ? 1.0 : 0.0;
+    size_t buckets = histogram.size() - 1;
+    double covered = 0;
+    for (size_t b = 0; b < buckets; b++) {
+        double b0 = histogram[b];
+        double b1 = histogram[b + 1];
+        double overlap_lo = std::max(lo, b0);
+        double overlap_hi = std::min(hi, b1);
+        if (overlap_hi < overlap_lo) continue;
+        double width = b1 - b0 + width_pad;
+        covered += width <= 0 ? 1.0 : std::min(1.0, (overlap_hi - overlap_lo + width_pad) / width);
+    }
+    double fraction = covered / static_cast<double>(buckets);
+    return std::min(1.0, fraction) * static_cast<double>(non_null_count) / static_cast<double>(total);
+}
+
+double ColumnStats::estimateEqualFraction() const {
+    size_t total = non_null_count + null_count;
+    if (total == 0 || distinct_count == 0) return 0;
+    return static_cast<double>(non_null_count) / static_cast<double>(total) / static_cast<double>(distinct_count);
+}
+
+static void collect_column(const std::vector<Row*>& rows, int column, ColumnStats& stats) {
+    std::vector<double> numbers;
+    std::vector<size_t> text_hashes;
+    numbers.reserve(rows.size());
+
+    for (Row* row : rows) {
+        Cell* cell = static_cast<size_t>(column) < row->getCellCount() ? row->getCell(column) : nullptr;
+        if (!cell || cell->isNull()) {
+            stats.null_count++;
+            continue;
+        }
+        stats.non_null_count++;
+        if (cell->getType() == CellType::INT) numbers.push_back(cell->getInt());
+        else if (cell->getType() == CellType::DOUBLE) numbers.push_back(cell->getDouble());
+        else text_hashes.push_back(cell->getStringHash());
+    }
+
+    std::sort(numbers.begin(), numbers.end());
+    std::sort(text_hashes.begin(), text_hashes.end());
+    for (size_t i = 0; i < numbers.size(); i++) {
+        if (i == 0 || numbers[i] != numbers[i - 1]) stats.distinct_count++;
+    }
+    for (size_t i = 0; i < text_hashes.size(); i++) {
+        if (i == 0 || text_hashes[i] != text_hashes[i - 1]) stats.distinct_count++;
+    }
+    if (numbers.empty()) return;
+
+    stats.has_range = true;
+    stats.min = numbers.front();
+    stats.max = numbers.back();
+    size_t buckets = std::min(HISTOGRAM_BUCKETS, numbers.size());
+    for (size_t b = 0; b <= buckets; b++) {
+        size_t pos = std::min(b * numbers.size() / buckets, numbers.size() - 1);
+        stats.histogram.push_back(numbers[pos]);
+    }
+}
+
+std::shared_ptr<const TableStats> table_stats_collect(Table* table) {
+    std::shared_ptr<TableStats> stats = std::make_shared<TableStats>();
+    stats->table_id = table->getTableId();
+    stats->modification_count = table->getModificationCount();
+    stats->row_count = table->getRowCount();
+
+    std::vector<Row*> rows;
+    rows.reserve(stats->row_count);
+    for (auto row : table->getRows()) rows.push_back(row);
+
+    auto type_it = table->getTypes().begin();
+    for (const auto& col : table->getColumns()) {
+        ColumnStats column;
+        column.name = col;
+        column.type = CellType::STRING;
+        if (type_it != table->getTypes().end()) {
+            if (*type_it == "INT") column.type = CellType::INT;
+            else if (*type_it == "DOUBLE") column.type = CellType::DOUBLE;
+            ++type_it;
+        }
+        column.non_null_count = 0;
+        column.null_count = 0;
+        column.distinct_count = 0;
+        column.has_range = false;
+        column.min = 0;
+        column.max = 0;
+        stats->columns.push_back(column);
+    }
+
+    // Kolonlar birbirinden bagimsiz; her biri ayri gorev
+    ThreadPool::global().parallelFor(stats->columns.size(), [&](size_t i) {
+        collect_column(rows, static_cast<int>(i), stats->columns[i]);
+    });
+    return stats;
+}
+
+// Istatistik onbellegi tableId ile anahtarlanir: tableId hic tekrar
+// kullanilmaz, silinen tablonun adresine gelen yeni tablo eski girdiyi
+// bulamaz. Katalogdan cikan tablonun girdisi table_stats_forget ile silinir.
+// Global Database'in yikicisi da forget cagirdigi icin onbellek hic yikilmaz.
+struct StatsCache {
+    std::mutex mutex;
+    std::unordered_map<uint64_t, std::shared_ptr<const TableStats>> entries;
+};
+
+static StatsCache& stats_cache() {
+    static StatsCache* cache = new StatsCache();
+    return *cache;
+}
+
+std::shared_ptr<const TableStats> table_stats_get(Table* table) {
+    StatsCache& cache = stats_cache();
+    {
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        auto found = cache.entries.find(table->getTableId());
+        if (found != cache.entries.end()) {
+            uint64_t changes = table->getModificationCount() - found->second->modification_count;
+            if (changes <= found->second->row_count / 10) return found->second;
+        }
+    }
+
+    std::shared_ptr<const TableStats> stats = table_stats_collect(table);
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    cache.entries[stats->table_id] = stats;
+    return stats;
+}
+
+void table_stats_forget(const Table* table) {
+    StatsCache& cache = stats_cache();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    cache.entries.erase(table->getTableId());
+}
+
+// Kosul degeri (sabit ya da ? parametresi) sayi olarak
+static bool condition_number(const QueryCondition& cond, const QueryParams* params, double& out) {
+    const std::string* text = &cond.value;
+    if (cond.param_index >= 0) {
+        if (!params || cond.param_index >= static_cast<int>(params->size())) return false;
+        const QueryParam& param = (*params)[cond.param_index];
+        if (param.type == LiteralType::NUMBER) {
+            out = param.number;
+            return true;
+        }
+        if (param.type != LiteralType::STRING) return false;
+        text = &param.text;
+    }
+    if (text->empty()) return false;
+    char* end = nullptr;
+    out = std::strtod(text->c_str(), &end);
+    return end == text->c_str() + text->size();
+}
+
+static const std::string* column_name_at(Table* table, int index) {
+    int i = 0;
+    for (const auto& col : table->getColumns()) {
+        if (i++ == index) return &col;
+    }
+    return nullptr;
+}
+
+// Anahtar kolondaki kosullari tek bir [lo, hi] araligina indirir. Anahtar
+// kolonda kosul yoksa false; celiskili esitlikte (id = 1.5) empty true olur.
+// Sadece kolon adlarini ve anahtar kolonu okur, satirlara dokunmaz.
+static bool key_range(Table* table, const LinkedList<QueryCondition>& conditions, const QueryParams* params,
+                      long long& lo, long long& hi, bool& empty) {
+    lo = INT_MIN;
+    hi = INT_MAX;
+    empty = false;
+    int key_column = table->getKeyColumnIndex();
+    const std::string* key_name = key_column >= 0 ? column_name_at(table, key_column) : nullptr;
+    if (!key_name) return false;
+
+    bool has_equal = false, has_range = false;
+    for (const auto& cond : conditions) {
+        if (cond.column_name != *key_name) continue;
+        double value;
+        if (!condition_number(cond, params, value)) continue;
+        // NaN hicbir anahtarla karsilastirilamaz. Sonsuz ve cok buyuk
+        // degerler int araliginin bir disina kirpilir: long long'a cevirme
+        // tanimli kalir, aralik disi kontrolu asagida bos araligi bulur.
+        if (std::isnan(value)) {
+            empty = true;
+            has_equal = true;
+            continue;
+        }
+        value = std::min(std::max(value, static_cast<double>(INT_MIN) - 1), static_cast<double>(INT_MAX) + 1);
+        switch (cond.op) {
+            case ComparisonOperator::EQUAL:
+                if (std::floor(value) != value) {
+                    empty = true;
+                } else {
+                    lo = std::max(lo, static_cast<long long>(value));
+                    hi = std::min(hi, static_cast<long long>(value));
+                }
+                has_equal = true;
+                break;
+            case ComparisonOperator::GREATER_THAN:
+                lo = std::max(lo, static_cast<long long>(std::floor(value)) + 1);
+                has_range = true;
+                break;
+            case ComparisonOperator::GREATER_EQUAL:
+                lo = std::max(lo, static_cast<long long>(std::ceil(value)));
+                has_range = true;
+                break;
+            case ComparisonOperator::LESS_THAN:
+                hi = std::min(hi, static_cast<long long>(std::ceil(value)) - 1);
+                has_range = true;
+                break;
+            case ComparisonOperator::LESS_EQUAL:
+                hi = std::min(hi, static_cast<long long>(std::floor(value)));
+                has_range = true;
+                break;
+            default:
+                break;
+        }
+    }
+    return has_equal || has_range;
+}
+
+bool access_path_point_key(Table* table, const LinkedList<QueryCondition>& conditions, const QueryParams* params,
+                           int& key) {
+    long long lo, hi;
+    bool empty;
+    if (!key_range(table, conditions, params, lo, hi, empty)) return false;
+    if (empty || lo != hi || lo < INT_MIN || lo > INT_MAX) return false;
+    key = static_cast<int>(lo);
+    return true;
+}
+
+AccessPath choose_access_path(Table* table, const LinkedList<QueryCondition>& conditions,
+                              const QueryParams* params) {
+    AccessPath path;
+    path.type = AccessPathType::FULL_SCAN;
+    path.key = 0;
+    path.range_lo = INT_MIN;
+    path.range_hi = INT_MAX;
+    path.empty = false;
+    path.estimated_rows = static_cast<double>(table->getRowCount());
+    path.cost = path.estimated_rows * SCAN_ROW_COST;
+
+    long long lo, hi;
+    if (!key_range(table, conditions, params, lo, hi, path.empty)) return path;
+    int key_column = table->getKeyColumnIndex();
+
+    if (path.empty || lo > hi || lo > INT_MAX || hi < INT_MIN) {
+        path.empty = true;
+        path.type = AccessPathType::INDEX_LOOKUP;
+        path.estimated_rows = 0;
+        path.cost = 0;
+        return path;
+    }
+
+    if (lo == hi) {
+        path.type = AccessPathType::INDEX_LOOKUP;
+        path.key = static_cast<int>(lo);
+        path.estimated_rows = 1;
+        path.cost = INDEX_LOOKUP_COST;
+        return path;
+    }
+
+    std::shared_ptr<const TableStats> stats = table_stats_get(table);
+    double fraction = stats->columns[key_column].estimateRangeFraction(static_cast<double>(lo), static_cast<double>(hi));
+    double estimated = fraction * static_cast<double>(table->getRowCount());
+    double range_cost = std::log2(static_cast<double>(table->getRowCount()) + 2) + estimated * INDEX_ROW_COST;
+    if (range_cost < path.cost) {
+        path.type = AccessPathType::RANGE_SCAN;
+        path.range_lo = static_cast<int>(std::max(lo, static_cast<long long>(INT_MIN)));
+        path.range_hi = static_cast<int>(std::min(hi, static_cast<long long>(INT_MAX)));
+        path.estimated_rows = estimated;
+        path.cost = range_cost;
+    }
+    return path;
+}
+
+std::vector<Row*> access_path_rows(Table* table, const AccessPath& path) {
+    std::vector<Row*> rows;
+    if (path.empty) return rows;
+
+    switch (path.type) {
+        case AccessPathType::INDEX_LOOKUP: {
+            Row* row = table->getRowById(path.key);
+            if (row) rows.push_back(row);
+            break;
+        }
+        case AccessPathType::RANGE_SCAN: {
+            table->getBTree()->rangeBetween(path.range_lo, path.range_hi, rows);
+            break;
+        }
+        case AccessPathType::FULL_SCAN:
+            rows.reserve(table->getRowCount());
+            for (auto row : table->getRows()) rows.push_back(row);
+            break;
+    }
+    return rows;
+}
+
+std::string access_path_to_string(const AccessPath& path) {
+    std::ostringstream out;
+    if (path.empty) return "EMPTY (conditions never match)";
+    switch (path.type) {
+        case AccessPathType::FULL_SCAN: out << "FULL SCAN"; break;
+        case AccessPathType::INDEX_LOOKUP: out << "INDEX LOOKUP key=" << path.key; break;
+        case AccessPathType::RANGE_SCAN:
+            out << "RANGE SCAN [" << path.range_lo << ", " << path.range_hi << "]";
+            break;
+    }
+    out << " est_rows=" << path.estimated_rows << " cost=" << path.cost;
+    return out.str();
+}
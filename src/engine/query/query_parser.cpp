@@ -1,141 +1,642 @@
 /**
  * src/engine/query/query_parser.cpp
- * JOIN PARSING EKLENMİŞ SÜRÜM
+ * Tokenizer + recursive-descent parser
+ *
+ *   query       := SELECT select_list FROM table join* [WHERE expr]
+ *                  [ORDER BY order_item (',' order_item)*] [LIMIT NUMBER [OFFSET NUMBER]] [';']
+ *   table       := IDENT [[AS] IDENT]
+ *   join        := [INNER | LEFT [OUTER] | RIGHT [OUTER] | FULL [OUTER]] JOIN table ON column '=' column
+ *   expr        := and_expr (OR and_expr)*
+ *   and_expr    := not_expr (AND not_expr)*
+ *   not_expr    := NOT not_expr | predicate
+ *   predicate   := additive [cmp additive | [NOT] IN '(' additive, ... ')' | [NOT] LIKE additive
+ *                            | IS [NOT] NULL]
+ *   additive    := term (('+' | '-') term)*
+ *   term        := factor (('*' | '/') factor)*
+ *   factor      := NUMBER | STRING | NULL | '?' | column | '(' expr ')' | '-' factor
+ *   column      := IDENT ['.' IDENT]
  */
 #include "../../../include/engine/query/query_parser.hpp"
+#include "../../../include/engine/query/query_lexer.hpp"
 #include "../../../include/engine/query/query_types.hpp"
 #include "../../../include/data_structures/LinkedList.hpp"
-#include <sstream>
-#include <algorithm>
-#include <cctype>
-
-static std::string trim(const std::string& str) {
-    size_t first = str.find_first_not_of(" \t\r\n");
-    if (first == std::string::npos) return "";
-    size_t last = str.find_last_not_of(" \t\r\n");
-    return str.substr(first, (last - first + 1));
-}
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+// Parse hatasi; query_parse icinde yakalanip nullptr'a cevrilir
+struct QueryParseError : public std::runtime_error {
+    size_t position;
+    QueryParseError(const std::string& msg, size_t pos) : std::runtime_error(msg), position(pos) {}
+};
+
+class QueryParser {
+private:
+    QueryLexer lexer;
+    int paramCount;
+    // FROM ve JOIN tablolari: (sorgudaki ad, tablo adi). Sorgudaki ad AS ile
+    // verilen takma ad, yoksa tablo adidir.
+    LinkedList<std::pair<std::string, std::string>> sides;
+    // Okunan kolon nitelikleri ve konumlari. SELECT listesi FROM'dan once
+    // geldigi icin hepsi parse sonunda dogrulanir.
+    LinkedList<std::pair<std::string, size_t>> qualifiers;
 
-static LinkedList<std::string> split(const std::string& str, char delimiter) {
-    LinkedList<std::string> tokens;
-    std::stringstream ss(str);
-    std::string token;
-    while (std::getline(ss, token, delimiter)) {
-        token = trim(token);
-        if (!token.empty()) {
-            tokens.push_back(token);
+    // table := IDENT [[AS] IDENT]
+    std::string parseTableRef(std::string& alias) {
+        Token name = expect(TokenType::IDENTIFIER, "table name");
+        std::string table_name = name.text();
+        alias = table_name;
+        size_t position = name.position;
+        bool has_as = acceptKeyword(Keyword::AS);
+        if (has_as || lexer.peek().type == TokenType::IDENTIFIER) {
+            Token alias_token = expect(TokenType::IDENTIFIER, "table alias");
+            alias = alias_token.text();
+            position = alias_token.position;
         }
+        for (const auto& side : sides) {
+            if (side.first == alias) {
+                throw QueryParseError("table name '" + alias + "' is used twice, give it an alias", position);
+            }
+        }
+        sides.push_back(std::make_pair(alias, table_name));
+        return table_name;
+    }
+
+    // Kolon niteligini tablonun sorgudaki adina cevirir: once takma adlar,
+    // sonra (tek bir tarafa uyuyorsa) tablo adlari
+    std::string resolveQualifier(const std::string& name, size_t position) const {
+        const std::string* found = nullptr;
+        for (const auto& side : sides) {
+            if (side.first == name) return side.first;
+        }
+        for (const auto& side : sides) {
+            if (side.second != name) continue;
+            if (found) throw QueryParseError("table '" + name + "' is ambiguous, use its alias", position);
+            found = &side.first;
+        }
+        if (!found) throw QueryParseError("unknown table or alias '" + name + "'", position);
+        return *found;
+    }
+
+    // "ad.kolon" -> JOIN varsa "sorgudaki_ad.kolon", yoksa "kolon"
+    void qualifyName(std::string& name, bool joined) const {
+        size_t dot = name.find('.');
+        if (dot == std::string::npos) return;
+        std::string label = resolveQualifier(name.substr(0, dot), 0);
+        std::string column = name.substr(dot + 1);
+        name = joined ? label + "." + column : column;
+    }
+
+    void qualifyExpr(Expr* expr, bool joined) const {
+        if (!expr) return;
+        if (expr->kind == ExprKind::COLUMN && !expr->table_name.empty()) {
+            std::string label = resolveQualifier(expr->table_name, 0);
+            expr->table_name = joined ? label : "";
+        }
+        qualifyExpr(expr->left, joined);
+        qualifyExpr(expr->right, joined);
+        for (auto item : expr->list) qualifyExpr(item, joined);
+    }
+
+    // Butun tablolar okunduktan sonra: nitelikleri dogrular ve kolon
+    // adlarini (bkz. JoinCondition) tek bicime getirir
+    void qualifyColumns(Query* query, LinkedList<std::pair<std::string, size_t>>& plain_columns) {
+        for (const auto& qualifier : qualifiers) resolveQualifier(qualifier.first, qualifier.second);
+
+        bool joined = !query->joins.empty();
+        for (auto& column : query->select_columns) {
+            // Toplama adlari ("SUM(t.v)") oldugu gibi kalir
+            if (column.find('(') == std::string::npos) qualifyName(column, joined);
+        }
+        for (auto& column : plain_columns) qualifyName(column.first, joined);
+        for (auto& column : query->group_by) qualifyName(column, joined);
+        for (auto& item : query->order_by) qualifyName(item.column_name, joined);
+        for (auto& aggregate : query->aggregates) qualifyName(aggregate.column_name, joined);
+        for (auto& join : query->joins) qualifyName(join.left_column, joined);
+        qualifyExpr(query->where, joined);
+    }
+
+    [[noreturn]] void fail(const Token& token, const std::string& expected) {
+        std::string found = token.type == TokenType::END ? "end of query" : "'" + token.text() + "'";
+        throw QueryParseError("expected " + expected + ", found " + found, token.position);
+    }
+
+    bool peekKeyword(Keyword kw) {
+        const Token& token = lexer.peek();
+        return token.type == TokenType::KEYWORD && token.keyword == kw;
+    }
+
+    bool acceptKeyword(Keyword kw) {
+        if (!peekKeyword(kw)) return false;
+        lexer.next();
+        return true;
+    }
+
+    void expectKeyword(Keyword kw, const char* name) {
+        Token token = lexer.next();
+        if (token.type != TokenType::KEYWORD || token.keyword != kw) fail(token, name);
+    }
+
+    bool accept(TokenType type) {
+        if (lexer.peek().type != type) return false;
+        lexer.next();
+        return true;
+    }
+
+    Token expect(TokenType type, const char* name) {
+        Token token = lexer.next();
+        if (token.type != type) fail(token, name);
+        return token;
+    }
+
+    // column := IDENT ['.' IDENT]; ilk token'in konumunu dondurur
+    size_t parseColumnName(std::string& table_name, std::string& column_name) {
+        Token first = expect(TokenType::IDENTIFIER, "column name");
+        if (accept(TokenType::DOT)) {
+            Token second = expect(TokenType::IDENTIFIER, "column name");
+            table_name = first.text();
+            column_name = second.text();
+            qualifiers.push_back(std::make_pair(table_name, first.position));
+        } else {
+            table_name.clear();
+            column_name = first.text();
+        }
+        return first.position;
+    }
+
+    // Nitelenmis kolon "tablo.kolon" olarak saklanir; qualifyColumns cevirir
+    std::string parseColumnRef() {
+        std::string table_name;
+        std::string column_name;
+        parseColumnName(table_name, column_name);
+        return table_name.empty() ? column_name : table_name + "." + column_name;
+    }
+
+    static std::string unescapeString(const Token& token) {
+        std::string out;
+        out.reserve(token.length);
+        for (size_t i = 0; i < token.length; i++) {
+            out.push_back(token.start[i]);
+            if ((token.start[i] == '\'' || token.start[i] == '"') && i + 1 < token.length &&
+                token.start[i + 1] == token.start[i]) {
+                i++;
+            }
+        }
+        return out;
+    }
+
+    // Alt agaclar insa edilirken unique_ptr'da tutulur; parse hatasinda
+    // exception yarim kalan agaci serbest birakir.
+    typedef std::unique_ptr<Expr> ExprPtr;
+
+    static Expr* makeBinary(ExprKind kind, ExprPtr& left, ExprPtr right) {
+        Expr* e = new Expr(kind);
+        e->left = left.release();
+        e->right = right.release();
+        return e;
+    }
+
+    Expr* parseFactor() {
+        Token token = lexer.next();
+        switch (token.type) {
+            case TokenType::NUMBER: {
+                Expr* e = new Expr(ExprKind::LITERAL);
+                e->literal_type = LiteralType::NUMBER;
+                e->text = token.text();
+                e->number = std::strtod(e->text.c_str(), nullptr);
+                e->is_integer = e->text.find_first_of(".eE") == std::string::npos;
+                return e;
+            }
+            case TokenType::STRING: {
+                Expr* e = new Expr(ExprKind::LITERAL);
+                e->literal_type = LiteralType::STRING;
+                e->text = unescapeString(token);
+                return e;
+            }
+            case TokenType::IDENTIFIER: {
+                ExprPtr e(new Expr(ExprKind::COLUMN));
+                e->column_name = token.text();
+                if (accept(TokenType::DOT)) {
+                    e->table_name = e->column_name;
+                    e->column_name = expect(TokenType::IDENTIFIER, "column name").text();
+                    qualifiers.push_back(std::make_pair(e->table_name, token.position));
+                }
+                return e.release();
+            }
+            case TokenType::PARAM: {
+                Expr* e = new Expr(ExprKind::PARAMETER);
+                e->param_index = paramCount++;
+                return e;
+            }
+            case TokenType::LPAREN: {
+                ExprPtr e(parseExpr());
+                expect(TokenType::RPAREN, "')'");
+                return e.release();
+            }
+            case TokenType::MINUS: {
+                ExprPtr operand(parseFactor());
+                if (operand->kind == ExprKind::LITERAL && operand->literal_type == LiteralType::NUMBER) {
+                    operand->number = -operand->number;
+                    operand->text = "-" + operand->text;
+                    return operand.release();
+                }
+                Expr* e = new Expr(ExprKind::ARITHMETIC);
+                e->arith_op = ArithmeticOperator::SUBTRACT;
+                e->right = operand.release();  // left == nullptr: tekli eksi
+                return e;
+            }
+            case TokenType::KEYWORD:
+                if (token.keyword == Keyword::NULL_KW) return new Expr(ExprKind::LITERAL);
+                break;
+            default:
+                break;
+        }
+        fail(token, "value or column");
+    }
+
+    Expr* parseTerm() {
+        ExprPtr left(parseFactor());
+        while (lexer.peek().type == TokenType::STAR || lexer.peek().type == TokenType::SLASH) {
+            Token op = lexer.next();
+            ExprPtr right(parseFactor());
+            left.reset(makeBinary(ExprKind::ARITHMETIC, left, std::move(right)));
+            left->arith_op = op.type == TokenType::STAR ? ArithmeticOperator::MULTIPLY : ArithmeticOperator::DIVIDE;
+        }
+        return left.release();
+    }
+
+    Expr* parseAdditive() {
+        ExprPtr left(parseTerm());
+        while (lexer.peek().type == TokenType::PLUS || lexer.peek().type == TokenType::MINUS) {
+            Token op = lexer.next();
+            ExprPtr right(parseTerm());
+            left.reset(makeBinary(ExprKind::ARITHMETIC, left, std::move(right)));
+            left->arith_op = op.type == TokenType::PLUS ? ArithmeticOperator::ADD : ArithmeticOperator::SUBTRACT;
+        }
+        return left.release();
+    }
+
+    static bool comparisonOperator(TokenType type, ComparisonOperator& op) {
+        switch (type) {
+            case TokenType::EQUAL: op = ComparisonOperator::EQUAL; return true;
+            case TokenType::NOT_EQUAL: op = ComparisonOperator::NOT_EQUAL; return true;
+            case TokenType::LESS: op = ComparisonOperator::LESS_THAN; return true;
+            case TokenType::LESS_EQUAL: op = ComparisonOperator::LESS_EQUAL; return true;
+            case TokenType::GREATER: op = ComparisonOperator::GREATER_THAN; return true;
+            case TokenType::GREATER_EQUAL: op = ComparisonOperator::GREATER_EQUAL; return true;
+            default: return false;
+        }
+    }
+
+    Expr* parsePredicate() {
+        ExprPtr left(parseAdditive());
+
+        ComparisonOperator op;
+        if (comparisonOperator(lexer.peek().type, op)) {
+            lexer.next();
+            ExprPtr right(parseAdditive());
+            Expr* e = makeBinary(ExprKind::COMPARISON, left, std::move(right));
+            e->op = op;
+            return e;
+        }
+
+        bool negated = false;
+        if (acceptKeyword(Keyword::NOT)) {
+            negated = true;
+            if (!peekKeyword(Keyword::IN) && !peekKeyword(Keyword::LIKE)) fail(lexer.peek(), "IN or LIKE after NOT");
+        }
+
+        if (acceptKeyword(Keyword::IN)) {
+            ExprPtr e(new Expr(ExprKind::IN_LIST));
+            e->left = left.release();
+            e->negated = negated;
+            expect(TokenType::LPAREN, "'(' after IN");
+            do {
+                e->list.push_back(parseAdditive());
+            } while (accept(TokenType::COMMA));
+            expect(TokenType::RPAREN, "')'");
+            return e.release();
+        }
+
+        if (acceptKeyword(Keyword::LIKE)) {
+            ExprPtr right(parseAdditive());
+            ExprPtr e(makeBinary(ExprKind::COMPARISON, left, std::move(right)));
+            e->op = ComparisonOperator::LIKE;
+            if (!negated) return e.release();
+            Expr* n = new Expr(ExprKind::NOT);
+            n->left = e.release();
+            return n;
+        }
+
+        if (acceptKeyword(Keyword::IS)) {
+            ExprPtr e(new Expr(ExprKind::IS_NULL));
+            e->left = left.release();
+            e->negated = acceptKeyword(Keyword::NOT);
+            expectKeyword(Keyword::NULL_KW, "NULL");
+            return e.release();
+        }
+
+        return left.release();
+    }
+
+    Expr* parseNot() {
+        if (acceptKeyword(Keyword::NOT)) {
+            ExprPtr operand(parseNot());
+            Expr* e = new Expr(ExprKind::NOT);
+            e->left = operand.release();
+            return e;
+        }
+        return parsePredicate();
+    }
+
+    Expr* parseAnd() {
+        ExprPtr left(parseNot());
+        while (acceptKeyword(Keyword::AND)) {
+            ExprPtr right(parseNot());
+            left.reset(makeBinary(ExprKind::AND, left, std::move(right)));
+        }
+        return left.release();
+    }
+
+    Expr* parseExpr() {
+        ExprPtr left(parseAnd());
+        while (acceptKeyword(Keyword::OR)) {
+            ExprPtr right(parseAnd());
+            left.reset(makeBinary(ExprKind::OR, left, std::move(right)));
+        }
+        return left.release();
+    }
+
+    static bool aggregateFunction(const Token& token, AggregateFunction& function, const char*& name) {
+        static const struct {
+            const char* name;
+            AggregateFunction function;
+        } FUNCTIONS[] = {{"COUNT", AggregateFunction::COUNT}, {"SUM", AggregateFunction::SUM},
+                         {"AVG", AggregateFunction::AVG},     {"MIN", AggregateFunction::MIN},
+                         {"MAX", AggregateFunction::MAX}};
+        for (const auto& entry : FUNCTIONS) {
+            if (token_equals_ignore_case(token, entry.name)) {
+                function = entry.function;
+                name = entry.name;
+                return true;
+            }
+        }
+        return false;
     }
-    return tokens;
-}
 
-static std::string toUpper(const std::string& str) {
-    std::string result = str;
-    std::transform(result.begin(), result.end(), result.begin(), ::toupper);
-    return result;
+    // aggregate := FUNC '(' ('*' | column) ')' [[AS] IDENT]; FUNC ve '(' okunmus
+    void parseAggregate(Query* query, const Token& name_token) {
+        SelectAggregate aggregate;
+        const char* name;
+        if (!aggregateFunction(name_token, aggregate.function, name)) fail(name_token, "aggregate function");
+
+        if (accept(TokenType::STAR)) {
+            if (aggregate.function != AggregateFunction::COUNT) fail(lexer.peek(), "column name");
+        } else {
+            aggregate.column_name = parseColumnRef();
+        }
+        expect(TokenType::RPAREN, "')'");
+
+        aggregate.output_name = std::string(name) + "(" +
+                                (aggregate.column_name.empty() ? "*" : aggregate.column_name) + ")";
+        bool has_as = acceptKeyword(Keyword::AS);
+        if (has_as || lexer.peek().type == TokenType::IDENTIFIER) {
+            aggregate.output_name = expect(TokenType::IDENTIFIER, "column alias").text();
+        }
+        query->select_columns.push_back(aggregate.output_name);
+        query->aggregates.push_back(aggregate);
+    }
+
+    void parseSelectList(Query* query, LinkedList<std::pair<std::string, size_t>>& plain_columns) {
+        if (accept(TokenType::STAR)) return;
+        do {
+            Token first = expect(TokenType::IDENTIFIER, "column name or '*'");
+            if (accept(TokenType::LPAREN)) {
+                parseAggregate(query, first);
+                continue;
+            }
+            std::string column_name = first.text();
+            if (accept(TokenType::DOT)) {
+                qualifiers.push_back(std::make_pair(column_name, first.position));
+                // tablo.* -> o tablonun kolonlari (JOIN yoksa hepsi, "*")
+                if (accept(TokenType::STAR)) {
+                    query->select_columns.push_back(column_name + ".*");
+                    continue;
+                }
+                column_name += "." + expect(TokenType::IDENTIFIER, "column name").text();
+            }
+            query->select_columns.push_back(column_name);
+            plain_columns.push_back(std::make_pair(column_name, first.position));
+        } while (accept(TokenType::COMMA));
+    }
+
+    void parseGroupBy(Query* query) {
+        do {
+            query->group_by.push_back(parseColumnRef());
+        } while (accept(TokenType::COMMA));
+    }
+
+    // Toplamali sorguda SELECT'teki duz kolonlar GROUP BY'da olmali
+    void checkGrouping(const Query* query, const LinkedList<std::pair<std::string, size_t>>& plain_columns,
+                       size_t select_position) {
+        if (query->aggregates.empty() && query->group_by.empty()) return;
+        if (query->select_columns.empty()) {
+            throw QueryParseError("SELECT * cannot be used with GROUP BY", select_position);
+        }
+        for (const auto& column : query->select_columns) {
+            if (column == "*" || column.find(".*") != std::string::npos) {
+                throw QueryParseError("SELECT * cannot be used with GROUP BY", select_position);
+            }
+        }
+        for (const auto& column : plain_columns) {
+            bool grouped = false;
+            for (const auto& group : query->group_by) {
+                if (group == column.first) grouped = true;
+            }
+            if (!grouped) {
+                throw QueryParseError("column '" + column.first + "' must appear in GROUP BY or an aggregate",
+                                      column.second);
+            }
+        }
+    }
+
+    bool parseJoin(Query* query) {
+        JoinType join_type = JoinType::INNER;
+        if (acceptKeyword(Keyword::INNER)) {
+            join_type = JoinType::INNER;
+        } else if (acceptKeyword(Keyword::LEFT)) {
+            join_type = JoinType::LEFT;
+            acceptKeyword(Keyword::OUTER);
+        } else if (acceptKeyword(Keyword::RIGHT)) {
+            join_type = JoinType::RIGHT;
+            acceptKeyword(Keyword::OUTER);
+        } else if (acceptKeyword(Keyword::FULL)) {
+            join_type = JoinType::FULL;
+            acceptKeyword(Keyword::OUTER);
+        } else if (!peekKeyword(Keyword::JOIN)) {
+            return false;
+        }
+        expectKeyword(Keyword::JOIN, "JOIN");
+
+        JoinCondition join;
+        join.join_type = join_type;
+        join.right_table = parseTableRef(join.right_alias);
+        expectKeyword(Keyword::ON, "ON");
+        std::string on_left_table;
+        std::string on_right_table;
+        size_t left_position = parseColumnName(on_left_table, join.left_column);
+        expect(TokenType::EQUAL, "'=' in JOIN condition");
+        size_t right_position = parseColumnName(on_right_table, join.right_column);
+        if (!on_left_table.empty()) on_left_table = resolveQualifier(on_left_table, left_position);
+        if (!on_right_table.empty()) on_right_table = resolveQualifier(on_right_table, right_position);
+
+        // "ON sag.kolon = sol.kolon" yazildiysa taraflari yer degistir
+        if (!on_left_table.empty() && on_left_table == join.right_alias && on_right_table != join.right_alias) {
+            std::swap(on_left_table, on_right_table);
+            std::swap(join.left_column, join.right_column);
+            std::swap(left_position, right_position);
+        }
+        if (on_left_table == join.right_alias) {
+            throw QueryParseError("JOIN condition must compare a column of an earlier table", left_position);
+        }
+        if (!on_right_table.empty() && on_right_table != join.right_alias) {
+            throw QueryParseError("JOIN condition must compare a column of '" + join.right_alias + "'",
+                                  right_position);
+        }
+        // Sag kolon sag tablonun kendi adiyla kalir; sol kolon onceki
+        // tablolarin birlesiminde aranir
+        join.left_table = on_left_table;
+        if (!on_left_table.empty()) join.left_column = on_left_table + "." + join.left_column;
+        query->joins.push_back(join);
+        return true;
+    }
+
+    void parseOrderBy(Query* query) {
+        do {
+            OrderByColumn item;
+            item.column_name = parseColumnRef();
+            item.ascending = true;
+            if (acceptKeyword(Keyword::DESC)) item.ascending = false;
+            else acceptKeyword(Keyword::ASC);
+            query->order_by.push_back(item);
+        } while (accept(TokenType::COMMA));
+    }
+
+    // LIMIT/OFFSET degeri: 0..INT_MAX arasi tamsayi ('-' ayri token oldugu
+    // icin negatif sayi buraya NUMBER olarak gelmez)
+    int parseCount(const char* what) {
+        Token token = expect(TokenType::NUMBER, what);
+        std::string text = token.text();
+        if (text.find_first_of(".eE") != std::string::npos) fail(token, what);
+        errno = 0;
+        char* end = nullptr;
+        long long value = std::strtoll(text.c_str(), &end, 10);
+        if (errno == ERANGE || *end != '\0' || value < 0 || value > INT_MAX) {
+            throw QueryParseError(std::string(what) + " must be between 0 and " + std::to_string(INT_MAX) +
+                                      ", found '" + text + "'",
+                                  token.position);
+        }
+        return static_cast<int>(value);
+    }
+
+public:
+    explicit QueryParser(const std::string& query_string) : lexer(query_string), paramCount(0) {}
+
+    void parse(Query* query) {
+        expectKeyword(Keyword::SELECT, "SELECT");
+        size_t select_position = lexer.peek().position;
+        LinkedList<std::pair<std::string, size_t>> plain_columns;
+        parseSelectList(query, plain_columns);
+        expectKeyword(Keyword::FROM, "FROM");
+        query->from_tables.push_back(parseTableRef(query->from_alias));
+
+        while (parseJoin(query)) {
+        }
+
+        if (acceptKeyword(Keyword::WHERE)) query->where = parseExpr();
+
+        if (acceptKeyword(Keyword::GROUP)) {
+            expectKeyword(Keyword::BY, "BY");
+            parseGroupBy(query);
+        }
+
+        if (acceptKeyword(Keyword::ORDER)) {
+            expectKeyword(Keyword::BY, "BY");
+            parseOrderBy(query);
+        }
+
+        if (acceptKeyword(Keyword::LIMIT)) {
+            query->limit = parseCount("row count after LIMIT");
+            if (acceptKeyword(Keyword::OFFSET)) query->offset = parseCount("row count after OFFSET");
+        }
+
+        accept(TokenType::SEMICOLON);
+        Token end = lexer.next();
+        if (end.type != TokenType::END) fail(end, "end of query");
+
+        qualifyColumns(query, plain_columns);
+        checkGrouping(query, plain_columns, select_position);
+        query->param_count = paramCount;
+    }
+};
+
+// WHERE agacinin en ustteki AND zincirinden "kolon op sabit" kosullarini
+// QueryCondition listesine cikarir (indeks secimi icin)
+static void collect_conditions(const Expr* expr, LinkedList<QueryCondition>& conditions) {
+    if (!expr) return;
+    if (expr->kind == ExprKind::AND) {
+        collect_conditions(expr->left, conditions);
+        collect_conditions(expr->right, conditions);
+        return;
+    }
+    if (expr->kind != ExprKind::COMPARISON || expr->op == ComparisonOperator::LIKE) return;
+
+    const Expr* column = expr->left;
+    const Expr* literal = expr->right;
+    ComparisonOperator op = expr->op;
+    if ((column->kind == ExprKind::LITERAL || column->kind == ExprKind::PARAMETER) &&
+        literal->kind == ExprKind::COLUMN) {
+        std::swap(column, literal);
+        // "5 < x" == "x > 5"
+        switch (op) {
+            case ComparisonOperator::LESS_THAN: op = ComparisonOperator::GREATER_THAN; break;
+            case ComparisonOperator::LESS_EQUAL: op = ComparisonOperator::GREATER_EQUAL; break;
+            case ComparisonOperator::GREATER_THAN: op = ComparisonOperator::LESS_THAN; break;
+            case ComparisonOperator::GREATER_EQUAL: op = ComparisonOperator::LESS_EQUAL; break;
+            default: break;
+        }
+    }
+    if (column->kind != ExprKind::COLUMN) return;
+    if (literal->kind != ExprKind::LITERAL && literal->kind != ExprKind::PARAMETER) return;
+    if (literal->kind == ExprKind::LITERAL && literal->literal_type == LiteralType::NULL_VALUE) return;
+
+    QueryCondition condition;
+    condition.column_name = column->columnRef();
+    condition.op = op;
+    condition.value = literal->text;
+    condition.logical_op = LogicalOperator::AND;
+    condition.param_index = literal->param_index;
+    conditions.push_back(condition);
 }
 
 Query* query_parse(const std::string& query_string) {
     if (query_string.empty()) return nullptr;
-    
+
     Query* query = new Query();
-    std::string upper_query = toUpper(query_string);
-    
-    size_t select_pos = upper_query.find("SELECT");
-    size_t from_pos = upper_query.find("FROM");
-    size_t where_pos = upper_query.find("WHERE");
-    size_t join_pos = upper_query.find("JOIN");
-    size_t order_pos = upper_query.find("ORDER BY");
-    size_t limit_pos = upper_query.find("LIMIT");
-    
-    // 1. SELECT
-    if (select_pos != std::string::npos && from_pos != std::string::npos) {
-        std::string select_clause = query_string.substr(select_pos + 6, from_pos - select_pos - 6);
-        LinkedList<std::string> cols = split(select_clause, ',');
-        for (auto it = cols.begin(); it != cols.end(); ++it) {
-            std::string c = *it;
-            if (c != "*") query->select_columns.push_back(c);
-        }
-    }
-    
-    // 2. FROM
-    if (from_pos != std::string::npos) {
-        size_t from_end = where_pos;
-        // Eğer JOIN varsa FROM orada biter
-        if (join_pos != std::string::npos && (from_end == std::string::npos || join_pos < from_end)) from_end = join_pos;
-        if (from_end == std::string::npos) from_end = order_pos;
-        if (from_end == std::string::npos) from_end = limit_pos;
-        if (from_end == std::string::npos) from_end = query_string.length();
-        
-        std::string from_clause = query_string.substr(from_pos + 4, from_end - from_pos - 4);
-        query->from_tables.push_back(trim(from_clause));
-    }
-
-    // 3. JOIN (YENİ EKLENEN KISIM)
-    if (join_pos != std::string::npos) {
-        size_t on_pos = upper_query.find("ON", join_pos);
-        if (on_pos != std::string::npos) {
-            // Tablo Adı: JOIN ile ON arası
-            std::string table_part = query_string.substr(join_pos + 4, on_pos - (join_pos + 4));
-            
-            // Koşul: ON ile sonraki keyword arası
-            size_t cond_start = on_pos + 2;
-            size_t cond_end = where_pos;
-            if (cond_end == std::string::npos) cond_end = order_pos;
-            if (cond_end == std::string::npos) cond_end = limit_pos;
-            if (cond_end == std::string::npos) cond_end = query_string.length();
-            
-            std::string cond_str = query_string.substr(cond_start, cond_end - cond_start);
-            cond_str = trim(cond_str);
-            
-            // "ID = UserID" gibi bir ifadeyi parçala
-            size_t eq_pos = cond_str.find('=');
-            if (eq_pos != std::string::npos) {
-                JoinCondition join;
-                join.right_table = trim(table_part);
-                join.left_column = trim(cond_str.substr(0, eq_pos));  // Örn: ID
-                join.right_column = trim(cond_str.substr(eq_pos + 1)); // Örn: UserID
-                join.join_type = JoinType::INNER;
-                query->joins.push_back(join);
-            }
-        }
+    try {
+        QueryParser parser(query_string);
+        parser.parse(query);
+    } catch (const QueryParseError& e) {
+        std::cerr << "[PARSE] " << e.what() << " (position " << e.position << ")" << std::endl;
+        delete query;
+        return nullptr;
     }
-    
-    // 4. WHERE
-    if (where_pos != std::string::npos) {
-        size_t where_end = order_pos; 
-        if (where_end == std::string::npos) where_end = limit_pos;
-        if (where_end == std::string::npos) where_end = query_string.length();
-        
-        std::string where_clause = query_string.substr(where_pos + 5, where_end - where_pos - 5);
-        where_clause = trim(where_clause);
-        
-        // Basit Operatör kontrolü
-        std::string opStr = "=";
-        ComparisonOperator opEnum = ComparisonOperator::EQUAL;
-        size_t opPos = std::string::npos;
-        
-        if ((opPos = where_clause.find(">=")) != std::string::npos) { opStr = ">="; opEnum = ComparisonOperator::GREATER_EQUAL; }
-        else if ((opPos = where_clause.find("<=")) != std::string::npos) { opStr = "<="; opEnum = ComparisonOperator::LESS_EQUAL; }
-        else if ((opPos = where_clause.find("!=")) != std::string::npos) { opStr = "!="; opEnum = ComparisonOperator::NOT_EQUAL; }
-        else if ((opPos = where_clause.find("=")) != std::string::npos) { opStr = "="; opEnum = ComparisonOperator::EQUAL; }
-        else if ((opPos = where_clause.find(">")) != std::string::npos) { opStr = ">"; opEnum = ComparisonOperator::GREATER_THAN; }
-        else if ((opPos = where_clause.find("<")) != std::string::npos) { opStr = "<"; opEnum = ComparisonOperator::LESS_THAN; }
-
-        if (opPos != std::string::npos) {
-            QueryCondition condition;
-            condition.column_name = trim(where_clause.substr(0, opPos));
-            condition.value = trim(where_clause.substr(opPos + opStr.length()));
-            condition.op = opEnum;
-            condition.logical_op = LogicalOperator::AND;
-            query->conditions.push_back(condition);
-        }
-    }
-    
-    query->order_asc = true;
-    query->limit = -1;
-    query->offset = 0;
-    
+
+    collect_conditions(query->where, query->conditions);
     return query;
 }
 
@@ -143,9 +644,71 @@ void query_destroy(Query* query) {
     if (query) delete query;
 }
 
+static const char* comparison_text(ComparisonOperator op) {
+    switch (op) {
+        case ComparisonOperator::EQUAL: return "=";
+        case ComparisonOperator::NOT_EQUAL: return "!=";
+        case ComparisonOperator::LESS_THAN: return "<";
+        case ComparisonOperator::LESS_EQUAL: return "<=";
+        case ComparisonOperator::GREATER_THAN: return ">";
+        case ComparisonOperator::GREATER_EQUAL: return ">=";
+        case ComparisonOperator::LIKE: return "LIKE";
+    }
+    return "?";
+}
+
+static const char* arithmetic_text(ArithmeticOperator op) {
+    switch (op) {
+        case ArithmeticOperator::ADD: return "+";
+        case ArithmeticOperator::SUBTRACT: return "-";
+        case ArithmeticOperator::MULTIPLY: return "*";
+        case ArithmeticOperator::DIVIDE: return "/";
+    }
+    return "?";
+}
+
+std::string expr_to_string(const Expr* expr) {
+    if (!expr) return "";
+    switch (expr->kind) {
+        case ExprKind::COLUMN:
+            return expr->columnRef();
+        case ExprKind::LITERAL:
+            if (expr->literal_type == LiteralType::NULL_VALUE) return "NULL";
+            if (expr->literal_type == LiteralType::NUMBER) return expr->text;
+            return "'" + expr->text + "'";
+        case ExprKind::COMPARISON:
+            return expr_to_string(expr->left) + " " + comparison_text(expr->op) + " " + expr_to_string(expr->right);
+        case ExprKind::AND:
+            return "(" + expr_to_string(expr->left) + " AND " + expr_to_string(expr->right) + ")";
+        case ExprKind::OR:
+            return "(" + expr_to_string(expr->left) + " OR " + expr_to_string(expr->right) + ")";
+        case ExprKind::NOT:
+            return "NOT " + expr_to_string(expr->left);
+        case ExprKind::ARITHMETIC:
+            if (!expr->left) return "-" + expr_to_string(expr->right);
+            return "(" + expr_to_string(expr->left) + " " + arithmetic_text(expr->arith_op) + " " +
+                   expr_to_string(expr->right) + ")";
+        case ExprKind::IN_LIST: {
+            std::string out = expr_to_string(expr->left) + (expr->negated ? " NOT IN (" : " IN (");
+            bool first = true;
+            for (auto item : expr->list) {
+                if (!first) out += ", ";
+                out += expr_to_string(item);
+                first = false;
+            }
+            return out + ")";
+        }
+        case ExprKind::IS_NULL:
+            return expr_to_string(expr->left) + (expr->negated ? " IS NOT NULL" : " IS NULL");
+        case ExprKind::PARAMETER:
+            return "?";
+    }
+    return "";
+}
+
 void query_print(const Query* query) {
     if (!query) return;
-    
+
     std::cout << "Query:\n";
     std::cout << "  SELECT: ";
     if (query->select_columns.empty()) {
@@ -156,23 +719,42 @@ void query_print(const Query* query) {
         }
         std::cout << "\n";
     }
-    
+
     std::cout << "  FROM: ";
     for (auto it = query->from_tables.begin(); it != query->from_tables.end(); ++it) {
         std::cout << *it << " ";
     }
     std::cout << "\n";
-    
-    if (!query->conditions.empty()) {
-        std::cout << "  WHERE: ";
-        for (auto it = query->conditions.begin(); it != query->conditions.end(); ++it) {
-            const QueryCondition& cond = *it;
-            std::cout << cond.column_name << " = " << cond.value << " ";
-        }
-        std::cout << "\n";
+
+    for (const auto& join : query->joins) {
+        std::cout << "  JOIN: " << join.right_table << " ON " << join.left_column << " = " << join.right_column << "\n";
+    }
+
+    if (query->where) {
+        std::cout << "  WHERE: " << expr_to_string(query->where) << "\n";
     } else {
         std::cout << "  WHERE: (none)\n";
     }
-    
+
+    if (!query->group_by.empty()) {
+        std::cout << "  GROUP BY: ";
+        for (const auto& column : query->group_by) std::cout << column << " ";
+        std::cout << "\n";
+    }
+
+    for (const auto& aggregate : query->aggregates) {
+        std::cout << "  AGGREGATE: " << aggregate.output_name << "\n";
+    }
+
+    if (!query->order_by.empty()) {
+        std::cout << "  ORDER BY: ";
+        for (const auto& item : query->order_by) {
+            std::cout << item.column_name << (item.ascending ? " ASC " : " DESC ");
+        }
+        std::cout << "\n";
+    }
+
+    if (query->limit >= 0) std::cout << "  LIMIT: " << query->limit << " OFFSET: " << query->offset << "\n";
+
     std::cout << "  SELECT columns count: " << query->select_columns.size() << "\n";
-}
\ No newline at end of file
+}
@@ -0,0 +1,298 @@
+#include "../../../include/engine/query/shard_engine.hpp"
+#include "../../../include/engine/query/query_binder.hpp"
+#include "../../../include/engine/query/expr_compiler.hpp"
+#include "../../../include/engine/query/query_optimizer.hpp"
+#include "../../../include/core/Cell.hpp"
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <system_error>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+ShardedTable::ShardedTable(const std::string& tableName, const LinkedList<std::string>& colNames,
+                           const LinkedList<std::string>& colTypes, size_t shardCount)
+    : name(tableName), nextId(1) {
+    unsigned cpus = std::thread::hardware_concurrency();
+    if (shardCount == 0) shardCount = cpus;
+    shardCount = std::min(std::max<size_t>(shardCount, 1), maxShardCount());
+
+    for (size_t i = 0; i < shardCount; i++) {
+        Shard* shard = new Shard();
+        shard->table = new Table(tableName, colNames, colTypes);
+        shard->table->enableDictionaryEncoding();
+        shard->db.addTable(shard->table);
+        try {
+            shard->worker = std::thread([this, shard]() { workerLoop(shard); });
+        } catch (const std::system_error& e) {
+            std::cerr << "Hata: Parca thread'i acilamadi (" << name << "): " << e.what() << std::endl;
+            delete shard;
+            stopShards();
+            throw;
+        }
+#ifdef __linux__
+        // Parca i, CPU i'ye sabitlenir: satirlari ve indeksleri o cekirdegin
+        // cache'inde kalir. Sabitlenemezse parca sabitlenmeden calisir.
+        if (cpus > 0) {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(i % cpus, &set);
+            int error = pthread_setaffinity_np(shard->worker.native_handle(), sizeof(set), &set);
+            if (error != 0) {
+                std::cerr << "Uyari: Parca " << i << " CPU " << (i % cpus) << "'ye sabitlenemedi: "
+                          << std::system_category().message(error) << std::endl;
+            }
+        }
+#endif
+        shards.push_back(shard);
+    }
+}
+
+size_t ShardedTable::maxShardCount() {
+    unsigned cpus = std::thread::hardware_concurrency();
+    return MAX_SHARDS_PER_CPU * (cpus > 0 ? cpus : 1);
+}
+
+ShardedTable::~ShardedTable() {
+    stopShards();
+}
+
+void ShardedTable::stopShards() {
+    for (Shard* shard : shards) {
+        {
+            std::lock_guard<std::mutex> lock(shard->mutex);
+            shard->stopping = true;
+        }
+        shard->condition.notify_one();
+    }
+    for (Shard* shard : shards) {
+        shard->worker.join();
+        delete shard;
+    }
+    shards.clear();
+}
+
+void ShardedTable::workerLoop(Shard* shard) {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(shard->mutex);
+            shard->condition.wait(lock, [shard]() { return shard->stopping || !shard->tasks.empty(); });
+            if (shard->stopping && shard->tasks.empty()) return;
+            task = std::move(shard->tasks.front());
+            shard->tasks.pop_front();
+        }
+        task();
+    }
+}
+
+std::future<void> ShardedTable::submit(size_t index, std::function<void()> task) {
+    auto job = std::make_shared<std::packaged_task<void()>>(std::move(task));
+    std::future<void> done = job->get_future();
+    Shard* shard = shards[index];
+    {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        shard->tasks.push_back([job]() { (*job)(); });
+    }
+    shard->condition.notify_one();
+    return done;
+}
+
+size_t ShardedTable::shardOf(int id) const {
+    // Ardisik id'ler parcalara dagilsin
+    uint64_t h = static_cast<uint64_t>(static_cast<uint32_t>(id)) * 0x9E3779B97F4A7C15ULL;
+    return static_cast<size_t>(h >> 32) % shards.size();
+}
+
+int ShardedTable::nextRowId() {
+    return nextId.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool ShardedTable::insertRow(Row* row) {
+    int id = row->getId();
+    Shard* shard = shards[shardOf(id)];
+    bool inserted = false;
+    submit(shardOf(id), [shard, row, &inserted]() {
+        inserted = shard->table->canInsert(row);
+        if (inserted) shard->table->insertRow(row);
+    }).get();
+    if (!inserted) return false;
+
+    // Disaridan verilen id sayacin ilerisindeyse sayac onun arkasina gecer
+    int next = nextId.load(std::memory_order_relaxed);
+    while (id < INT_MAX && next <= id &&
+           !nextId.compare_exchange_weak(next, id + 1, std::memory_order_relaxed)) {
+    }
+    return true;
+}
+
+bool ShardedTable::removeRow(int id) {
+    Shard* shard = shards[shardOf(id)];
+    bool found = false;
+    submit(shardOf(id), [shard, id, &found]() {
+        found = shard->table->getRowById(id) != nullptr;
+        if (found) shard->table->removeRow(id);
+    }).get();
+    return found;
+}
+
+size_t ShardedTable::getRowCount() {
+    std::vector<size_t> counts(shards.size(), 0);
+    std::vector<std::future<void>> done;
+    for (size_t i = 0; i < shards.size(); i++) {
+        Shard* shard = shards[i];
+        done.push_back(submit(i, [shard, &counts, i]() { counts[i] = shard->table->getRowCount(); }));
+    }
+    size_t total = 0;
+    for (size_t i = 0; i < shards.size(); i++) {
+        done[i].get();
+        total += counts[i];
+    }
+    return total;
+}
+
+// Kolon listeleri parca tablolarinda kurulduktan sonra degismez
+const LinkedList<std::string>& ShardedTable::getColumns() const { return shards[0]->table->getColumns(); }
+const LinkedList<std::string>& ShardedTable::getTypes() const { return shards[0]->table->getTypes(); }
+int ShardedTable::getKeyColumnIndex() const { return shards[0]->table->getKeyColumnIndex(); }
+
+static Row* copy_shard_row(Row* row) {
+    Row* new_row = new Row(row->getId());
+    for (auto cell : row->getCells()) new_row->addCopy(cell);
+    return new_row;
+}
+
+// Parca sonuclari: exception'da (ornegin baska bir parca hata verdiginde)
+// toplanmis kopyalar serbest kalir
+typedef std::vector<std::unique_ptr<Row>> ShardRows;
+
+// Parcanin worker'inda: WHERE'e uyan satirlarin kopyalari. need >= 0 ise
+// parca en fazla need satir dondurur; ORDER BY varsa bunlar parcanin
+// siralamadaki ilk need satiridir (top-K), yoksa ilk need eslesme.
+static ShardRows scan_shard(Table* table, const Query* query, const QueryParams* params, long long need) {
+    ShardRows out;
+    std::unique_ptr<BoundExpr> bound(query->where ? query_bind_expr(query->where, table, params) : nullptr);
+    CompiledPredicate predicate(bound.get());
+    bool top_k = need >= 0 && !query->order_by.empty();
+
+    if (!top_k) {
+        for (Row* row : table->getRows()) {
+            if (need >= 0 && static_cast<long long>(out.size()) >= need) break;
+            if (bound && !predicate.matches(row)) continue;
+            out.emplace_back(copy_shard_row(row));
+        }
+        return out;
+    }
+
+    std::unique_ptr<Table> matched(new Table(table->getName(), table->getColumns(), table->getTypes()));
+    for (Row* row : table->getRows()) {
+        if (!bound || predicate.matches(row)) matched->insertRow(copy_shard_row(row));
+    }
+    Table* sorted = query_apply_order_by(matched.get(), query->order_by, need);
+    std::unique_ptr<Table> sorted_owner(sorted != matched.get() ? sorted : nullptr);
+    for (Row* row : sorted->getRows()) {
+        if (static_cast<long long>(out.size()) >= need) break;
+        out.emplace_back(copy_shard_row(row));
+    }
+    return out;
+}
+
+// Birlesik tabloda calisacak sorgu: WHERE parcalarda uygulandi, burada
+// tekrar degerlendirilmez. Query kopyalanamaz; kalan kisimlar tasinir.
+static void copy_without_where(const Query* query, Query& out) {
+    for (const auto& column : query->select_columns) out.select_columns.push_back(column);
+    for (const auto& table : query->from_tables) out.from_tables.push_back(table);
+    out.from_alias = query->from_alias;
+    for (const auto& aggregate : query->aggregates) out.aggregates.push_back(aggregate);
+    for (const auto& column : query->group_by) out.group_by.push_back(column);
+    for (const auto& item : query->order_by) out.order_by.push_back(item);
+    out.limit = query->limit;
+    out.offset = query->offset;
+    out.param_count = query->param_count;
+}
+
+Table* ShardedTable::execute(const Query* query, const QueryParams* params) {
+    if (!query) return nullptr;
+    if (!query->joins.empty()) {
+        std::cerr << "Hata: Parcali tabloda (" << name << ") JOIN desteklenmiyor" << std::endl;
+        return nullptr;
+    }
+
+    // id = k: satir tek parcada, sorgu orada oldugu gibi calisir. Anahtar
+    // kolonu id'den farkli bir satir varsa parca tahmin edilemez.
+    bool key_routed = true;
+    for (Shard* shard : shards) {
+        if (shard->table->getKeyColumnIndex() < 0) key_routed = false;
+    }
+    int point_key;
+    if (key_routed && access_path_point_key(shards[0]->table, query->conditions, params, point_key)) {
+        size_t index = shardOf(point_key);
+        Shard* shard = shards[index];
+        Table* result = nullptr;
+        Arena* arena = Arena::current();
+        submit(index, [shard, query, params, arena, &result]() {
+            ArenaScope scope(arena);
+            result = query_execute(&shard->db, query, params);
+        }).get();
+        return result;
+    }
+
+    // Parcalar ayni semayi paylasir; WHERE bir kez ilk parcaya baglanarak
+    // denetlenir, baglanamazsa hicbir parcaya gonderilmez
+    if (query->where) {
+        BoundExpr* check = query_bind_expr(query->where, shards[0]->table, params);
+        if (!check) return nullptr;
+        delete check;
+    }
+
+    // Scatter: her parca kendi satirlarini suzer. Toplama yoksa LIMIT parcalara
+    // itilir (her parcadan offset + limit satir yeter).
+    bool aggregating = !query->aggregates.empty() || !query->group_by.empty();
+    long long need = (query->limit >= 0 && !aggregating) ? static_cast<long long>(query->limit) + query->offset : -1;
+    // Kopyalar cagiranin arena'sindan ayrilir (varsa)
+    std::vector<ShardRows> parts(shards.size());
+    std::vector<std::future<void>> done;
+    Arena* arena = Arena::current();
+    try {
+        for (size_t i = 0; i < shards.size(); i++) {
+            Shard* shard = shards[i];
+            done.push_back(submit(i, [shard, query, params, need, arena, &parts, i]() {
+                ArenaScope scope(arena);
+                parts[i] = scan_shard(shard->table, query, params, need);
+            }));
+        }
+    } catch (...) {
+        // Gonderilmis task'lar parts'a yaziyor; bitmeden cikilmaz
+        for (auto& part : done) part.wait();
+        throw;
+    }
+    // Hepsi beklenir: bir parca hata verse de digerleri parts'a yaziyor olabilir
+    for (auto& part : done) part.wait();
+    for (auto& part : done) part.get();
+
+    // Gather: satirlar id sirasiyla birlestirilir (tek tablodaki ekleme
+    // sirasi), sorgunun WHERE disindaki kismi birlesik tabloda calisir
+    ShardRows rows;
+    for (auto& part : parts) {
+        for (auto& row : part) rows.push_back(std::move(row));
+    }
+    std::sort(rows.begin(), rows.end(),
+              [](const std::unique_ptr<Row>& a, const std::unique_ptr<Row>& b) { return a->getId() < b->getId(); });
+
+    // Birlesik tablo her sorguda yeni tableId alir; anahtar kolonu kapali
+    // olmasa table_stats_get her sorguda istatistik toplayip onbellege
+    // silinmeyen bir girdi eklerdi. Satirlar zaten suzulmus, tam tarama yeter.
+    Database gathered;
+    Table* merged = new Table(name, getColumns(), getTypes());
+    merged->disableKeyColumn();
+    gathered.addTable(merged);
+    for (auto& row : rows) merged->insertRow(row.release());
+
+    Query rest;
+    copy_without_where(query, rest);
+    return query_execute(&gathered, &rest, params);
+}
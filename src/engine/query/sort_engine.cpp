@@ -0,0 +1,503 @@
+#include "../../../include/engine/query/sort_engine.hpp"
+#include "../../../include/engine/query/query_binder.hpp"
+#include "../../../include/utils/SpillFile.hpp"
+#include "../../../include/utils/ThreadPool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Bu satir sayisinin altinda tek thread'de siralanir
+static const size_t PARALLEL_SORT_MIN_ROWS = 50000;
+static const size_t PARALLEL_SORT_MAX_PARTS = 64;
+
+// LIMIT girdinin bu oranindan kucukse tam siralama yerine top-K heap
+static const size_t TOP_K_RATIO = 8;
+
+// Dis siralama: siralama verisi icin bellek butcesi ve tek gecisteki
+// en fazla run sayisi (her acik run bir dosya tamponu tutar). Butce
+// sorgular calisirken degistirilebilir
+static std::atomic<size_t> sort_memory_budget{64 * 1024 * 1024};
+static const size_t EXTERNAL_MAX_FANIN = 64;
+
+// DESC index taramasinda ilk anahtar penceresinin genisligi
+static const long long DESC_WINDOW_MIN = 64;
+
+struct SortKey {
+    int column;
+    bool ascending;
+};
+
+// Deger sinifi: sayilar < metinler < NULL
+enum SortClass {
+    SORT_NUMBER = 0,
+    SORT_STRING = 1,
+    SORT_NULL = 2
+};
+
+// Ilk anahtar satirdan bir kez okunup burada tutulur; karsilastirmalarin
+// cogu hucreye hic gitmez.
+struct SortItem {
+    Row* row;
+    size_t seq;
+    double number;
+    const std::string* text;
+    int cls;
+};
+
+static Cell* cell_at(Row* row, int column) {
+    return static_cast<size_t>(column) < row->getCellCount() ? row->getCell(column) : nullptr;
+}
+
+static void load_key(SortItem& item, int column) {
+    Cell* cell = cell_at(item.row, column);
+    item.number = 0;
+    item.text = nullptr;
+    if (!cell || cell->isNull()) {
+        item.cls = SORT_NULL;
+    } else if (cell->getType() == CellType::INT) {
+        item.cls = SORT_NUMBER;
+        item.number = cell->getInt();
+    } else if (cell->getType() == CellType::DOUBLE) {
+        item.cls = SORT_NUMBER;
+        item.number = cell->getDouble();
+    } else {
+        item.cls = SORT_STRING;
+        item.text = &cell->getString();
+    }
+}
+
+int sort_compare_cells(const Cell* a, const Cell* b) {
+    int ca = (!a || a->isNull()) ? SORT_NULL : (a->getType() == CellType::STRING ? SORT_STRING : SORT_NUMBER);
+    int cb = (!b || b->isNull()) ? SORT_NULL : (b->getType() == CellType::STRING ? SORT_STRING : SORT_NUMBER);
+    if (ca != cb) return ca < cb ? -1 : 1;
+    if (ca == SORT_NULL) return 0;
+    if (ca == SORT_STRING) {
+        // Ayni sozlukte ayni kod: ayni metin (kodlar sirali degil, farkliysa metin)
+        if (a->isEncoded() && a->getDictionary() == b->getDictionary() && a->getCode() == b->getCode()) return 0;
+        return a->getString().compare(b->getString());
+    }
+    if (a->getType() == CellType::INT && b->getType() == CellType::INT) {
+        return a->getInt() < b->getInt() ? -1 : (a->getInt() > b->getInt() ? 1 : 0);
+    }
+    double da = a->getType() == CellType::INT ? a->getInt() : a->getDouble();
+    double db = b->getType() == CellType::INT ? b->getInt() : b->getDouble();
+    return da < db ? -1 : (da > db ? 1 : 0);
+}
+
+struct RowLess {
+    const std::vector<SortKey>* keys;
+
+    bool operator()(const SortItem& a, const SortItem& b) const {
+        const std::vector<SortKey>& k = *keys;
+        int c;
+        if (a.cls != b.cls) {
+            c = a.cls < b.cls ? -1 : 1;
+        } else if (a.cls == SORT_NUMBER) {
+            c = a.number < b.number ? -1 : (a.number > b.number ? 1 : 0);
+        } else if (a.cls == SORT_STRING) {
+            c = a.text->compare(*b.text);
+        } else {
+            c = 0;
+        }
+        if (c != 0) return k[0].ascending ? c < 0 : c > 0;
+
+        for (size_t i = 1; i < k.size(); i++) {
+            c = sort_compare_cells(cell_at(a.row, k[i].column), cell_at(b.row, k[i].column));
+            if (c != 0) return k[i].ascending ? c < 0 : c > 0;
+        }
+        return a.seq < b.seq;
+    }
+};
+
+// Parcalari havuzda paralel siralar, sonra ikiserli birlestirir
+static void parallel_sort(std::vector<SortItem>& items, const RowLess& less) {
+    ThreadPool& pool = ThreadPool::global();
+    size_t threads = pool.getThreadCount();
+    if (items.size() < PARALLEL_SORT_MIN_ROWS || threads <= 1) {
+        std::sort(items.begin(), items.end(), less);
+        return;
+    }
+
+    size_t parts = 1;
+    while (parts < threads && parts < PARALLEL_SORT_MAX_PARTS) parts <<= 1;
+    std::vector<size_t> bounds(parts + 1);
+    for (size_t i = 0; i <= parts; i++) bounds[i] = i * items.size() / parts;
+
+    pool.parallelFor(parts, [&](size_t p) {
+        std::sort(items.begin() + bounds[p], items.begin() + bounds[p + 1], less);
+    });
+    for (size_t width = 1; width < parts; width <<= 1) {
+        pool.parallelFor(parts / (2 * width), [&](size_t j) {
+            size_t first = bounds[j * 2 * width];
+            size_t middle = bounds[j * 2 * width + width];
+            size_t last = bounds[j * 2 * width + 2 * width];
+            std::inplace_merge(items.begin() + first, items.begin() + middle, items.begin() + last, less);
+        });
+    }
+}
+
+// Sinirli max-heap: her an en kucuk k eleman tutulur
+static void top_k(std::vector<SortItem>& items, size_t k, const RowLess& less) {
+    std::vector<SortItem> heap;
+    heap.reserve(k);
+    for (const SortItem& item : items) {
+        if (heap.size() < k) {
+            heap.push_back(item);
+            std::push_heap(heap.begin(), heap.end(), less);
+        } else if (less(item, heap.front())) {
+            std::pop_heap(heap.begin(), heap.end(), less);
+            heap.back() = item;
+            std::push_heap(heap.begin(), heap.end(), less);
+        }
+    }
+    std::sort_heap(heap.begin(), heap.end(), less);
+    items.swap(heap);
+}
+
+static void copy_row_into(Table* result, Row* row) {
+    Row* new_row = new Row(row->getId());
+    for (auto cell : row->getCells()) new_row->addCopy(cell);
+    result->insertRow(new_row);
+}
+
+void sort_set_memory_budget(size_t bytes) {
+    sort_memory_budget.store(bytes, std::memory_order_relaxed);
+}
+
+size_t sort_get_memory_budget() {
+    return sort_memory_budget.load(std::memory_order_relaxed);
+}
+
+// Satir basina siralama maliyeti: SortItem + STRING anahtar kopyalari
+// (ilk satirlardan ornekleyerek)
+static size_t estimate_item_bytes(Table* table, const std::vector<SortKey>& keys) {
+    size_t per_row = sizeof(SortItem);
+    size_t sampled = 0;
+    size_t key_bytes = 0;
+    for (auto row : table->getRows()) {
+        if (sampled == 64) break;
+        for (const SortKey& key : keys) {
+            Cell* cell = cell_at(row, key.column);
+            key_bytes += sizeof(double) + 1;
+            if (cell && !cell->isNull() && cell->getType() == CellType::STRING) key_bytes += cell->getString().size();
+        }
+        sampled++;
+    }
+    if (sampled > 0) per_row += key_bytes / sampled;
+    return per_row;
+}
+
+// Run dosyasindan okunan kayit. Anahtar degerleri kopyadir; birlestirme
+// satira gitmeden karsilastirir. row bellekteki kaynak satira referanstir.
+struct SortValue {
+    int cls;
+    double number;
+    std::string text;
+};
+
+struct SortRecord {
+    Row* row;
+    uint64_t seq;
+    std::vector<SortValue> values;
+};
+
+static void spill_record(SpillFile& file, Row* row, uint64_t seq, const std::vector<SortKey>& keys) {
+    file.writeUInt64(reinterpret_cast<uintptr_t>(row));
+    file.writeUInt64(seq);
+    for (const SortKey& key : keys) {
+        Cell* cell = cell_at(row, key.column);
+        unsigned char cls = (!cell || cell->isNull()) ? SORT_NULL
+                            : (cell->getType() == CellType::STRING ? SORT_STRING : SORT_NUMBER);
+        file.write(&cls, 1);
+        if (cls == SORT_NUMBER) file.writeDouble(cell->getType() == CellType::INT ? cell->getInt() : cell->getDouble());
+        else if (cls == SORT_STRING) file.writeString(cell->getString());
+    }
+}
+
+static void spill_record(SpillFile& file, const SortRecord& record) {
+    file.writeUInt64(reinterpret_cast<uintptr_t>(record.row));
+    file.writeUInt64(record.seq);
+    for (const SortValue& value : record.values) {
+        unsigned char cls = static_cast<unsigned char>(value.cls);
+        file.write(&cls, 1);
+        if (cls == SORT_NUMBER) file.writeDouble(value.number);
+        else if (cls == SORT_STRING) file.writeString(value.text);
+    }
+}
+
+// record.values onceden anahtar sayisi kadar boyutlanmis olmali; string
+// tamponlari kayitlar arasinda yeniden kullanilir
+static bool load_record(SpillFile& file, SortRecord& record) {
+    uint64_t row_ref;
+    if (!file.readUInt64(row_ref) || !file.readUInt64(record.seq)) return false;
+    record.row = reinterpret_cast<Row*>(static_cast<uintptr_t>(row_ref));
+    for (SortValue& value : record.values) {
+        unsigned char cls;
+        if (!file.read(&cls, 1)) return false;
+        value.cls = cls;
+        if (cls == SORT_NUMBER && !file.readDouble(value.number)) return false;
+        if (cls == SORT_STRING && !file.readString(value.text)) return false;
+    }
+    return true;
+}
+
+static bool record_less(const SortRecord& a, const SortRecord& b, const std::vector<SortKey>& keys) {
+    for (size_t i = 0; i < keys.size(); i++) {
+        const SortValue& x = a.values[i];
+        const SortValue& y = b.values[i];
+        int c;
+        if (x.cls != y.cls) c = x.cls < y.cls ? -1 : 1;
+        else if (x.cls == SORT_NUMBER) c = x.number < y.number ? -1 : (x.number > y.number ? 1 : 0);
+        else if (x.cls == SORT_STRING) c = x.text.compare(y.text);
+        else c = 0;
+        if (c != 0) return keys[i].ascending ? c < 0 : c > 0;
+    }
+    return a.seq < b.seq;
+}
+
+// k run'in o anki kayitlari uzerinde loser tree. tree[0] kazanan (en kucuk)
+// run'i, tree[1..k-1] ic dugumlerde kaybedenleri tutar; kazanan ilerleyince
+// sadece yapraktan koke olan yol (log k karsilastirma) yeniden oynanir.
+class LoserTree {
+private:
+    std::vector<int> tree;
+    std::vector<SortRecord>& heads;
+    std::vector<bool>& live;
+    const std::vector<SortKey>& keys;
+
+    // -1: kurulum sirasindaki sanal en kucuk; biten run en buyuk sayilir
+    bool beats(int a, int b) const {
+        if (a < 0) return true;
+        if (b < 0) return false;
+        if (!live[a]) return false;
+        if (!live[b]) return true;
+        return record_less(heads[a], heads[b], keys);
+    }
+
+    void replay(int run) {
+        int winner = run;
+        for (size_t node = (static_cast<size_t>(run) + tree.size()) / 2; node > 0; node /= 2) {
+            if (beats(tree[node], winner)) std::swap(tree[node], winner);
+        }
+        tree[0] = winner;
+    }
+
+public:
+    LoserTree(std::vector<SortRecord>& run_heads, std::vector<bool>& run_live, const std::vector<SortKey>& sort_keys)
+        : tree(run_heads.size(), -1), heads(run_heads), live(run_live), keys(sort_keys) {
+        for (size_t run = run_heads.size(); run-- > 0;) replay(static_cast<int>(run));
+    }
+
+    int winner() const { return tree[0]; }
+    bool empty() const { return tree.empty() || !live[tree[0]]; }
+
+    // Kazanan run'a yeni kayit okundu (ya da run bitti)
+    void advance() { replay(tree[0]); }
+};
+
+// Run'lari k-yollu birlestirir; emit false donerse erken durur
+template <typename Emit>
+static void merge_runs(std::vector<std::unique_ptr<SpillFile>>& runs, size_t key_count,
+                       const std::vector<SortKey>& keys, Emit emit) {
+    std::vector<SortRecord> heads(runs.size());
+    std::vector<bool> live(runs.size());
+    for (size_t r = 0; r < runs.size(); r++) {
+        runs[r]->rewind();
+        heads[r].values.resize(key_count);
+        live[r] = load_record(*runs[r], heads[r]);
+    }
+
+    LoserTree tree(heads, live, keys);
+    while (!tree.empty()) {
+        int run = tree.winner();
+        if (!emit(heads[run])) return;
+        live[run] = load_record(*runs[run], heads[run]);
+        tree.advance();
+    }
+}
+
+// Girdiyi butceye sigan parcalar halinde siralayip run dosyalarina yazar,
+// sonra run'lari loser tree ile birlestirir. Bellekte ayni anda tek parca
+// (ya da birlestirme sirasinda run basina tek kayit) bulunur.
+static Table* external_sort(Table* table, const std::vector<SortKey>& keys, long long limit,
+                            size_t item_bytes, size_t budget) {
+    size_t run_rows = std::max<size_t>(1024, budget / item_bytes);
+    RowLess less{&keys};
+
+    std::vector<std::unique_ptr<SpillFile>> runs;
+    std::vector<SortItem> items;
+    items.reserve(std::min(run_rows, table->getRowCount()));
+    size_t seq = 0;
+
+    auto flush = [&]() -> bool {
+        if (items.empty()) return true;
+        parallel_sort(items, less);
+        runs.emplace_back(new SpillFile());
+        if (!runs.back()->open()) return false;
+        for (const SortItem& item : items) spill_record(*runs.back(), item.row, item.seq, keys);
+        items.clear();
+        // Eksik yazilmis run birlestirmede satir kaybettirir
+        runs.back()->rewind();
+        return !runs.back()->failed();
+    };
+
+    for (auto row : table->getRows()) {
+        SortItem item;
+        item.row = row;
+        item.seq = seq++;
+        load_key(item, keys[0].column);
+        items.push_back(item);
+        if (items.size() == run_rows && !flush()) return nullptr;
+    }
+    if (!flush()) return nullptr;
+
+    // Cok fazla run varsa gruplar halinde ara run'lara birlestir
+    while (runs.size() > EXTERNAL_MAX_FANIN) {
+        std::vector<std::unique_ptr<SpillFile>> merged;
+        for (size_t first = 0; first < runs.size(); first += EXTERNAL_MAX_FANIN) {
+            size_t last = std::min(runs.size(), first + EXTERNAL_MAX_FANIN);
+            std::vector<std::unique_ptr<SpillFile>> group;
+            for (size_t r = first; r < last; r++) group.push_back(std::move(runs[r]));
+            merged.emplace_back(new SpillFile());
+            if (!merged.back()->open()) return nullptr;
+            SpillFile& out = *merged.back();
+            merge_runs(group, keys.size(), keys, [&](const SortRecord& record) {
+                spill_record(out, record);
+                return true;
+            });
+            out.rewind();
+            if (out.failed()) return nullptr;
+        }
+        runs.swap(merged);
+    }
+
+    Table* result = new Table(table->getName() + "_sorted", table->getColumns(), table->getTypes());
+    long long taken = 0;
+    merge_runs(runs, keys.size(), keys, [&](const SortRecord& record) {
+        if (limit >= 0 && taken >= limit) return false;
+        copy_row_into(result, record.row);
+        taken++;
+        return true;
+    });
+    return result;
+}
+
+Table* sort_table(Table* table, const LinkedList<OrderByColumn>& order_by, long long limit) {
+    if (!table || order_by.empty()) return table;
+
+    std::vector<SortKey> keys;
+    for (const auto& item : order_by) {
+        int column = query_bind_column(table, item.column_name);
+        if (column < 0) {
+            std::cerr << "Hata: ORDER BY kolonu bulunamadi: " << item.column_name << std::endl;
+            continue;
+        }
+        keys.push_back({column, item.ascending});
+    }
+    if (keys.empty()) return table;
+
+    // Top-K heap sadece k satir tutar; tam siralama butceyi asacaksa dis siralama
+    bool use_top_k = limit >= 0 && static_cast<size_t>(limit) * TOP_K_RATIO < table->getRowCount();
+    if (!use_top_k) {
+        size_t item_bytes = estimate_item_bytes(table, keys);
+        size_t budget = sort_memory_budget.load(std::memory_order_relaxed);
+        if (table->getRowCount() * item_bytes > budget) {
+            Table* result = external_sort(table, keys, limit, item_bytes, budget);
+            if (result) return result;
+            std::cerr << "Hata: Siralama run dosyalari yazilamadi, bellekte siralaniyor" << std::endl;
+        }
+    }
+
+    std::vector<SortItem> items;
+    items.reserve(table->getRowCount());
+    size_t seq = 0;
+    for (auto row : table->getRows()) {
+        SortItem item;
+        item.row = row;
+        item.seq = seq++;
+        load_key(item, keys[0].column);
+        items.push_back(item);
+    }
+
+    RowLess less{&keys};
+    if (use_top_k) {
+        top_k(items, static_cast<size_t>(limit), less);
+    } else {
+        parallel_sort(items, less);
+        if (limit >= 0 && static_cast<size_t>(limit) < items.size()) items.resize(static_cast<size_t>(limit));
+    }
+
+    Table* result = new Table(table->getName() + "_sorted", table->getColumns(), table->getTypes());
+    for (const SortItem& item : items) copy_row_into(result, item.row);
+    return result;
+}
+
+bool sort_can_use_index(Table* table, const LinkedList<OrderByColumn>& order_by) {
+    if (!table || order_by.size() != 1) return false;
+    int key_column = table->getKeyColumnIndex();
+    return key_column >= 0 && query_bind_column(table, (*order_by.begin()).column_name) == key_column;
+}
+
+Table* sort_index_scan(Table* table, int lo, int hi, bool ascending,
+                       const CompiledPredicate* predicate, long long limit, long long offset) {
+    Table* result = new Table(table->getName() + "_sorted", table->getColumns(), table->getTypes());
+    idx::ConcurrentBPlusTree* tree = table->getBTree();
+    if (limit == 0 || lo > hi || tree->isEmpty()) return result;
+
+    long long skipped = 0;
+    long long taken = 0;
+    // false donerse tarama biter
+    auto emit = [&](Row* row) -> bool {
+        if (!row) return true;
+        if (predicate && !predicate->matches(row)) return true;
+        if (skipped < offset) {
+            skipped++;
+            return true;
+        }
+        copy_row_into(result, row);
+        return limit < 0 || ++taken < limit;
+    };
+
+    idx::ConcurrentBPlusTree::Cursor cursor(tree);
+    cursor.seek(lo);
+    if (ascending) {
+        while (cursor.valid()) {
+            // OFFSET: tamami aralikta ve atlanacak olan yaprak satirlara bakmadan gecilir
+            if (!predicate && offset - skipped >= cursor.leafRemaining() && cursor.leafLastKey() <= hi) {
+                skipped += cursor.leafRemaining();
+                cursor.nextLeaf();
+                continue;
+            }
+            if (cursor.key() > hi) return result;
+            if (!emit(cursor.row())) return result;
+            cursor.next();
+        }
+        return result;
+    }
+
+    // DESC: [hi - w + 1, hi] penceresini al, tersten yuru, yetmezse bir
+    // alttaki iki kat genis pencereye gec
+    if (!cursor.valid() || cursor.key() > hi) return result;
+    long long floor_key = cursor.key();
+    int last_key;
+    if (tree->floorKey(hi, last_key)) hi = last_key;
+    long long window = limit > 0 ? std::max(DESC_WINDOW_MIN, (limit + offset) * 2)
+                                 : static_cast<long long>(hi) - floor_key + 1;
+    long long top = hi;
+    while (top >= floor_key) {
+        long long bottom = std::max(floor_key, top - window + 1);
+        std::vector<Row*> rows;
+        tree->rangeBetween(static_cast<int>(bottom), static_cast<int>(top), rows);
+        for (auto it = rows.rbegin(); it != rows.rend(); ++it) {
+            if (!emit(*it)) return result;
+        }
+        top = bottom - 1;
+        window *= 2;
+    }
+    return result;
+}
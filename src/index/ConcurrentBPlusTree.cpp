@@ -0,0 +1,542 @@
+/**
+ * @file ConcurrentBPlusTree.cpp
+ * @brief Concurrent B+ tree with optimistic lock coupling
+ * @date 2025
+ */
+
+#include "../../include/index/ConcurrentBPlusTree.hpp"
+#include "../../include/utils/Epoch.hpp"
+#include <algorithm>
+#include <climits>
+#include <iostream>
+#include <thread>
+
+namespace idx {
+
+    // ==================== Version latch ====================
+
+    static const uint64_t LOCKED_BIT = 2;
+    static const uint64_t OBSOLETE_BIT = 1;
+
+    /**
+     * @brief Reads the version for an optimistic read; fails if locked or obsolete
+     */
+    static uint64_t readLockOrRestart(const OlcNode* node, bool& restart) {
+        uint64_t version = node->version.load(std::memory_order_acquire);
+        if (version & (LOCKED_BIT | OBSOLETE_BIT)) restart = true;
+        return version;
+    }
+
+    /**
+     * @brief Validates that the node did not change since version was read
+     */
+    static void checkOrRestart(const OlcNode* node, uint64_t version, bool& restart) {
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (node->version.load(std::memory_order_relaxed) != version) restart = true;
+    }
+
+    /**
+     * @brief Turns an optimistic read into a write latch if nothing changed
+     */
+    static void upgradeToWriteLockOrRestart(OlcNode* node, uint64_t version, bool& restart) {
+        if (!node->version.compare_exchange_strong(version, version + LOCKED_BIT, std::memory_order_acquire)) {
+            restart = true;
+            return;
+        }
+        // Readers that see any write below also see the locked version
+        std::atomic_thread_fence(std::memory_order_release);
+    }
+
+    static void writeUnlock(OlcNode* node) {
+        node->version.fetch_add(LOCKED_BIT, std::memory_order_release);
+    }
+
+    static void writeUnlockObsolete(OlcNode* node) {
+        node->version.fetch_add(LOCKED_BIT | OBSOLETE_BIT, std::memory_order_release);
+    }
+
+    /**
+     * @brief Backs off before retrying; the latch holder may be descheduled
+     */
+    static void backoff() {
+        std::this_thread::yield();
+    }
+
+    // ==================== Node helpers ====================
+
+    static int nodeCount(const OlcNode* node, int capacity) {
+        // Inconsistent reads are validated later but must stay in bounds
+        return std::min(std::max(node->count.load(std::memory_order_relaxed), 0), capacity);
+    }
+
+    /**
+     * @brief First position whose key is >= key
+     */
+    template <typename Node>
+    static int lowerBound(const Node* node, int count, int key) {
+        int lo = 0, hi = count;
+        while (lo < hi) {
+            int mid = (lo + hi) / 2;
+            if (node->keys[mid].load(std::memory_order_relaxed) < key) lo = mid + 1;
+            else hi = mid;
+        }
+        return lo;
+    }
+
+    static void copyLeafEntry(OlcLeaf* to, int toPos, OlcLeaf* from, int fromPos) {
+        to->keys[toPos].store(from->keys[fromPos].load(std::memory_order_relaxed), std::memory_order_relaxed);
+        to->values[toPos].store(from->values[fromPos].load(std::memory_order_acquire), std::memory_order_release);
+    }
+
+    /**
+     * @brief Moves the upper half of a latched leaf to a new leaf
+     * @param sep Receives the largest key left in leaf
+     */
+    static OlcLeaf* splitLeaf(OlcLeaf* leaf, int& sep) {
+        OlcLeaf* right = new OlcLeaf();
+        int count = leaf->count.load(std::memory_order_relaxed);
+        int mid = count / 2;
+        for (int i = mid; i < count; i++) copyLeafEntry(right, i - mid, leaf, i);
+        right->count.store(count - mid, std::memory_order_relaxed);
+        leaf->count.store(mid, std::memory_order_relaxed);
+        sep = leaf->keys[mid - 1].load(std::memory_order_relaxed);
+        return right;
+    }
+
+    /**
+     * @brief Moves the upper half of a latched inner node to a new node
+     * @param sep Receives the middle key, which moves up to the parent
+     */
+    static OlcInner* splitInner(OlcInner* inner, int& sep) {
+        OlcInner* right = new OlcInner();
+        int count = inner->count.load(std::memory_order_relaxed);
+        int mid = count / 2;
+        sep = inner->keys[mid].load(std::memory_order_relaxed);
+        for (int i = mid + 1; i < count; i++) {
+            right->keys[i - mid - 1].store(inner->keys[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+        for (int i = mid + 1; i <= count; i++) {
+            right->children[i - mid - 1].store(inner->children[i].load(std::memory_order_acquire),
+                                               std::memory_order_relaxed);
+        }
+        right->count.store(count - mid - 1, std::memory_order_relaxed);
+        inner->count.store(mid, std::memory_order_relaxed);
+        return right;
+    }
+
+    /**
+     * @brief Adds sep and its right child to a latched inner node with room
+     */
+    static void insertSeparator(OlcInner* inner, int sep, OlcNode* right) {
+        int count = inner->count.load(std::memory_order_relaxed);
+        int pos = lowerBound(inner, count, sep);
+        for (int i = count; i > pos; i--) {
+            inner->keys[i].store(inner->keys[i - 1].load(std::memory_order_relaxed), std::memory_order_relaxed);
+            inner->children[i + 1].store(inner->children[i].load(std::memory_order_acquire), std::memory_order_release);
+        }
+        inner->keys[pos].store(sep, std::memory_order_relaxed);
+        inner->children[pos + 1].store(right, std::memory_order_release);
+        inner->count.store(count + 1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Drops child pos from a latched inner node
+     *
+     * The neighbouring child takes over its key range: the right
+     * neighbour's lower bound (or the left neighbour's upper bound for the
+     * last child) is removed along with it.
+     */
+    static void removeChild(OlcInner* inner, int pos) {
+        int count = inner->count.load(std::memory_order_relaxed);
+        int keyPos = pos < count ? pos : count - 1;
+        for (int i = keyPos; i < count - 1; i++) {
+            inner->keys[i].store(inner->keys[i + 1].load(std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+        for (int i = pos; i < count; i++) {
+            inner->children[i].store(inner->children[i + 1].load(std::memory_order_acquire), std::memory_order_release);
+        }
+        inner->count.store(count - 1, std::memory_order_relaxed);
+    }
+
+    static void deleteLeaf(void* leaf) {
+        delete static_cast<OlcLeaf*>(leaf);
+    }
+
+    // ==================== Public Methods ====================
+
+    ConcurrentBPlusTree::ConcurrentBPlusTree() : root(new OlcLeaf()), size_(0) {}
+
+    ConcurrentBPlusTree::~ConcurrentBPlusTree() {
+        freeTree(root.load(std::memory_order_relaxed));
+    }
+
+    void ConcurrentBPlusTree::freeTree(OlcNode* node) {
+        if (!node->is_leaf) {
+            OlcInner* inner = static_cast<OlcInner*>(node);
+            int count = inner->count.load(std::memory_order_relaxed);
+            for (int i = 0; i <= count; i++) freeTree(inner->children[i].load(std::memory_order_acquire));
+            delete inner;
+        } else {
+            delete static_cast<OlcLeaf*>(node);
+        }
+    }
+
+    OlcLeaf* ConcurrentBPlusTree::findLeaf(int key, uint64_t& version, LeafBounds& bounds, bool& restart) const {
+        bounds.hasLow = bounds.hasHigh = false;
+        OlcNode* node = root.load(std::memory_order_acquire);
+        version = readLockOrRestart(node, restart);
+        if (restart || node != root.load(std::memory_order_acquire)) {
+            restart = true;
+            return nullptr;
+        }
+
+        while (!node->is_leaf) {
+            OlcInner* inner = static_cast<OlcInner*>(node);
+            int count = nodeCount(inner, OLC_INNER_CAPACITY);
+            int pos = lowerBound(inner, count, key);
+            OlcNode* child = inner->children[pos].load(std::memory_order_acquire);
+            if (pos > 0) {
+                bounds.hasLow = true;
+                bounds.low = inner->keys[pos - 1].load(std::memory_order_relaxed);
+            }
+            if (pos < count) {
+                bounds.hasHigh = true;
+                bounds.high = inner->keys[pos].load(std::memory_order_relaxed);
+            }
+            checkOrRestart(inner, version, restart);
+            if (restart) return nullptr;
+            uint64_t childVersion = readLockOrRestart(child, restart);
+            if (restart) return nullptr;
+            // Cocuk, pointer ile surumu okunurken bolunmus olabilir
+            checkOrRestart(inner, version, restart);
+            if (restart) return nullptr;
+            node = child;
+            version = childVersion;
+        }
+        return static_cast<OlcLeaf*>(node);
+    }
+
+    Row* ConcurrentBPlusTree::lookup(int key) const {
+        EpochGuard guard;
+        for (;;) {
+            bool restart = false;
+            uint64_t version;
+            LeafBounds bounds;
+            OlcLeaf* leaf = findLeaf(key, version, bounds, restart);
+            if (restart) {
+                backoff();
+                continue;
+            }
+
+            int count = nodeCount(leaf, OLC_LEAF_CAPACITY);
+            int pos = lowerBound(leaf, count, key);
+            Row* row = nullptr;
+            if (pos < count && leaf->keys[pos].load(std::memory_order_relaxed) == key) {
+                row = leaf->values[pos].load(std::memory_order_acquire);
+            }
+            checkOrRestart(leaf, version, restart);
+            if (restart) {
+                backoff();
+                continue;
+            }
+            return row;
+        }
+    }
+
+    bool ConcurrentBPlusTree::floorKey(int key, int& out) const {
+        EpochGuard guard;
+        for (;;) {
+            bool restart = false;
+            uint64_t version;
+            LeafBounds bounds;
+            OlcLeaf* leaf = findLeaf(key, version, bounds, restart);
+            if (restart) {
+                backoff();
+                continue;
+            }
+
+            int count = nodeCount(leaf, OLC_LEAF_CAPACITY);
+            int pos = lowerBound(leaf, count, key);
+            if (pos < count && leaf->keys[pos].load(std::memory_order_relaxed) == key) pos++;
+            int found = pos > 0 ? leaf->keys[pos - 1].load(std::memory_order_relaxed) : 0;
+            checkOrRestart(leaf, version, restart);
+            if (restart) {
+                backoff();
+                continue;
+            }
+            if (pos > 0) {
+                out = found;
+                return true;
+            }
+            // Bu yaprakta yok: soldaki yapragin araligina gecilir
+            if (!bounds.hasLow) return false;
+            key = bounds.low;
+        }
+    }
+
+    bool ConcurrentBPlusTree::insert(int key, Row* row) {
+        EpochGuard guard;
+        for (;;) {
+            bool restart = false;
+            OlcNode* node = root.load(std::memory_order_acquire);
+            uint64_t version = readLockOrRestart(node, restart);
+            if (restart || node != root.load(std::memory_order_acquire)) {
+                backoff();
+                continue;
+            }
+
+            OlcInner* parent = nullptr;
+            uint64_t parentVersion = 0;
+            bool split = false;
+
+            for (;;) {
+                int capacity = node->is_leaf ? OLC_LEAF_CAPACITY : OLC_INNER_CAPACITY;
+                if (node->count.load(std::memory_order_relaxed) >= capacity) {
+                    // Dolu dugum inilirken bolunur; ebeveynin yeri vardir
+                    if (parent) {
+                        upgradeToWriteLockOrRestart(parent, parentVersion, restart);
+                        if (restart) break;
+                    }
+                    upgradeToWriteLockOrRestart(node, version, restart);
+                    if (restart) {
+                        if (parent) writeUnlock(parent);
+                        break;
+                    }
+                    if (!parent && node != root.load(std::memory_order_acquire)) {
+                        writeUnlock(node);
+                        restart = true;
+                        break;
+                    }
+
+                    int sep;
+                    OlcNode* right = node->is_leaf
+                                         ? static_cast<OlcNode*>(splitLeaf(static_cast<OlcLeaf*>(node), sep))
+                                         : static_cast<OlcNode*>(splitInner(static_cast<OlcInner*>(node), sep));
+                    if (parent) {
+                        insertSeparator(parent, sep, right);
+                    } else {
+                        OlcInner* newRoot = new OlcInner();
+                        newRoot->keys[0].store(sep, std::memory_order_relaxed);
+                        newRoot->children[0].store(node, std::memory_order_release);
+                        newRoot->children[1].store(right, std::memory_order_release);
+                        newRoot->count.store(1, std::memory_order_relaxed);
+                        root.store(newRoot, std::memory_order_release);
+                    }
+                    writeUnlock(node);
+                    if (parent) writeUnlock(parent);
+                    split = true;
+                    break;
+                }
+
+                if (node->is_leaf) break;
+
+                OlcInner* inner = static_cast<OlcInner*>(node);
+                int count = nodeCount(inner, OLC_INNER_CAPACITY);
+                OlcNode* child = inner->children[lowerBound(inner, count, key)].load(std::memory_order_acquire);
+                checkOrRestart(inner, version, restart);
+                if (restart) break;
+                uint64_t childVersion = readLockOrRestart(child, restart);
+                if (restart) break;
+                checkOrRestart(inner, version, restart);
+                if (restart) break;
+
+                parent = inner;
+                parentVersion = version;
+                node = child;
+                version = childVersion;
+            }
+            if (restart) backoff();
+            if (restart || split) continue;
+
+            // Yaprak degismediyse anahtar hala bu yaprakta
+            OlcLeaf* leaf = static_cast<OlcLeaf*>(node);
+            upgradeToWriteLockOrRestart(leaf, version, restart);
+            if (restart) {
+                backoff();
+                continue;
+            }
+
+            int count = leaf->count.load(std::memory_order_relaxed);
+            int pos = lowerBound(leaf, count, key);
+            bool added = !(pos < count && leaf->keys[pos].load(std::memory_order_relaxed) == key);
+            if (added) {
+                for (int i = count; i > pos; i--) copyLeafEntry(leaf, i, leaf, i - 1);
+                leaf->keys[pos].store(key, std::memory_order_relaxed);
+                leaf->count.store(count + 1, std::memory_order_relaxed);
+                size_.fetch_add(1, std::memory_order_relaxed);
+            }
+            leaf->values[pos].store(row, std::memory_order_release);
+            writeUnlock(leaf);
+            return added;
+        }
+    }
+
+    bool ConcurrentBPlusTree::remove(int key) {
+        EpochGuard guard;
+        for (;;) {
+            bool restart = false;
+            OlcNode* node = root.load(std::memory_order_acquire);
+            uint64_t version = readLockOrRestart(node, restart);
+            if (restart || node != root.load(std::memory_order_acquire)) {
+                backoff();
+                continue;
+            }
+
+            OlcInner* parent = nullptr;
+            uint64_t parentVersion = 0;
+            int parentPos = 0;
+            while (!node->is_leaf) {
+                OlcInner* inner = static_cast<OlcInner*>(node);
+                int count = nodeCount(inner, OLC_INNER_CAPACITY);
+                int pos = lowerBound(inner, count, key);
+                OlcNode* child = inner->children[pos].load(std::memory_order_acquire);
+                checkOrRestart(inner, version, restart);
+                if (restart) break;
+                uint64_t childVersion = readLockOrRestart(child, restart);
+                if (restart) break;
+                checkOrRestart(inner, version, restart);
+                if (restart) break;
+
+                parent = inner;
+                parentVersion = version;
+                parentPos = pos;
+                node = child;
+                version = childVersion;
+            }
+            if (restart) {
+                backoff();
+                continue;
+            }
+
+            OlcLeaf* leaf = static_cast<OlcLeaf*>(node);
+            int count = nodeCount(leaf, OLC_LEAF_CAPACITY);
+            int pos = lowerBound(leaf, count, key);
+            bool found = pos < count && leaf->keys[pos].load(std::memory_order_relaxed) == key;
+            // Son anahtari giden yaprak, ebeveynin tek cocugu degilse agactan cikarilir
+            bool unlink = found && count == 1 && parent && parent->count.load(std::memory_order_relaxed) > 0;
+            checkOrRestart(leaf, version, restart);
+            if (restart) {
+                backoff();
+                continue;
+            }
+            if (!found) return false;
+
+            if (unlink) {
+                upgradeToWriteLockOrRestart(parent, parentVersion, restart);
+                if (restart) {
+                    backoff();
+                    continue;
+                }
+                upgradeToWriteLockOrRestart(leaf, version, restart);
+                if (restart) {
+                    writeUnlock(parent);
+                    backoff();
+                    continue;
+                }
+                removeChild(parent, parentPos);
+                leaf->count.store(0, std::memory_order_relaxed);
+                writeUnlock(parent);
+                writeUnlockObsolete(leaf);
+                size_.fetch_sub(1, std::memory_order_relaxed);
+                Epoch::retire(leaf, deleteLeaf);
+                return true;
+            }
+
+            upgradeToWriteLockOrRestart(leaf, version, restart);
+            if (restart) {
+                backoff();
+                continue;
+            }
+            for (int i = pos; i < count - 1; i++) copyLeafEntry(leaf, i, leaf, i + 1);
+            leaf->count.store(count - 1, std::memory_order_relaxed);
+            writeUnlock(leaf);
+            size_.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    void ConcurrentBPlusTree::rangeBetween(int minKey, int maxKey, std::vector<Row*>& out) const {
+        if (minKey > maxKey) return;
+        Cursor cursor(this);
+        for (cursor.seek(minKey); cursor.valid() && cursor.key() <= maxKey; cursor.next()) {
+            out.push_back(cursor.row());
+        }
+    }
+
+    // ==================== Cursor ====================
+
+    void ConcurrentBPlusTree::Cursor::loadLeaf(int key) {
+        EpochGuard guard;
+        for (;;) {
+            bool restart = false;
+            uint64_t version;
+            LeafBounds bounds;
+            OlcLeaf* leaf = tree->findLeaf(key, version, bounds, restart);
+            if (restart) {
+                backoff();
+                continue;
+            }
+
+            int leafCount = nodeCount(leaf, OLC_LEAF_CAPACITY);
+            count = 0;
+            for (int i = lowerBound(leaf, leafCount, key); i < leafCount; i++) {
+                keys[count] = leaf->keys[i].load(std::memory_order_relaxed);
+                rows[count] = leaf->values[i].load(std::memory_order_acquire);
+                count++;
+            }
+            checkOrRestart(leaf, version, restart);
+            if (restart) {
+                backoff();
+                continue;
+            }
+
+            pos = 0;
+            hasNext = bounds.hasHigh && bounds.high < INT_MAX;
+            nextKey = hasNext ? bounds.high + 1 : 0;
+            return;
+        }
+    }
+
+    void ConcurrentBPlusTree::Cursor::seek(int key) {
+        loadLeaf(key);
+        // Bos yapraklar (ebeveynin tek cocugu olanlar) atlanir
+        while (count == 0 && hasNext) loadLeaf(nextKey);
+    }
+
+    void ConcurrentBPlusTree::Cursor::next() {
+        if (++pos >= count && hasNext) seek(nextKey);
+    }
+
+    void ConcurrentBPlusTree::Cursor::nextLeaf() {
+        pos = count;
+        if (hasNext) seek(nextKey);
+    }
+
+    // ==================== Debug ====================
+
+    void ConcurrentBPlusTree::printTree(OlcNode* node, int level) const {
+        for (int i = 0; i < level; i++) std::cout << "  ";
+        std::cout << (node->is_leaf ? "[L] " : "[I] ") << "(";
+        int count = node->count.load(std::memory_order_relaxed);
+        for (int i = 0; i < count; i++) {
+            std::cout << (node->is_leaf ? static_cast<OlcLeaf*>(node)->keys[i].load()
+                                        : static_cast<OlcInner*>(node)->keys[i].load());
+            if (i < count - 1) std::cout << ", ";
+        }
+        std::cout << ")" << std::endl;
+        if (!node->is_leaf) {
+            OlcInner* inner = static_cast<OlcInner*>(node);
+            for (int i = 0; i <= count; i++) printTree(inner->children[i].load(), level + 1);
+        }
+    }
+
+    void ConcurrentBPlusTree::print() const {
+        std::cout << "========================================" << std::endl;
+        std::cout << "B+ Tree (OLC, leaf=" << OLC_LEAF_CAPACITY << ", inner=" << OLC_INNER_CAPACITY
+                  << ", size=" << size() << ")" << std::endl;
+        std::cout << "========================================" << std::endl;
+        printTree(root.load(), 0);
+        std::cout << "========================================" << std::endl;
+    }
+
+}
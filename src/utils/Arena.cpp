@@ -0,0 +1,60 @@
+#include "../../include/utils/Arena.hpp"
+#include <new>
+
+// Thread'in bump imleci: en son ayirdigi arena ve o arena'daki blogun kalani
+struct ArenaCursor {
+    uint64_t arena;
+    char* next;
+    char* end;
+};
+
+static std::atomic<uint64_t> nextArenaId(1);
+static thread_local ArenaCursor cursor = {0, nullptr, nullptr};
+static thread_local Arena* currentArena = nullptr;
+
+// Bu boyuttan buyuk istekler kendi bloklarini alir (blok sonu bosa gitmesin)
+static const size_t LARGE_ALLOCATION = 16 * 1024;
+
+Arena::Arena() : id(nextArenaId.fetch_add(1, std::memory_order_relaxed)), reserved(0) {}
+
+Arena::~Arena() {
+    for (char* block : blocks) ::operator delete(block);
+}
+
+char* Arena::newBlock(size_t size) {
+    char* block = static_cast<char*>(::operator new(size));
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        blocks.push_back(block);
+    }
+    reserved.fetch_add(size, std::memory_order_relaxed);
+    return block;
+}
+
+void* Arena::allocate(size_t size) {
+    size = (size + 15) & ~static_cast<size_t>(15);
+    if (size > LARGE_ALLOCATION) return newBlock(size);
+
+    ArenaCursor& local = cursor;
+    // Yikilan bir arena'nin id'si tekrar verilmez; eski imlec kullanilmaz
+    if (local.arena != id || static_cast<size_t>(local.end - local.next) < size) {
+        local.next = newBlock(BLOCK_SIZE);
+        local.end = local.next + BLOCK_SIZE;
+        local.arena = id;
+    }
+    void* ptr = local.next;
+    local.next += size;
+    return ptr;
+}
+
+Arena* Arena::current() {
+    return currentArena;
+}
+
+ArenaScope::ArenaScope(Arena* arena) : previous(currentArena) {
+    currentArena = arena;
+}
+
+ArenaScope::~ArenaScope() {
+    currentArena = previous;
+}
@@ -0,0 +1,114 @@
+#include "../../include/utils/Epoch.hpp"
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+// Her thread'in okuma bolgesindeki epoch'u; 0: bolge disinda. Slotlar
+// silinmez, thread bitince bir sonrakine verilir.
+struct alignas(64) EpochSlot {
+    std::atomic<uint64_t> epoch;
+    std::atomic<bool> used;
+    EpochSlot* next;
+
+    EpochSlot() : epoch(0), used(true), next(nullptr) {}
+};
+
+struct RetiredObject {
+    uint64_t epoch;
+    void* ptr;
+    Epoch::Deleter deleter;
+};
+
+// Bu kadar nesne birikince retire toplamayi dener
+static const size_t COLLECT_THRESHOLD = 64;
+
+static std::atomic<uint64_t> globalEpoch(1);
+static std::atomic<EpochSlot*> slotHead(nullptr);
+
+static std::mutex retiredMutex;
+static std::vector<RetiredObject> retiredObjects;
+static std::atomic<size_t> pendingObjects(0);
+
+static EpochSlot* acquire_slot() {
+    for (EpochSlot* slot = slotHead.load(std::memory_order_acquire); slot; slot = slot->next) {
+        bool expected = false;
+        if (!slot->used.load(std::memory_order_relaxed) &&
+            slot->used.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+            return slot;
+        }
+    }
+    EpochSlot* slot = new EpochSlot();
+    slot->next = slotHead.load(std::memory_order_relaxed);
+    while (!slotHead.compare_exchange_weak(slot->next, slot, std::memory_order_release, std::memory_order_relaxed)) {
+    }
+    return slot;
+}
+
+struct ThreadEpoch {
+    EpochSlot* slot;
+    int depth;
+
+    ThreadEpoch() : slot(nullptr), depth(0) {}
+    ~ThreadEpoch() {
+        if (!slot) return;
+        slot->epoch.store(0, std::memory_order_release);
+        slot->used.store(false, std::memory_order_release);
+    }
+};
+
+static thread_local ThreadEpoch threadEpoch;
+
+void Epoch::enter() {
+    ThreadEpoch& current = threadEpoch;
+    if (current.depth++ > 0) return;
+    if (!current.slot) current.slot = acquire_slot();
+    // seq_cst: ya toplayici bu slotu gorur ya da bu thread'in sonraki
+    // okumalari toplayicidan once yapilan cikarmalari gorur
+    current.slot->epoch.store(globalEpoch.load(std::memory_order_seq_cst), std::memory_order_seq_cst);
+}
+
+void Epoch::exit() {
+    ThreadEpoch& current = threadEpoch;
+    if (--current.depth > 0) return;
+    current.slot->epoch.store(0, std::memory_order_release);
+}
+
+void Epoch::retire(void* ptr, Deleter deleter) {
+    // Nesne bu noktada yapidan cikarilmis olmali
+    uint64_t epoch = globalEpoch.fetch_add(1, std::memory_order_seq_cst);
+    bool full;
+    {
+        std::lock_guard<std::mutex> lock(retiredMutex);
+        retiredObjects.push_back(RetiredObject{epoch, ptr, deleter});
+        full = retiredObjects.size() >= COLLECT_THRESHOLD;
+    }
+    pendingObjects.fetch_add(1, std::memory_order_relaxed);
+    if (full) collect();
+}
+
+size_t Epoch::collect() {
+    // Taramadan sonra retire edilenler bu sinirin ustunde kalir
+    uint64_t oldest = globalEpoch.load(std::memory_order_seq_cst);
+    for (EpochSlot* slot = slotHead.load(std::memory_order_acquire); slot; slot = slot->next) {
+        uint64_t epoch = slot->epoch.load(std::memory_order_seq_cst);
+        if (epoch != 0 && epoch < oldest) oldest = epoch;
+    }
+
+    std::vector<RetiredObject> ready;
+    {
+        std::lock_guard<std::mutex> lock(retiredMutex);
+        size_t kept = 0;
+        for (const RetiredObject& object : retiredObjects) {
+            if (object.epoch < oldest) ready.push_back(object);
+            else retiredObjects[kept++] = object;
+        }
+        retiredObjects.resize(kept);
+    }
+    for (const RetiredObject& object : ready) object.deleter(object.ptr);
+    pendingObjects.fetch_sub(ready.size(), std::memory_order_relaxed);
+    return ready.size();
+}
+
+size_t Epoch::pendingCount() {
+    return pendingObjects.load(std::memory_order_relaxed);
+}
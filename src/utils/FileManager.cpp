@@ -35,6 +35,9 @@ void FileManager::saveTable(const Table* table, const std::string& filename) {
             } 
             else if (cell->getType() == CellType::STRING) {
                 rowJson.push_back(cell->getString());
+            } 
+            else {
+                rowJson.push_back(nullptr);
             }
         }
         
@@ -111,7 +114,10 @@ Table* FileManager::loadTable(const std::string& filename) {
             if (typeIt == types.end()) break;
             std::string type = *typeIt; 
 
-            if (type == "INT") {
+            if (cellValue.is_null()) {
+                newRow->addNull();
+            }
+            else if (type == "INT") {
                 newRow->addCell(cellValue.get<int>());
             } 
             else if (type == "DOUBLE") {
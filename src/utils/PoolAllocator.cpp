@@ -0,0 +1,163 @@
+#include "../../include/utils/PoolAllocator.hpp"
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+// Boyut siniflari: 256 bayta kadar 16, MAX_POOLED_SIZE'a kadar 64 bayt adimla
+static const size_t SMALL_STEP = 16;
+static const size_t SMALL_LIMIT = 256;
+static const size_t LARGE_STEP = 64;
+static const size_t SMALL_CLASSES = SMALL_LIMIT / SMALL_STEP;
+static const size_t CLASS_COUNT = SMALL_CLASSES + (PoolAllocator::MAX_POOLED_SIZE - SMALL_LIMIT) / LARGE_STEP;
+static const size_t SLAB_SIZE = 64 * 1024;
+
+static size_t class_of(size_t size) {
+    if (size <= SMALL_LIMIT) return (std::max<size_t>(size, 1) + SMALL_STEP - 1) / SMALL_STEP - 1;
+    return SMALL_CLASSES + (size - SMALL_LIMIT + LARGE_STEP - 1) / LARGE_STEP - 1;
+}
+
+static size_t class_size(size_t cls) {
+    if (cls < SMALL_CLASSES) return (cls + 1) * SMALL_STEP;
+    return SMALL_LIMIT + (cls - SMALL_CLASSES + 1) * LARGE_STEP;
+}
+
+// Thread ile ortak havuz arasinda bir seferde tasinan blok sayisi (~16 KB)
+static size_t batch_of(size_t cls) {
+    return std::max<size_t>(8, 16 * 1024 / class_size(cls));
+}
+
+// Bos blogun ilk 8 baytinda listedeki sonraki blok tutulur
+struct FreeBlock {
+    FreeBlock* next;
+};
+
+struct FreeList {
+    FreeBlock* head;
+    size_t count;
+};
+
+struct CentralPool {
+    std::mutex mutex;
+    std::vector<std::pair<FreeBlock*, size_t>> batches[CLASS_COUNT];  // zincir, blok sayisi
+    std::vector<char*> slabs;
+    std::atomic<size_t> reserved{0};
+};
+
+static CentralPool& central() {
+    // Thread'ler statik yikicilardan sonra da blok birakabilir; havuz hic yikilmaz
+    static CentralPool* pool = new CentralPool();
+    return *pool;
+}
+
+// Yikicisi olmadigi icin thread bitene kadar gecerli; exited ise bloklar
+// dogrudan ortak havuza gider
+struct ThreadCache {
+    FreeList lists[CLASS_COUNT];
+    bool exited;
+};
+
+static thread_local ThreadCache cache;
+
+static void give_back(size_t cls, FreeBlock* chain, size_t count) {
+    CentralPool& pool = central();
+    std::lock_guard<std::mutex> lock(pool.mutex);
+    pool.batches[cls].emplace_back(chain, count);
+}
+
+// Thread biterken yerel listeler ortak havuza doner
+struct ThreadCacheFlush {
+    ~ThreadCacheFlush() {
+        ThreadCache& local = cache;
+        for (size_t cls = 0; cls < CLASS_COUNT; cls++) {
+            FreeList& list = local.lists[cls];
+            if (list.head) give_back(cls, list.head, list.count);
+            list.head = nullptr;
+            list.count = 0;
+        }
+        local.exited = true;
+    }
+};
+
+static thread_local ThreadCacheFlush cacheFlush;
+
+static void refill(size_t cls, FreeList& list) {
+    (void)&cacheFlush;  // thread'in yikicisini kaydeder
+    CentralPool& pool = central();
+    {
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        if (!pool.batches[cls].empty()) {
+            list.head = pool.batches[cls].back().first;
+            list.count = pool.batches[cls].back().second;
+            pool.batches[cls].pop_back();
+            return;
+        }
+    }
+
+    char* slab = static_cast<char*>(::operator new(SLAB_SIZE));
+    {
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        pool.slabs.push_back(slab);
+    }
+    pool.reserved.fetch_add(SLAB_SIZE, std::memory_order_relaxed);
+
+    size_t size = class_size(cls);
+    size_t blocks = SLAB_SIZE / size;
+    // Ters sirayla: ilk ayrilanlar slab'in basindan gelir
+    for (size_t i = blocks; i-- > 0;) {
+        FreeBlock* block = reinterpret_cast<FreeBlock*>(slab + i * size);
+        block->next = list.head;
+        list.head = block;
+    }
+    list.count += blocks;
+}
+
+void* PoolAllocator::allocate(size_t size) {
+    if (size > MAX_POOLED_SIZE) return ::operator new(size);
+    size_t cls = class_of(size);
+    FreeList& list = cache.lists[cls];
+    if (!list.head) refill(cls, list);
+    FreeBlock* block = list.head;
+    list.head = block->next;
+    list.count--;
+    return block;
+}
+
+void PoolAllocator::deallocate(void* ptr, size_t size) {
+    if (!ptr) return;
+    if (size > MAX_POOLED_SIZE) {
+        ::operator delete(ptr);
+        return;
+    }
+    size_t cls = class_of(size);
+    FreeBlock* block = static_cast<FreeBlock*>(ptr);
+    ThreadCache& local = cache;
+    if (local.exited) {
+        block->next = nullptr;
+        give_back(cls, block, 1);
+        return;
+    }
+
+    FreeList& list = local.lists[cls];
+    if (!list.head) (void)&cacheFlush;
+    block->next = list.head;
+    list.head = block;
+    list.count++;
+
+    // Baska thread'lerin ayirdigi dugumleri birakan thread'de birikmesin
+    size_t batch = batch_of(cls);
+    if (list.count >= 2 * batch) {
+        FreeBlock* chain = list.head;
+        FreeBlock* last = chain;
+        for (size_t i = 1; i < batch; i++) last = last->next;
+        list.head = last->next;
+        list.count -= batch;
+        last->next = nullptr;
+        give_back(cls, chain, batch);
+    }
+}
+
+size_t PoolAllocator::bytesReserved() {
+    return central().reserved.load(std::memory_order_relaxed);
+}
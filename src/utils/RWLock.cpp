@@ -0,0 +1,110 @@
+#include "../../include/utils/RWLock.hpp"
+#include <algorithm>
+#include <chrono>
+#include <functional>
+
+static std::atomic<uint64_t> totalReadAcquires(0);
+static std::atomic<uint64_t> totalReadWaits(0);
+static std::atomic<uint64_t> totalReadWaitNs(0);
+static std::atomic<uint64_t> totalWriteAcquires(0);
+static std::atomic<uint64_t> totalWriteWaits(0);
+static std::atomic<uint64_t> totalWriteWaitNs(0);
+static std::atomic<uint64_t> totalMaxWaitNs(0);
+
+static uint64_t now_ns() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+static void update_max(std::atomic<uint64_t>& max, uint64_t value) {
+    uint64_t current = max.load(std::memory_order_relaxed);
+    while (value > current && !max.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+static void record_wait(std::atomic<uint64_t>& waits, std::atomic<uint64_t>& waitNs, std::atomic<uint64_t>& max,
+                        std::atomic<uint64_t>& totalWaits, std::atomic<uint64_t>& totalWaitNs, uint64_t ns) {
+    waits.fetch_add(1, std::memory_order_relaxed);
+    waitNs.fetch_add(ns, std::memory_order_relaxed);
+    totalWaits.fetch_add(1, std::memory_order_relaxed);
+    totalWaitNs.fetch_add(ns, std::memory_order_relaxed);
+    update_max(max, ns);
+    update_max(totalMaxWaitNs, ns);
+}
+
+RWLock::RWLock()
+    : readAcquires(0), readWaits(0), readWaitNs(0), writeAcquires(0), writeWaits(0), writeWaitNs(0),
+      maxWaitNs(0) {}
+
+void RWLock::lockRead() {
+    bool gated = gate.try_lock();
+    if (gated && mutex.try_lock_shared()) {
+        gate.unlock();
+    } else {
+        uint64_t start = now_ns();
+        if (!gated) gate.lock();
+        mutex.lock_shared();
+        gate.unlock();
+        record_wait(readWaits, readWaitNs, maxWaitNs, totalReadWaits, totalReadWaitNs, now_ns() - start);
+    }
+    readAcquires.fetch_add(1, std::memory_order_relaxed);
+    totalReadAcquires.fetch_add(1, std::memory_order_relaxed);
+}
+
+void RWLock::unlockRead() {
+    mutex.unlock_shared();
+}
+
+void RWLock::lockWrite() {
+    bool gated = gate.try_lock();
+    if (gated && mutex.try_lock()) {
+        gate.unlock();
+    } else {
+        // gate tutulurken okuyucularin bosalmasi beklenir
+        uint64_t start = now_ns();
+        if (!gated) gate.lock();
+        mutex.lock();
+        gate.unlock();
+        record_wait(writeWaits, writeWaitNs, maxWaitNs, totalWriteWaits, totalWriteWaitNs, now_ns() - start);
+    }
+    writeAcquires.fetch_add(1, std::memory_order_relaxed);
+    totalWriteAcquires.fetch_add(1, std::memory_order_relaxed);
+}
+
+void RWLock::unlockWrite() {
+    mutex.unlock();
+}
+
+LockStats RWLock::getStats() const {
+    LockStats stats;
+    stats.read_acquires = readAcquires.load(std::memory_order_relaxed);
+    stats.read_waits = readWaits.load(std::memory_order_relaxed);
+    stats.read_wait_ns = readWaitNs.load(std::memory_order_relaxed);
+    stats.write_acquires = writeAcquires.load(std::memory_order_relaxed);
+    stats.write_waits = writeWaits.load(std::memory_order_relaxed);
+    stats.write_wait_ns = writeWaitNs.load(std::memory_order_relaxed);
+    stats.max_wait_ns = maxWaitNs.load(std::memory_order_relaxed);
+    return stats;
+}
+
+LockStats RWLock::globalStats() {
+    LockStats stats;
+    stats.read_acquires = totalReadAcquires.load(std::memory_order_relaxed);
+    stats.read_waits = totalReadWaits.load(std::memory_order_relaxed);
+    stats.read_wait_ns = totalReadWaitNs.load(std::memory_order_relaxed);
+    stats.write_acquires = totalWriteAcquires.load(std::memory_order_relaxed);
+    stats.write_waits = totalWriteWaits.load(std::memory_order_relaxed);
+    stats.write_wait_ns = totalWriteWaitNs.load(std::memory_order_relaxed);
+    stats.max_wait_ns = totalMaxWaitNs.load(std::memory_order_relaxed);
+    return stats;
+}
+
+ReadGuardSet::ReadGuardSet(std::vector<RWLock*> l) : locks(std::move(l)) {
+    std::sort(locks.begin(), locks.end(), std::less<RWLock*>());
+    locks.erase(std::unique(locks.begin(), locks.end()), locks.end());
+    for (RWLock* lock : locks) lock->lockRead();
+}
+
+ReadGuardSet::~ReadGuardSet() {
+    for (auto it = locks.rbegin(); it != locks.rend(); ++it) (*it)->unlockRead();
+}
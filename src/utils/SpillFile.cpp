@@ -0,0 +1,81 @@
+#include "../../include/utils/SpillFile.hpp"
+#include <iostream>
+
+SpillFile::SpillFile() : file(nullptr), bytesWritten(0), writeFailed(false) {}
+
+SpillFile::~SpillFile() {
+    if (file) std::fclose(file);
+}
+
+bool SpillFile::open() {
+    if (file) return true;
+    file = std::tmpfile();
+    if (!file) {
+        std::cerr << "Hata: Gecici spill dosyasi acilamadi" << std::endl;
+        return false;
+    }
+    // Kucuk kayitlar cok sayida yazildigi icin genis tampon
+    std::setvbuf(file, nullptr, _IOFBF, 1 << 16);
+    return true;
+}
+
+void SpillFile::write(const void* data, size_t size) {
+    if (!file || size == 0 || writeFailed) return;
+    size_t written = std::fwrite(data, 1, size, file);
+    bytesWritten += written;
+    if (written != size) {
+        writeFailed = true;
+        std::cerr << "Hata: Spill dosyasina yazilamadi (disk dolu olabilir)" << std::endl;
+    }
+}
+
+void SpillFile::writeUInt64(uint64_t value) {
+    write(&value, sizeof(value));
+}
+
+void SpillFile::writeInt64(int64_t value) {
+    write(&value, sizeof(value));
+}
+
+void SpillFile::writeDouble(double value) {
+    write(&value, sizeof(value));
+}
+
+void SpillFile::writeString(const std::string& value) {
+    writeUInt64(value.size());
+    write(value.data(), value.size());
+}
+
+void SpillFile::rewind() {
+    if (!file) return;
+    if (std::fflush(file) != 0 && !writeFailed) {
+        writeFailed = true;
+        std::cerr << "Hata: Spill dosyasi diske yazilamadi (disk dolu olabilir)" << std::endl;
+    }
+    std::rewind(file);
+}
+
+bool SpillFile::read(void* data, size_t size) {
+    if (!file) return false;
+    if (size == 0) return true;
+    return std::fread(data, 1, size, file) == size;
+}
+
+bool SpillFile::readUInt64(uint64_t& value) {
+    return read(&value, sizeof(value));
+}
+
+bool SpillFile::readInt64(int64_t& value) {
+    return read(&value, sizeof(value));
+}
+
+bool SpillFile::readDouble(double& value) {
+    return read(&value, sizeof(value));
+}
+
+bool SpillFile::readString(std::string& value) {
+    uint64_t length;
+    if (!readUInt64(length)) return false;
+    value.resize(length);
+    return read(&value[0], length);
+}
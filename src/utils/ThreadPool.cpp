@@ -0,0 +1,251 @@
+#include "../../include/utils/ThreadPool.hpp"
+#include "../../include/utils/Arena.hpp"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+
+ThreadPool::ThreadPool(size_t threadCount) : stopping(false) {
+    if (threadCount == 0) threadCount = std::thread::hardware_concurrency();
+    if (threadCount == 0) threadCount = 1;
+
+    for (size_t i = 0; i < threadCount; i++) {
+        workers.emplace_back([this]() { workerLoop(); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    condition.notify_all();
+    for (auto& worker : workers) worker.join();
+}
+
+void ThreadPool::workerLoop() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait(lock, [this]() { return stopping || !tasks.empty(); });
+            if (stopping && tasks.empty()) return;
+            task = std::move(tasks.front());
+            tasks.pop();
+        }
+        task();
+    }
+}
+
+void ThreadPool::submit(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.push(std::move(task));
+    }
+    condition.notify_one();
+}
+
+// Paralel islerde atilan ilk istisna. Task'lar istisnayi worker'a kacirmaz
+// (workerLoop'ta yakalanmazsa std::terminate), burada saklar; istisnadan
+// sonra kalan parcalar calistirilmadan bitmis sayilir, cagiran herkesi
+// bekledikten sonra ilkini tekrar atar.
+struct TaskError {
+    std::atomic<bool> failed{false};
+    std::mutex mutex;
+    std::exception_ptr first;
+
+    void capture() {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!first) first = std::current_exception();
+        failed.store(true);
+    }
+
+    void rethrow() {
+        if (failed.load()) std::rethrow_exception(first);
+    }
+};
+
+// parallelFor'un paylasilan durumu. Yardimci task'lar cagiran donduktan sonra
+// calisabilir, bu yuzden shared_ptr ile tutulur.
+struct ParallelForState {
+    std::atomic<size_t> next{0};
+    std::atomic<size_t> done{0};
+    size_t count = 0;
+    std::function<void(size_t)> fn;
+    Arena* arena = nullptr;  // cagiranin arena'si; yardimcilar da ondan ayirir
+    TaskError error;
+    std::mutex mutex;
+    std::condition_variable finished;
+};
+
+static void run_parallel_for(const std::shared_ptr<ParallelForState>& state) {
+    size_t i;
+    while ((i = state->next.fetch_add(1)) < state->count) {
+        if (!state->error.failed.load()) {
+            try {
+                state->fn(i);
+            } catch (...) {
+                state->error.capture();
+            }
+        }
+        if (state->done.fetch_add(1) + 1 == state->count) {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            state->finished.notify_all();
+        }
+    }
+}
+
+void ThreadPool::parallelFor(size_t taskCount, const std::function<void(size_t)>& fn) {
+    if (taskCount == 0) return;
+    if (taskCount == 1 || workers.size() <= 1) {
+        for (size_t i = 0; i < taskCount; i++) fn(i);
+        return;
+    }
+
+    auto state = std::make_shared<ParallelForState>();
+    state->count = taskCount;
+    state->fn = fn;
+    state->arena = Arena::current();
+
+    // submit basarisiz olursa kalan isi cagiran yapar
+    size_t helpers = std::min(workers.size(), taskCount - 1);
+    try {
+        for (size_t i = 0; i < helpers; i++) {
+            submit([state]() {
+                ArenaScope scope(state->arena);
+                run_parallel_for(state);
+            });
+        }
+    } catch (...) {
+    }
+    run_parallel_for(state);
+
+    {
+        std::unique_lock<std::mutex> lock(state->mutex);
+        state->finished.wait(lock, [&state]() { return state->done.load() == state->count; });
+    }
+    state->error.rethrow();
+}
+
+// Bir katilimcinin morsel dilimi: sahibi next'ten, hirsizlar end'den alir
+struct MorselRange {
+    std::mutex mutex;
+    size_t next = 0;
+    size_t end = 0;
+};
+
+struct MorselState {
+    std::vector<MorselRange> ranges;
+    std::atomic<size_t> done{0};
+    size_t morselCount = 0;
+    size_t itemCount = 0;
+    size_t morselSize = 0;
+    std::function<void(size_t, size_t, size_t)> fn;
+    Arena* arena = nullptr;
+    TaskError error;
+    std::mutex mutex;
+    std::condition_variable finished;
+
+    explicit MorselState(size_t participants) : ranges(participants) {}
+};
+
+static bool take_own(MorselRange& range, size_t& morsel) {
+    std::lock_guard<std::mutex> lock(range.mutex);
+    if (range.next >= range.end) return false;
+    morsel = range.next++;
+    return true;
+}
+
+// Kalan isi en fazla olan dilimin sonundan bir morsel calar
+static bool steal(MorselState& state, size_t self, size_t& morsel) {
+    while (true) {
+        size_t victim = state.ranges.size();
+        size_t most = 0;
+        for (size_t i = 0; i < state.ranges.size(); i++) {
+            if (i == self) continue;
+            std::lock_guard<std::mutex> lock(state.ranges[i].mutex);
+            size_t left = state.ranges[i].end - state.ranges[i].next;
+            if (left > most) {
+                most = left;
+                victim = i;
+            }
+        }
+        if (victim == state.ranges.size()) return false;
+
+        MorselRange& range = state.ranges[victim];
+        std::lock_guard<std::mutex> lock(range.mutex);
+        if (range.next < range.end) {
+            morsel = --range.end;
+            return true;
+        }
+    }
+}
+
+static void run_morsels(const std::shared_ptr<MorselState>& state, size_t self) {
+    size_t morsel;
+    while (take_own(state->ranges[self], morsel) || steal(*state, self, morsel)) {
+        size_t begin = morsel * state->morselSize;
+        size_t end = std::min(state->itemCount, begin + state->morselSize);
+        if (!state->error.failed.load()) {
+            try {
+                state->fn(morsel, begin, end);
+            } catch (...) {
+                state->error.capture();
+            }
+        }
+        if (state->done.fetch_add(1) + 1 == state->morselCount) {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            state->finished.notify_all();
+        }
+    }
+}
+
+void ThreadPool::parallelMorsels(size_t itemCount, size_t morselSize,
+                                 const std::function<void(size_t, size_t, size_t)>& fn) {
+    if (itemCount == 0) return;
+    if (morselSize == 0) morselSize = 1;
+    size_t morselCount = (itemCount + morselSize - 1) / morselSize;
+    if (morselCount == 1 || workers.size() <= 1) {
+        for (size_t m = 0; m < morselCount; m++) fn(m, m * morselSize, std::min(itemCount, (m + 1) * morselSize));
+        return;
+    }
+
+    size_t helpers = std::min(workers.size(), morselCount - 1);
+    auto state = std::make_shared<MorselState>(helpers + 1);
+    state->morselCount = morselCount;
+    state->itemCount = itemCount;
+    state->morselSize = morselSize;
+    state->fn = fn;
+    state->arena = Arena::current();
+    for (size_t p = 0; p <= helpers; p++) {
+        state->ranges[p].next = p * morselCount / (helpers + 1);
+        state->ranges[p].end = (p + 1) * morselCount / (helpers + 1);
+    }
+
+    // Gonderilemeyen yardimcinin dilimini cagiran calarak bitirir
+    try {
+        for (size_t p = 1; p <= helpers; p++) {
+            submit([state, p]() {
+                ArenaScope scope(state->arena);
+                run_morsels(state, p);
+            });
+        }
+    } catch (...) {
+    }
+    run_morsels(state, 0);
+
+    {
+        std::unique_lock<std::mutex> lock(state->mutex);
+        state->finished.wait(lock, [&state]() { return state->done.load() == state->morselCount; });
+    }
+    state->error.rethrow();
+}
+
+size_t ThreadPool::getThreadCount() const {
+    return workers.size();
+}
+
+ThreadPool& ThreadPool::global() {
+    static ThreadPool pool;
+    return pool;
+}